@@ -13,14 +13,239 @@
  */
 
 #include "UICalculator.h"
+#include "UIPlotter.h"
+#include "calculus.h"
+#include "decimal.h"
 #include "engine.h"
+#include "fft.h"
+#include "finance.h"
+#include "ingest.h"
+#include "montecarlo.h"
+#include "solver.h"
+#include "symbolic.h"
+#include <QAbstractTableModel>
+#include <QAction>
+#include <QApplication>
+#include <QClipboard>
 #include <QDebug>
+#include <QDragEnterEvent>
+#include <QDropEvent>
+#include <QFile>
+#include <QFileInfo>
 #include <QKeyEvent>
+#include <QMimeData>
+#include <QRegularExpression>
+#include <QStandardPaths>
 #include <QString>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QDialog>
 #include <QtWidgets/QGridLayout>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QInputDialog>
+#include <QtWidgets/QLabel>
 #include <QtWidgets/QLineEdit>
+#include <QtWidgets/QMenu>
 #include <QtWidgets/QMessageBox>
+#include <QtWidgets/QProgressDialog>
 #include <QtWidgets/QPushButton>
+#include <QtWidgets/QTableView>
+#include <QtWidgets/QVBoxLayout>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+/// @brief Shortest decimal text that reads back as exactly @p v.
+template <typename T> static QString decimalText(T v) {
+  char buffer[decimal::kMaxChars];
+  const char *end = decimal::format(buffer, v);
+  return QString::fromLatin1(buffer, end - buffer);
+}
+
+/// @brief Parse text that is exactly one decimal number (surrounding spaces
+/// allowed), correctly rounded and independent of the locale.
+/// @return The value, or std::nullopt when the text is not a number or is out
+/// of range.
+static std::optional<long double> parseDecimal(QStringView text) {
+  text = text.trimmed();
+  char stack[128];
+  QByteArray heap; // only for text longer than the stack buffer
+  char *chars = stack;
+  if (text.size() > static_cast<qsizetype>(sizeof stack)) {
+    heap = text.toLatin1();
+    chars = heap.data();
+  } else {
+    for (qsizetype i = 0; i < text.size(); ++i) {
+      const char16_t c = text[i].unicode();
+      stack[i] = c < 0x80 ? static_cast<char>(c) : '?'; // never part of one
+    }
+  }
+  const char *end = chars + text.size();
+  long double value = 0.0L;
+  const auto [last, ec] = decimal::parse(chars, end, value);
+  if (text.isEmpty() || last != end || ec != std::errc())
+    return std::nullopt;
+  return value;
+}
+
+/// @brief Parse display/dialog text as a complex number.
+/// @param text Rectangular ("3", "-2.5i", "3+4i", "1-i") or polar text
+/// ("5∠53.13", "5@53.13"; angle in degrees, optional trailing "°").
+/// @return The value, or std::nullopt when the text is not a number.
+static std::optional<std::complex<long double>>
+parseComplexText(const QString &text) {
+  QString t = text;
+  t.remove(' ');
+  const int polar = std::max(t.indexOf(QChar(0x2220)), t.indexOf('@'));
+  if (polar > 0) {
+    QString angle = t.mid(polar + 1);
+    if (angle.endsWith(QChar(0x00B0)))
+      angle.chop(1);
+    const auto r = parseDecimal(t.left(polar));
+    const auto deg = parseDecimal(angle);
+    if (!r || !deg)
+      return std::nullopt;
+    const long double rad =
+        *deg * 3.141592653589793238462643383279503L / 180.0L;
+    return std::polar(*r, rad);
+  }
+  if (!t.endsWith('i')) {
+    const auto v = parseDecimal(t);
+    if (!v)
+      return std::nullopt;
+    return std::complex<long double>(*v, 0.0L);
+  }
+  t.chop(1);
+  // Split at the last sign that is not the first character or an exponent's.
+  int split = -1;
+  for (int k = t.size() - 1; k > 0; --k) {
+    if ((t[k] == '+' || t[k] == '-') && t[k - 1] != 'e' && t[k - 1] != 'E') {
+      split = k;
+      break;
+    }
+  }
+  long double re = 0.0L;
+  if (split > 0) {
+    const auto v = parseDecimal(t.left(split));
+    if (!v)
+      return std::nullopt;
+    re = *v;
+    t = t.mid(split);
+  }
+  long double im = 1.0L;
+  if (t == "-") {
+    im = -1.0L;
+  } else if (!t.isEmpty() && t != "+") {
+    const auto v = parseDecimal(t);
+    if (!v)
+      return std::nullopt;
+    im = *v;
+  }
+  return std::complex<long double>(re, im);
+}
+
+/// @brief Whether the display holds a complex entry (so digits replace it).
+static bool isComplexText(const QString &text) {
+  return text.endsWith('i') || text.contains(QChar(0x2220)) ||
+         text.contains('@');
+}
+
+namespace {
+/**
+ * @brief Read-only table of an amortization schedule. Rows are computed by
+ *        Engine::amortize one block at a time, only for what the view asks;
+ *        cells become text only when painted.
+ */
+class ScheduleModel : public QAbstractTableModel {
+public:
+  explicit ScheduleModel(const finance::Loan &loan, QObject *parent = nullptr)
+      : QAbstractTableModel(parent), loan_(loan) {}
+
+  int rowCount(const QModelIndex &parent = {}) const override {
+    return parent.isValid() ? 0
+                            : static_cast<int>(std::min<std::uint64_t>(
+                                  loan_.periods, INT_MAX));
+  }
+  int columnCount(const QModelIndex &parent = {}) const override {
+    return parent.isValid() ? 0 : 4;
+  }
+
+  QVariant data(const QModelIndex &index, int role) const override {
+    if (role == Qt::TextAlignmentRole)
+      return int(Qt::AlignRight | Qt::AlignVCenter);
+    if (role != Qt::DisplayRole || !index.isValid())
+      return {};
+    const std::uint64_t row = static_cast<std::uint64_t>(index.row());
+    if (row < first_ || row >= first_ + count_) {
+      first_ = row - row % finance::kScheduleBlock;
+      count_ = static_cast<std::size_t>(std::min<std::uint64_t>(
+          finance::kScheduleBlock, loan_.periods - first_));
+      if (!Engine::amortize(loan_, first_, count_,
+                            {payment_, interest_, principal_, balance_}))
+        count_ = 0;
+    }
+    if (row >= first_ + count_)
+      return {};
+    const double *columns[] = {payment_, interest_, principal_, balance_};
+    return QString::number(columns[index.column()][row - first_], 'f', 2);
+  }
+
+  QVariant headerData(int section, Qt::Orientation orientation,
+                      int role) const override {
+    if (role != Qt::DisplayRole)
+      return {};
+    if (orientation == Qt::Vertical)
+      return section + 1; // period number
+    static const char *const names[] = {"Payment", "Interest", "Principal",
+                                        "Balance"};
+    return QString(names[section]);
+  }
+
+private:
+  finance::Loan loan_;
+  // Cached block of rows [first_, first_ + count_).
+  mutable std::uint64_t first_ = 0;
+  mutable std::size_t count_ = 0;
+  mutable double payment_[finance::kScheduleBlock];
+  mutable double interest_[finance::kScheduleBlock];
+  mutable double principal_[finance::kScheduleBlock];
+  mutable double balance_[finance::kScheduleBlock];
+};
+
+/// @brief Loan from "principal annual-rate% years [payments per year]".
+std::optional<finance::Loan> parseLoanText(const QString &text) {
+  const QStringList parts =
+      text.split(QRegularExpression("[\\s,;]+"), Qt::SkipEmptyParts);
+  if (parts.size() < 3 || parts.size() > 4)
+    return std::nullopt;
+  double values[4] = {0.0, 0.0, 0.0, 12.0};
+  for (int i = 0; i < parts.size(); ++i) {
+    const auto v = parseDecimal(parts[i]);
+    if (!v)
+      return std::nullopt;
+    values[i] = static_cast<double>(*v);
+  }
+  const double principal = values[0];
+  const double annual = values[1] / 100.0;
+  const double perYear = values[3];
+  const double periods = std::round(values[2] * perYear);
+  if (!(perYear >= 1.0) || !(periods >= 1.0) || periods > 1e12)
+    return std::nullopt;
+  const finance::Loan loan{principal, annual / perYear,
+                           static_cast<std::uint64_t>(periods)};
+  if (!finance::payment(loan))
+    return std::nullopt;
+  return loan;
+}
+} // namespace
 
 /// @brief Constructor of the User Interface.
 /// @param parent Widget pointer to which the class will be casted.
@@ -45,6 +270,7 @@ UICalculator::UICalculator(QWidget *parent) : QWidget(parent) {
   // Commands shower properties.
   qDebug() << "[UICalculator] Creating display";
   symbolShower = new QLineEdit();
+  symbolShower->setObjectName("symbolShower");
   symbolShower->setReadOnly(true);
   symbolShower->setAlignment(Qt::AlignCenter);
   symbolShower->setText("0");
@@ -58,9 +284,25 @@ UICalculator::UICalculator(QWidget *parent) : QWidget(parent) {
   qDebug() << "[UICalculator] Calling createDigitButtons()";
   createDigitButtons();
   qDebug() << "[UICalculator] Digits created";
+  // Dropped text or files are ingested like pasted input
+  setAcceptDrops(true);
   qDebug() << "[UICalculator] EXIT ctor";
 }
 
+/// @brief Stop running background jobs so they never outlive the window.
+UICalculator::~UICalculator() {
+  if (ingestWorker_) {
+    ingestJob_->cancel = true;
+    ingestWorker_->wait();
+    delete ingestWorker_;
+  }
+  if (taskWorker_) {
+    task_->cancel = true;
+    taskWorker_->wait();
+    delete taskWorker_; // its deleteLater() would never run now
+  }
+}
+
 /// @brief Creates the digit buttons layer and places them in the layout.
 ///
 /// Sets up digit buttons 0-9 and the decimal point button, connects their
@@ -74,6 +316,7 @@ void UICalculator::createDigitButtons() {
     for (int col = 0; col < 3; ++col) {
       int d = numLabels[row][col][0] - '0';
       digitButtons[d] = new QPushButton(QString::number(d));
+      digitButtons[d]->setObjectName(QString("btn%1").arg(d));
       btnOrganizer->addWidget(digitButtons[d], row + 2, col);
       connect(digitButtons[d], &QPushButton::clicked, this,
               [this, d] { appendDigit(d); });
@@ -82,6 +325,8 @@ void UICalculator::createDigitButtons() {
   // Botón 0 y punto
   digitButtons[0] = new QPushButton("0");
   QPushButton *btnDot = new QPushButton(".");
+  digitButtons[0]->setObjectName("btn0");
+  btnDot->setObjectName("btnDot");
   btnOrganizer->addWidget(digitButtons[0], 5, 0, 1, 2);
   btnOrganizer->addWidget(btnDot, 5, 2);
   connect(digitButtons[0], &QPushButton::clicked, this,
@@ -134,6 +379,85 @@ void UICalculator::createUtilityAndOperatorButtons() {
   }
   if (!btnConvert)
     btnConvert = new QPushButton("Convert");
+  if (!btnModes) {
+    // Extra modes live in a drop-down menu to keep the keypad compact.
+    btnModes = new QPushButton("Modes");
+    QMenu *modes = new QMenu(btnModes);
+    connect(modes->addAction("Monte Carlo..."), &QAction::triggered, this,
+            [this] { onSimulatePressed(); });
+    modes->addSeparator();
+    connect(modes->addAction("GCD"), &QAction::triggered, this,
+            [this] { onOperatorPressed(4); });
+    connect(modes->addAction("LCM"), &QAction::triggered, this,
+            [this] { onOperatorPressed(5); });
+    connect(modes->addAction("Factor / Prime test"), &QAction::triggered,
+            this, [this] { onFactorPressed(); });
+    connect(modes->addAction("Modular..."), &QAction::triggered, this,
+            [this] { onModularPressed(); });
+    connect(modes->addAction("Combinatorics..."), &QAction::triggered, this,
+            [this] { onCombinatoricsPressed(); });
+    connect(modes->addAction("Constants..."), &QAction::triggered, this,
+            [this] { onConstantsPressed(); });
+    connect(modes->addAction("Calculus..."), &QAction::triggered, this,
+            [this] { onCalculusPressed(); });
+    connect(modes->addAction("Units..."), &QAction::triggered, this,
+            [this] { onUnitsPressed(); });
+    connect(modes->addAction("Solve..."), &QAction::triggered, this,
+            [this] { onSolvePressed(); });
+    connect(modes->addAction("FFT..."), &QAction::triggered, this,
+            [this] { onFftPressed(); });
+    connect(modes->addAction("Symbolic..."), &QAction::triggered, this,
+            [this] { onSymbolicPressed(); });
+    connect(modes->addAction("Finance..."), &QAction::triggered, this,
+            [this] { onFinancePressed(); });
+    // Window-wide shortcut: the read-only display does not take Ctrl+V.
+    QAction *paste = modes->addAction("Paste input");
+    paste->setShortcut(QKeySequence::Paste);
+    paste->setShortcutContext(Qt::WindowShortcut);
+    addAction(paste);
+    connect(paste, &QAction::triggered, this,
+            [this] { ingestText(QApplication::clipboard()->text()); });
+    QMenu *complexMenu = modes->addMenu("Complex");
+    connect(complexMenu->addAction("Enter a+bi / polar..."),
+            &QAction::triggered, this, [this] { onComplexEntryPressed(); });
+    connect(complexMenu->addAction("x^y"), &QAction::triggered, this,
+            [this] { onOperatorPressed(6); });
+    connect(complexMenu->addAction("sqrt(z)"), &QAction::triggered, this,
+            [this] { onComplexFunctionPressed(0); });
+    connect(complexMenu->addAction("exp(z)"), &QAction::triggered, this,
+            [this] { onComplexFunctionPressed(1); });
+    connect(complexMenu->addAction("ln(z)"), &QAction::triggered, this,
+            [this] { onComplexFunctionPressed(2); });
+    QAction *fractions = modes->addAction("Fractions");
+    fractions->setCheckable(true);
+    connect(fractions, &QAction::toggled, this,
+            [this](bool on) { fractionMode_ = on; });
+    modes->addSeparator();
+    QAction *plot = modes->addAction("Plot");
+    plot->setCheckable(true);
+    connect(plot, &QAction::toggled, this, [this](bool on) {
+      if (!plotter_)
+        return;
+      plotter_->setVisible(on);
+      adjustSize();
+    });
+    btnModes->setMenu(modes);
+  }
+
+  // Object names mirror the member names so tools (e.g. the latency replay
+  // harness) can locate controls with findChild().
+  btnClr->setObjectName("btnClr");
+  btnBck->setObjectName("btnBck");
+  btnCE->setObjectName("btnCE");
+  btnDiv->setObjectName("btnDiv");
+  btnMul->setObjectName("btnMul");
+  btnSub->setObjectName("btnSub");
+  btnAdd->setObjectName("btnAdd");
+  btnEql->setObjectName("btnEql");
+  btnRan->setObjectName("btnRan");
+  editRandomMax->setObjectName("editRandomMax");
+  btnConvert->setObjectName("btnConvert");
+  btnModes->setObjectName("btnModes");
 
   // Place them in the grid
   qDebug() << "[UICalculator] placing top row";
@@ -155,6 +479,14 @@ void UICalculator::createUtilityAndOperatorButtons() {
   btnOrganizer->addWidget(btnConvert, 6, 0);
   btnOrganizer->addWidget(btnRan, 6, 1);
   btnOrganizer->addWidget(editRandomMax, 6, 2);
+  btnOrganizer->addWidget(btnModes, 6, 3);
+
+  // Plot panel to the right of the keypad, shown from the Modes menu
+  if (!plotter_) {
+    plotter_ = new UIPlotter();
+    plotter_->setVisible(false);
+  }
+  btnOrganizer->addWidget(plotter_, 0, 4, 7, 1);
 
   // Connections
   connect(btnClr, &QPushButton::clicked, this, [this] { onClearPressed(); });
@@ -241,6 +573,12 @@ void UICalculator::keyPressEvent(QKeyEvent *event) {
       symbolShower->setText("0");
     value1_ = 0.0L;
     value2_ = 0.0L;
+    exact1_.reset();
+    imag1_ = 0.0L;
+    frac1_.reset();
+    exact2_.reset();
+    imag2_ = 0.0L;
+    frac2_.reset();
     enteringFirst_ = true;
     if (engine_)
       engine_->clear();
@@ -270,6 +608,237 @@ void UICalculator::keyPressEvent(QKeyEvent *event) {
   }
 }
 
+/// @brief Shared state of an ingestion job. The worker runs read() and
+/// finish(); the GUI only polls the atomics.
+struct UICalculator::IngestJob {
+  /// Feeds the whole input to ingestor; returns an error message or "".
+  std::function<QString(IngestJob &)> read;
+  ingest::Ingestor ingestor;
+  std::atomic<qint64> done{0};      ///< Input consumed (progress units).
+  std::atomic<bool> cancel{false};  ///< Set by the progress dialog.
+  QString error;                    ///< I/O error, if any.
+  ingest::Result result;
+};
+
+/// Input handed to the worker per chunk: small enough to keep the progress
+/// bar and cancellation responsive, large enough to amortize the calls.
+static constexpr qint64 kIngestChunk = qint64{1} << 20;
+
+/// @brief Accept drags carrying text or local files.
+void UICalculator::dragEnterEvent(QDragEnterEvent *event) {
+  const QMimeData *mime = event->mimeData();
+  if (mime->hasUrls() || mime->hasText())
+    event->acceptProposedAction();
+}
+
+/// @brief Ingest the first dropped local file, or else the dropped text.
+void UICalculator::dropEvent(QDropEvent *event) {
+  const QMimeData *mime = event->mimeData();
+  for (const QUrl &url : mime->urls()) {
+    if (url.isLocalFile()) {
+      event->acceptProposedAction();
+      ingestFile(url.toLocalFile());
+      return;
+    }
+  }
+  if (mime->hasText()) {
+    event->acceptProposedAction();
+    ingestText(mime->text());
+  }
+}
+
+/// @brief Ingest text (clipboard or drop), converting it to UTF-8 one chunk
+/// at a time on the worker so the GUI thread never copies it whole.
+void UICalculator::ingestText(const QString &text) {
+  auto job = std::make_shared<IngestJob>();
+  job->read = [text](IngestJob &self) {
+    for (qint64 pos = 0; pos < text.size() && !self.cancel;) {
+      qint64 n = std::min<qint64>(kIngestChunk, text.size() - pos);
+      if (pos + n < text.size() && text[pos + n - 1].isHighSurrogate())
+        --n; // keep surrogate pairs whole
+      const QByteArray utf8 = QStringView(text).mid(pos, n).toUtf8();
+      self.ingestor.feed(std::string_view(utf8.constData(), utf8.size()));
+      pos += n;
+      self.done = pos;
+    }
+    return QString();
+  };
+  startIngest(job, text.size(), "pasted input");
+}
+
+/// @brief Ingest a file, read in chunks on the worker.
+void UICalculator::ingestFile(const QString &path) {
+  auto job = std::make_shared<IngestJob>();
+  job->read = [path](IngestJob &self) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+      return QString("Cannot read %1: %2").arg(path, file.errorString());
+    QByteArray chunk;
+    while (!self.cancel && !(chunk = file.read(kIngestChunk)).isEmpty()) {
+      self.ingestor.feed(std::string_view(chunk.constData(), chunk.size()));
+      self.done += chunk.size();
+    }
+    if (file.error() != QFileDevice::NoError)
+      return QString("Cannot read %1: %2").arg(path, file.errorString());
+    return QString();
+  };
+  startIngest(job, QFileInfo(path).size(), QFileInfo(path).fileName());
+}
+
+/// @brief Run @p job on a worker thread behind a cancellable progress dialog.
+///
+/// A timer polls the job's progress counter every 50 ms; the GUI thread
+/// never waits on the worker, and the result is shown once it finishes.
+void UICalculator::startIngest(std::shared_ptr<IngestJob> job, qint64 total,
+                               const QString &source) {
+  if (ingestWorker_) {
+    QMessageBox::information(this, "Input",
+                             "Still reading the previous input.");
+    return;
+  }
+  auto *progress = new QProgressDialog(QString("Reading %1...").arg(source),
+                                       "Cancel", 0, 1000, this);
+  progress->setWindowModality(Qt::WindowModal);
+  progress->setMinimumDuration(300);
+  progress->setAutoReset(false);
+  progress->setAutoClose(false);
+  connect(progress, &QProgressDialog::canceled, this,
+          [job] { job->cancel = true; });
+  auto *timer = new QTimer(progress);
+  connect(timer, &QTimer::timeout, progress, [progress, job, total] {
+    if (total > 0)
+      progress->setValue(static_cast<int>(
+          std::min<qint64>(1000, job->done * 1000 / total)));
+  });
+  timer->start(50);
+
+  ingestJob_ = job;
+  ingestWorker_ = QThread::create([job] {
+    job->error = job->read(*job);
+    if (!job->cancel && job->error.isEmpty())
+      job->result = job->ingestor.finish();
+  });
+  connect(ingestWorker_, &QThread::finished, this, [this, job, progress,
+                                                    source] {
+    ingestWorker_->deleteLater();
+    ingestWorker_ = nullptr;
+    ingestJob_.reset();
+    progress->hide(); // hide(), not close(): closing emits canceled()
+    progress->deleteLater();
+    showIngestResult(*job, source);
+  });
+  ingestWorker_->start();
+}
+
+/// @brief Progress and cancellation shared by a runTask() worker and the GUI.
+struct UICalculator::Task {
+  std::atomic<bool> cancel{false};     ///< Set by the progress dialog.
+  std::atomic<std::uint64_t> done{0};  ///< Work finished, in units of total.
+  std::uint64_t total = 0;             ///< 0 shows a busy indicator instead.
+};
+
+bool UICalculator::runTask(const QString &title, const QString &label,
+                           std::shared_ptr<Task> task,
+                           std::function<void()> work,
+                           std::function<void()> finished) {
+  if (taskWorker_) {
+    QMessageBox::information(this, title,
+                             "Still working on the previous task.");
+    return false;
+  }
+  auto *progress = new QProgressDialog(label, "Cancel", 0,
+                                       task->total > 0 ? 1000 : 0, this);
+  progress->setWindowTitle(title);
+  progress->setWindowModality(Qt::WindowModal);
+  progress->setMinimumDuration(300);
+  progress->setAutoReset(false);
+  progress->setAutoClose(false);
+  connect(progress, &QProgressDialog::canceled, this,
+          [task] { task->cancel = true; });
+  auto *timer = new QTimer(progress);
+  connect(timer, &QTimer::timeout, progress, [progress, task] {
+    if (task->total > 0)
+      progress->setValue(static_cast<int>(
+          std::min(1000.0, 1000.0 * static_cast<double>(task->done) /
+                               static_cast<double>(task->total))));
+  });
+  timer->start(50);
+
+  task_ = task;
+  taskWorker_ = QThread::create(std::move(work));
+  connect(taskWorker_, &QThread::finished, this,
+          [this, progress, finished = std::move(finished)] {
+            taskWorker_->deleteLater();
+            taskWorker_ = nullptr;
+            task_.reset();
+            progress->hide(); // hide(), not close(): closing emits canceled()
+            progress->deleteLater();
+            finished();
+          });
+  taskWorker_->start();
+  return true;
+}
+
+/// @brief Put the ingested value on the display and report what was read.
+void UICalculator::showIngestResult(const IngestJob &job,
+                                    const QString &source) {
+  if (job.cancel) {
+    history_ << QString("%1: cancelled").arg(source);
+    return;
+  }
+  if (!job.error.isEmpty()) {
+    QMessageBox::warning(this, "Input", job.error);
+    return;
+  }
+  const ingest::Result &r = job.result;
+  switch (r.kind) {
+  case ingest::Result::Kind::Empty:
+    QMessageBox::information(this, "Input",
+                             QString("%1 is empty.").arg(source));
+    return;
+  case ingest::Result::Kind::Invalid:
+    QMessageBox::warning(this, "Input",
+                         QString("%1 is neither a list of numbers nor an "
+                                 "expression:\n%2")
+                             .arg(source, QString::fromStdString(r.error)));
+    return;
+  case ingest::Result::Kind::Number: {
+    // Keep the digits as written; the next operator/equals commits them.
+    QString text = QString::fromStdString(r.numbers.first);
+    if (text.startsWith('+'))
+      text.remove(0, 1);
+    if (symbolShower)
+      symbolShower->setText(text);
+    history_ << QString("%1 -> %2").arg(source, text);
+    return;
+  }
+  case ingest::Result::Kind::Expression:
+    if (symbolShower)
+      symbolShower->setText(formatValue(r.value, 0));
+    history_ << QString("%1 -> %2").arg(source, formatValue(r.value, 0));
+    return;
+  case ingest::Result::Kind::List: {
+    const ingest::Summary &s = r.numbers;
+    const long double mean = s.sum / static_cast<long double>(s.count);
+    if (symbolShower)
+      symbolShower->setText(formatValue(s.sum, 0));
+    history_ << QString("%1: sum of %2 numbers -> %3")
+                    .arg(source)
+                    .arg(s.count)
+                    .arg(formatValue(s.sum, 0));
+    QMessageBox::information(
+        this, "Input",
+        QString("%1 numbers (%2 bytes)\nSum: %3\nMean: %4\nMin: %5\n"
+                "Max: %6\n\nThe sum is on the display.")
+            .arg(s.count)
+            .arg(r.bytes)
+            .arg(formatValue(s.sum, 0), formatValue(mean, 0),
+                 formatValue(s.min, 0), formatValue(s.max, 0)));
+    return;
+  }
+  }
+}
+
 /// @brief Appends a digit to the current input displayed on the calculator
 /// screen.
 /// @param d The digit to append (0-9).
@@ -277,7 +846,7 @@ void UICalculator::appendDigit(int d) {
   if (!symbolShower)
     return;
   QString cur = symbolShower->text();
-  if (cur == "0")
+  if (cur == "0" || isComplexText(cur))
     cur.clear();
   symbolShower->setText(cur + QString::number(d));
 }
@@ -291,21 +860,133 @@ void UICalculator::appendDigit(int d) {
 void UICalculator::commitCurrentNumber() {
   if (!symbolShower)
     return;
-  bool ok = false;
-  double v = symbolShower->text().toDouble(&ok);
-  long double lv = ok ? static_cast<long double>(v) : 0.0L;
+  const auto v = parseDecimal(symbolShower->text());
+  long double lv = v.value_or(0.0L);
+  long double li = 0.0L;
+  if (!v) { // a+bi / polar entry from the Complex mode
+    if (const auto z = parseComplexText(symbolShower->text())) {
+      lv = z->real();
+      li = z->imag();
+    }
+  }
+  // Whole numbers also keep an exact copy for the engine's integer path.
+  const auto exact = checked::parse(symbolShower->text().toStdString());
+  // Fraction mode reads "n/d" and decimals exactly.
+  std::optional<Rational> fraction;
+  if (fractionMode_) {
+    fraction = Rational::fromString(symbolShower->text().toStdString());
+    if (fraction)
+      lv = fraction->toLongDouble();
+  }
   if (enteringFirst_) {
     value1_ = lv;
+    imag1_ = li;
+    frac1_ = fraction;
+    exact1_ = exact;
     enteringFirst_ = false;
   } else {
     value2_ = lv;
+    imag2_ = li;
+    frac2_ = fraction;
+    exact2_ = exact;
   }
   symbolShower->setText("0");
 }
 
+/// @brief Push value1_ or value2_ into the engine.
+/// @param first true for the first operand, false for the second.
+///
+/// Exact integers go through Engine::setInteger1/2 so digits beyond long
+/// double precision survive into the integer fast path.
+void UICalculator::syncOperand(bool first) {
+  const auto &exact = first ? exact1_ : exact2_;
+  const long double imag = first ? imag1_ : imag2_;
+  if (imag != 0.0L) {
+    const std::complex<long double> z(first ? value1_ : value2_, imag);
+    if (first)
+      engine_->setComplex1(z);
+    else
+      engine_->setComplex2(z);
+  } else if (exact) {
+    if (first)
+      engine_->setInteger1(*exact);
+    else
+      engine_->setInteger2(*exact);
+  } else if (first) {
+    engine_->setValue1(value1_);
+  } else {
+    engine_->setValue2(value2_);
+  }
+  const auto &fraction = first ? frac1_ : frac2_;
+  if (fraction && imag == 0.0L) {
+    if (first)
+      engine_->setRational1(*fraction);
+    else
+      engine_->setRational2(*fraction);
+  }
+}
+
+/// @brief Evaluate the pending operation, exactly when both operands are
+/// integers and the result fits, as a reduced fraction in fraction mode, on
+/// the complex plane when needed.
+/// @param exact Set to the exact result, or reset when unavailable.
+/// @param fraction Set to the exact fraction in fraction mode, else reset.
+/// @param big Set to the exact result when it overflows @p exact, else reset.
+/// @return Result value, or std::nullopt on error.
+std::optional<std::complex<long double>>
+UICalculator::evaluateEngine(std::optional<checked::Int> &exact,
+                             std::optional<Rational> &fraction,
+                             std::optional<BigInt> &big) {
+  fraction.reset();
+  big.reset();
+  if (fractionMode_) {
+    fraction = engine_->evaluateRational();
+    if (fraction) {
+      exact.reset();
+      return std::complex<long double>(fraction->toLongDouble(), 0.0L);
+    }
+  }
+  exact = engine_->evaluateInteger();
+  if (exact)
+    return std::complex<long double>(static_cast<long double>(*exact), 0.0L);
+  big = engine_->evaluateBigInteger();
+  if (big)
+    return std::complex<long double>(big->toLongDouble(), 0.0L);
+  return engine_->evaluateComplex();
+}
+
+/// @brief Text shown for a result.
+/// @param r Result value.
+/// @param exact Exact integer result, if any.
+/// @param fraction Exact fraction result, if any.
+/// @param big Exact integer result beyond checked::Int, if any.
+/// @return "n/d" for fractions, all digits for exact integers, otherwise the
+/// decimal format.
+QString UICalculator::resultText(const std::complex<long double> &r,
+                                 const std::optional<checked::Int> &exact,
+                                 const std::optional<Rational> &fraction,
+                                 const std::optional<BigInt> &big) const {
+  if (fraction)
+    return QString::fromStdString(fraction->toString());
+  if (exact)
+    return QString::fromStdString(checked::toString(*exact));
+  if (big)
+    return QString::fromStdString(big->toString());
+  const long double re = r.real();
+  const long double im = r.imag();
+  if (im == 0.0L)
+    return decimalText(re);
+  const QString imText =
+      std::fabs(im) == 1.0L ? QString() : decimalText(std::fabs(im));
+  if (re == 0.0L)
+    return (im < 0 ? "-" : "") + imText + "i";
+  return decimalText(re) + (im < 0 ? "-" : "+") + imText + "i";
+}
+
 /// @brief Converts an integer operator code to the corresponding Engine::Op
 /// enum value.
-/// @param code Operator code (0=Add, 1=Sub, 2=Mul, 3=Div).
+/// @param code Operator code (0=Add, 1=Sub, 2=Mul, 3=Div, 4=Gcd, 5=Lcm,
+/// 6=Pow).
 /// @return Corresponding Engine::Op enum value.
 static inline Engine::Op fromCode(int code) {
   switch (code) {
@@ -317,6 +998,12 @@ static inline Engine::Op fromCode(int code) {
     return Engine::Op::Mul;
   case 3:
     return Engine::Op::Div;
+  case 4:
+    return Engine::Op::Gcd;
+  case 5:
+    return Engine::Op::Lcm;
+  case 6:
+    return Engine::Op::Pow;
   default:
     return Engine::Op::None;
   }
@@ -345,7 +1032,7 @@ void UICalculator::onOperatorPressed(int opCode) {
 
     // Ensure engine has v1
     if (!engine_->hasV1()) {
-      engine_->setValue1(value1_);
+      syncOperand(true);
     }
 
     const bool hasPrevOp = (engine_->op() != Engine::Op::None);
@@ -355,22 +1042,37 @@ void UICalculator::onOperatorPressed(int opCode) {
     // Only chain-evaluate if a previous operator exists AND both operands are
     // present
     if (readyForChain) {
-      auto res = engine_->evaluate();
+      std::optional<checked::Int> exact;
+      std::optional<Rational> fraction;
+      std::optional<BigInt> big;
+      auto res = evaluateEngine(exact, fraction, big);
       if (res.has_value()) {
-        long double r = *res;
+        const std::complex<long double> r = *res;
         if (symbolShower)
-          symbolShower->setText(QString::number(static_cast<double>(r)));
+          symbolShower->setText(resultText(r, exact, fraction, big));
         // Carry result forward as new v1 and keep capturing for next v2
-        value1_ = r;
+        value1_ = r.real();
         value2_ = 0.0L;
+        imag1_ = r.imag();
+        frac1_ = fraction;
+        imag2_ = 0.0L;
+        frac2_.reset();
+        exact1_ = exact;
+        exact2_.reset();
         enteringFirst_ = false;
         engine_->clear();
-        engine_->setValue1(value1_);
+        syncOperand(true);
       } else {
         if (symbolShower)
           symbolShower->setText("Error");
         enteringFirst_ = true;
         value1_ = value2_ = 0.0L;
+        exact1_.reset();
+        imag1_ = 0.0L;
+        frac1_.reset();
+        exact2_.reset();
+        imag2_ = 0.0L;
+        frac2_.reset();
         engine_->clear();
         return;
       }
@@ -392,24 +1094,39 @@ void UICalculator::onEqualsPressed() {
   // Finalize current entry into value2
   commitCurrentNumber();
   if (!engine_->hasV1())
-    engine_->setValue1(value1_);
+    syncOperand(true);
   if (!engine_->hasV2())
-    engine_->setValue2(value2_);
-  auto res = engine_->evaluate();
+    syncOperand(false);
+  std::optional<checked::Int> exact;
+  std::optional<Rational> fraction;
+  std::optional<BigInt> big;
+  auto res = evaluateEngine(exact, fraction, big);
   if (res.has_value() && symbolShower) {
-    long double r = *res;
-    symbolShower->setText(QString::number(static_cast<double>(r)));
+    const std::complex<long double> r = *res;
+    symbolShower->setText(resultText(r, exact, fraction, big));
     // Prepare for chaining
-    value1_ = r;
+    value1_ = r.real();
     value2_ = 0.0L;
+    imag1_ = r.imag();
+    frac1_ = fraction;
+    imag2_ = 0.0L;
+    frac2_.reset();
+    exact1_ = exact;
+    exact2_.reset();
     enteringFirst_ = false;
     engine_->clear();
-    engine_->setValue1(value1_);
+    syncOperand(true);
   } else {
     if (symbolShower)
       symbolShower->setText("Error");
     enteringFirst_ = true;
     value1_ = value2_ = 0.0L;
+    exact1_.reset();
+    imag1_ = 0.0L;
+    frac1_.reset();
+    exact2_.reset();
+    imag2_ = 0.0L;
+    frac2_.reset();
     engine_->clear();
   }
 }
@@ -434,7 +1151,7 @@ QString UICalculator::formatValue(long double v, int baseCode) const {
   }
   case 0:
   default: // Dec
-    return QString::number(static_cast<double>(v));
+    return decimalText(v);
   }
 }
 
@@ -469,17 +1186,26 @@ void UICalculator::onRandomPressed() {
   long double r = *res;
 
   // Show it
-  symbolShower->setText(QString::number(static_cast<double>(r)));
+  symbolShower->setText(decimalText(r));
 
   if (hasPendingOp) {
     // We already have v1 and an operator: treat Random as v2
     value2_ = r;
+    exact2_.reset();
+    imag2_ = 0.0L;
+    frac2_.reset();
     enteringFirst_ = false;      // ensure subsequent commit targets v2
     engine_->setValue2(value2_); // keep existing op intact
   } else {
     // No operator pending: treat Random as v1 and prepare for operator next
     value1_ = r;
     value2_ = 0.0L;
+    exact1_.reset();
+    imag1_ = 0.0L;
+    frac1_.reset();
+    exact2_.reset();
+    imag2_ = 0.0L;
+    frac2_.reset();
     enteringFirst_ = true; // next op press commits as v1
     engine_->clear();      // start fresh with v1 only
     engine_->setValue1(value1_);
@@ -488,7 +1214,7 @@ void UICalculator::onRandomPressed() {
   // Optional: log to history if available
   history_ << QString("Random(0..%1) -> %2")
                   .arg(QString::number(max))
-                  .arg(QString::number(static_cast<double>(r)));
+                  .arg(decimalText(r));
 }
 
 /// @brief Convert current display value to Hex, Oct, Bin and show one's/two's
@@ -544,6 +1270,1046 @@ void UICalculator::onConvertPressed() {
   QMessageBox::information(this, "Conversions", msg);
 }
 
+/// @brief Run a Monte Carlo simulation of a user expression.
+///
+/// The expression may use x, y and z; each variable present gets its own
+/// independent draw per sample. Results are shown in a dialog and logged to
+/// the history.
+void UICalculator::onSimulatePressed() {
+  bool ok = false;
+  const QString text = QInputDialog::getText(
+      this, "Monte Carlo", "Expression in x (y, z optional):",
+      QLineEdit::Normal, "4*sqrt(1-x^2)", &ok);
+  if (!ok || text.trimmed().isEmpty())
+    return;
+
+  // Use as few variables as the expression needs.
+  std::optional<Expression> expr;
+  std::string error;
+  const std::vector<std::vector<std::string>> varSets = {
+      {"x"}, {"x", "y"}, {"x", "y", "z"}};
+  for (const auto &vars : varSets) {
+    expr = Expression::compile(text.toStdString(), vars, &error);
+    if (expr)
+      break;
+  }
+  if (!expr) {
+    QMessageBox::warning(this, "Monte Carlo", QString::fromStdString(error));
+    return;
+  }
+
+  const QStringList dists = {"Uniform(a, b)", "Normal(mean, sd)",
+                             "Exponential(rate)", "LogNormal(mu, sigma)"};
+  const QString dist = QInputDialog::getItem(this, "Monte Carlo",
+                                             "Distribution:", dists, 0,
+                                             false, &ok);
+  if (!ok)
+    return;
+  montecarlo::DistributionSpec spec;
+  spec.kind = static_cast<montecarlo::Distribution>(dists.indexOf(dist));
+
+  const QString params =
+      QInputDialog::getText(this, "Monte Carlo", "Parameters (a b):",
+                            QLineEdit::Normal, "0 1", &ok);
+  if (!ok)
+    return;
+  const QStringList parts = params.split(' ', Qt::SkipEmptyParts);
+  bool valid = parts.size() <= 2;
+  double *targets[] = {&spec.a, &spec.b};
+  for (int i = 0; valid && i < parts.size(); ++i) {
+    const auto v = parseDecimal(parts[i]);
+    valid = v.has_value();
+    *targets[i] = static_cast<double>(v.value_or(0.0L));
+  }
+  if (!valid) {
+    QMessageBox::warning(this, "Monte Carlo",
+                         "Expected up to two numeric parameters.");
+    return;
+  }
+
+  const QString count =
+      QInputDialog::getText(this, "Monte Carlo", "Samples:",
+                            QLineEdit::Normal, "1000000", &ok);
+  if (!ok)
+    return;
+  montecarlo::Options options;
+  options.samples = count.trimmed().toULongLong(&ok);
+  if (!ok)
+    return;
+
+  // Sized for billions of samples: run on a worker behind a progress bar.
+  auto task = std::make_shared<Task>();
+  task->total = options.samples;
+  options.cancel = &task->cancel;
+  options.progress = &task->done;
+  auto shared = std::make_shared<const Expression>(std::move(*expr));
+  auto res = std::make_shared<std::optional<montecarlo::Result>>();
+  runTask(
+      "Monte Carlo",
+      QString("Drawing %1 samples...")
+          .arg(static_cast<qulonglong>(options.samples)),
+      task,
+      [shared, spec, options, res] {
+        *res = montecarlo::simulate(*shared, spec, options);
+      },
+      [this, task, res, options, text, dist] {
+        showSimulation(task->cancel, *res, options, text, dist);
+      });
+}
+
+/// @brief Report a finished Monte Carlo run.
+void UICalculator::showSimulation(
+    bool cancelled, const std::optional<montecarlo::Result> &res,
+    const montecarlo::Options &options, const QString &text,
+    const QString &dist) {
+  if (cancelled) {
+    history_ << QString("MonteCarlo(%1): cancelled").arg(text);
+    return;
+  }
+  if (!res.has_value()) {
+    QMessageBox::warning(this, "Monte Carlo", "Invalid parameters.");
+    return;
+  }
+
+  QString msg;
+  msg += QString("Samples: %1 (%2 valid)\n")
+             .arg(static_cast<qulonglong>(res->samples))
+             .arg(static_cast<qulonglong>(res->valid));
+  msg += "Mean:  " + QString::number(res->mean, 'g', 12) + "\n";
+  msg += "StdDev: " + QString::number(res->stddev, 'g', 8) + "\n";
+  msg += QString("%1% CI: [%2, %3]\n")
+             .arg(options.confidence * 100.0)
+             .arg(QString::number(res->ciLow, 'g', 12))
+             .arg(QString::number(res->ciHigh, 'g', 12));
+  msg += QString("Time: %1 s\n\n").arg(res->seconds, 0, 'f', 3);
+
+  // Text histogram scaled to the tallest bin.
+  std::uint64_t peak = 1;
+  for (std::uint64_t c : res->histogram)
+    peak = std::max(peak, c);
+  const double width =
+      (res->histMax - res->histMin) / static_cast<double>(res->histogram.size());
+  for (std::size_t i = 0; i < res->histogram.size(); ++i) {
+    const int bar = static_cast<int>(40 * res->histogram[i] / peak);
+    msg += QString("%1 | %2\n")
+               .arg(res->histMin + width * static_cast<double>(i), 10, 'g', 4)
+               .arg(QString(bar, '#'));
+  }
+
+  QMessageBox::information(this, "Monte Carlo", msg);
+  history_ << QString("MonteCarlo(%1, %2, n=%3) -> %4")
+                  .arg(text, dist, QString::number(options.samples),
+                       QString::number(res->mean, 'g', 12));
+}
+
+/// @brief Show primality and prime factorization of the displayed integer.
+void UICalculator::onFactorPressed() {
+  if (!symbolShower)
+    return;
+  bool ok = false;
+  const qulonglong n = symbolShower->text().trimmed().toULongLong(&ok, 10);
+  if (!ok) {
+    QMessageBox::warning(this, "Factor",
+                         "Enter a non-negative integer below 2^64.");
+    return;
+  }
+
+  QString factors;
+  for (const auto &pe : Engine::factorize(n)) {
+    if (!factors.isEmpty())
+      factors += " × ";
+    factors += QString::number(static_cast<qulonglong>(pe.first));
+    if (pe.second > 1)
+      factors += QString("^%1").arg(pe.second);
+  }
+  if (factors.isEmpty())
+    factors = QString::number(n);
+
+  QString msg;
+  msg += "n:      " + QString::number(n) + "\n";
+  msg += QString("Prime:  %1\n").arg(Engine::isPrime(n) ? "yes" : "no");
+  msg += "Factors: " + factors + "\n";
+  QMessageBox::information(this, "Factor", msg);
+  history_ << QString("Factor(%1) -> %2").arg(QString::number(n), factors);
+}
+
+/// @brief Prompt for a, e and m and show a^e mod m and a^-1 mod m.
+void UICalculator::onModularPressed() {
+  bool ok = false;
+  const QString text = QInputDialog::getText(
+      this, "Modular", "a e m (unsigned 64-bit):", QLineEdit::Normal,
+      (symbolShower ? symbolShower->text() : QString("0")) + " 2 1000000007",
+      &ok);
+  if (!ok)
+    return;
+  const QStringList parts = text.split(' ', Qt::SkipEmptyParts);
+  qulonglong v[3] = {0, 0, 0};
+  bool valid = parts.size() == 3;
+  for (int i = 0; valid && i < 3; ++i)
+    v[i] = parts[i].toULongLong(&valid, 10);
+  if (!valid) {
+    QMessageBox::warning(this, "Modular", "Expected three integers: a e m.");
+    return;
+  }
+
+  const auto pw = Engine::modPow(v[0], v[1], v[2]);
+  const auto inv = Engine::modInverse(v[0], v[2]);
+  QString msg;
+  msg += QString("%1^%2 mod %3 = %4\n")
+             .arg(v[0])
+             .arg(v[1])
+             .arg(v[2])
+             .arg(pw ? QString::number(static_cast<qulonglong>(*pw))
+                     : QString("undefined"));
+  msg += QString("%1^-1 mod %2 = %3\n")
+             .arg(v[0])
+             .arg(v[2])
+             .arg(inv ? QString::number(static_cast<qulonglong>(*inv))
+                      : QString("none"));
+  QMessageBox::information(this, "Modular", msg);
+}
+
+/// @brief Prompt for a combinatorial function and show its exact value.
+void UICalculator::onCombinatoricsPressed() {
+  bool ok = false;
+  const QStringList kinds = {"n!", "nCr", "nPr", "Catalan", "Multinomial"};
+  const QString kind = QInputDialog::getItem(this, "Combinatorics", "Function:",
+                                             kinds, 0, false, &ok);
+  if (!ok)
+    return;
+  const int arity = kind == "n!" || kind == "Catalan" ? 1
+                    : kind == "Multinomial"           ? -1
+                                                      : 2;
+  const QString prompt = arity == 1   ? "n:"
+                         : arity == 2 ? "n r:"
+                                      : "k1 k2 ... km:";
+  const QString text = QInputDialog::getText(
+      this, "Combinatorics", prompt, QLineEdit::Normal,
+      symbolShower ? symbolShower->text() : QString("0"), &ok);
+  if (!ok)
+    return;
+
+  const QStringList parts = text.split(' ', Qt::SkipEmptyParts);
+  std::vector<std::uint64_t> args;
+  bool valid = !parts.isEmpty() && (arity < 0 || parts.size() == arity);
+  for (int i = 0; valid && i < parts.size(); ++i)
+    args.push_back(parts[i].toULongLong(&valid, 10));
+  if (!valid) {
+    QMessageBox::warning(this, "Combinatorics",
+                         QString("Expected %1 non-negative integer(s).")
+                             .arg(arity < 0 ? QString("one or more")
+                                            : QString::number(arity)));
+    return;
+  }
+
+  QApplication::setOverrideCursor(Qt::WaitCursor);
+  std::optional<BigInt> res;
+  if (kind == "n!")
+    res = Engine::factorial(args[0]);
+  else if (kind == "nCr")
+    res = Engine::choose(args[0], args[1]);
+  else if (kind == "nPr")
+    res = Engine::permutations(args[0], args[1]);
+  else if (kind == "Catalan")
+    res = Engine::catalan(args[0]);
+  else
+    res = Engine::multinomial(args);
+  QString digits = res ? QString::fromStdString(res->toString()) : QString();
+  QApplication::restoreOverrideCursor();
+
+  if (!res) {
+    QMessageBox::warning(this, "Combinatorics", "Argument too large.");
+    return;
+  }
+  const qsizetype count = digits.size();
+  if (count > 200) // keep the dialog readable; the count says the rest
+    digits = digits.left(60) + " ... " + digits.right(60);
+  QMessageBox::information(
+      this, "Combinatorics",
+      QString("%1(%2) =\n%3\n\n%4 digits").arg(kind, text, digits).arg(count));
+  history_ << QString("%1(%2) -> %3 digits").arg(kind, text).arg(count);
+}
+
+/// @brief Digits of a constant; the leading digits become the current entry
+/// and the full expansion goes to the clipboard.
+void UICalculator::onConstantsPressed() {
+  bool ok = false;
+  const QStringList kinds = {"π", "e", "√2", "ln 2"};
+  const constants::Constant values[] = {
+      constants::Constant::Pi, constants::Constant::E,
+      constants::Constant::Sqrt2, constants::Constant::Ln2};
+  const QString kind = QInputDialog::getItem(this, "Constants", "Constant:",
+                                             kinds, 0, false, &ok);
+  if (!ok)
+    return;
+  const int digits = QInputDialog::getInt(
+      this, "Constants", "Decimal digits:", 1000, 1,
+      static_cast<int>(constants::kMaxDigits), 1, &ok);
+  if (!ok)
+    return;
+
+  // Up to 10^8 digits: run on a worker behind a cancellable busy dialog.
+  auto task = std::make_shared<Task>();
+  auto r = std::make_shared<std::optional<constants::Result>>();
+  const constants::Constant c = values[kinds.indexOf(kind)];
+  const std::string cacheDir =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+          .toStdString();
+  runTask(
+      "Constants",
+      QString("Computing %1 digits of %2...").arg(digits).arg(kind), task,
+      [task, r, c, digits, cacheDir] {
+        *r = Engine::constant(c, static_cast<std::size_t>(digits), cacheDir,
+                              &task->cancel);
+      },
+      [this, task, r, kind, digits] {
+        showConstant(task->cancel, *r, kind, digits);
+      });
+}
+
+/// @brief Report a finished constant computation.
+void UICalculator::showConstant(bool cancelled,
+                                const std::optional<constants::Result> &r,
+                                const QString &kind, int digits) {
+  if (cancelled) {
+    history_ << QString("%1 to %2 digits: cancelled").arg(kind).arg(digits);
+    return;
+  }
+  if (!r) {
+    QMessageBox::warning(this, "Constants", "Unsupported number of digits.");
+    return;
+  }
+
+  QString text = QString::fromStdString(r->text);
+  QApplication::clipboard()->setText(text);
+  if (symbolShower) // as many digits as the display's long double keeps
+    symbolShower->setText(text.left(21));
+  if (text.size() > 200) // keep the dialog readable
+    text = text.left(60) + " ... " + text.right(60);
+  QMessageBox::information(
+      this, "Constants",
+      QString("%1 =\n%2\n\n%3 digits, %4 (copied to the clipboard)")
+          .arg(kind, text)
+          .arg(digits)
+          .arg(r->cached ? QString("from cache")
+                         : QString("%1 s").arg(r->seconds, 0, 'f', 2)));
+  history_ << QString("%1 to %2 digits").arg(kind).arg(digits);
+}
+
+/// @brief Definite integral or derivative of an expression in x; the result
+/// becomes the current entry.
+void UICalculator::onCalculusPressed() {
+  bool ok = false;
+  const QStringList kinds = {"Integral", "Derivative f'(x)",
+                             "Second derivative f''(x)"};
+  const QString kind = QInputDialog::getItem(this, "Calculus", "Operation:",
+                                             kinds, 0, false, &ok);
+  if (!ok)
+    return;
+  const QString text = QInputDialog::getText(
+      this, "Calculus", "Expression in x:", QLineEdit::Normal,
+      "sin(100*x)*exp(-x)", &ok);
+  if (!ok || text.trimmed().isEmpty())
+    return;
+  std::string error;
+  const auto expr = Expression::compile(text.toStdString(), {"x"}, &error);
+  if (!expr) {
+    QMessageBox::warning(this, "Calculus", QString::fromStdString(error));
+    return;
+  }
+
+  const bool integral = kind == kinds[0];
+  const QString where = QInputDialog::getText(
+      this, "Calculus", integral ? "Limits (a b):" : "At x:",
+      QLineEdit::Normal, integral ? "0 10" : "1", &ok);
+  if (!ok)
+    return;
+  const QStringList parts = where.split(' ', Qt::SkipEmptyParts);
+  bool valid = parts.size() == (integral ? 2 : 1);
+  std::vector<double> args;
+  for (int i = 0; valid && i < parts.size(); ++i) {
+    const auto v = parseDecimal(parts[i]);
+    valid = v.has_value();
+    args.push_back(static_cast<double>(v.value_or(0.0L)));
+  }
+  if (!valid) {
+    QMessageBox::warning(this, "Calculus",
+                         integral ? "Expected two limits." : "Expected x.");
+    return;
+  }
+
+  double value = 0.0;
+  QString msg;
+  if (integral) {
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const auto r = calculus::integrate(*expr, args[0], args[1]);
+    QApplication::restoreOverrideCursor();
+    if (!r) {
+      QMessageBox::warning(this, "Calculus",
+                           "The integrand is not finite on the interval.");
+      return;
+    }
+    value = r->value;
+    msg = QString("∫ %1 dx over [%2, %3]\n= %4\n± %5%6\n\n"
+                  "%7 subintervals, %8 evaluations, %9 ms")
+              .arg(text, parts[0], parts[1])
+              .arg(QString::number(r->value, 'g', 16))
+              .arg(QString::number(r->error, 'g', 3))
+              .arg(r->converged ? QString() : QString(" (not converged)"))
+              .arg(static_cast<qulonglong>(r->intervals))
+              .arg(static_cast<qulonglong>(r->evaluations))
+              .arg(r->seconds * 1e3, 0, 'f', 2);
+  } else {
+    const int order = kind == kinds[1] ? 1 : 2;
+    const auto r = calculus::differentiate(*expr, args[0], order);
+    if (!r) {
+      QMessageBox::warning(this, "Calculus",
+                           "The function is not finite near x.");
+      return;
+    }
+    value = r->value;
+    msg = QString("%1 of %2 at x = %3\n= %4\n± %5")
+              .arg(kind, text, parts[0])
+              .arg(QString::number(r->value, 'g', 16))
+              .arg(QString::number(r->error, 'g', 3));
+  }
+  QMessageBox::information(this, "Calculus", msg);
+  if (symbolShower) // the result stays the current entry
+    symbolShower->setText(decimalText(value));
+  history_ << QString("%1(%2, %3) -> %4")
+                  .arg(kind, text, where, decimalText(value));
+}
+
+/// @brief Convert the displayed value between two units; the result becomes
+/// the current entry.
+void UICalculator::onUnitsPressed() {
+  if (!symbolShower)
+    return;
+  const auto entry = parseDecimal(symbolShower->text());
+  if (!entry) {
+    QMessageBox::warning(this, "Units", "Enter a number first.");
+    return;
+  }
+  const long double value = *entry;
+  bool ok = false;
+  const QString text = QInputDialog::getText(
+      this, "Units", "From and to units (e.g. km/h m/s, degC degF):",
+      QLineEdit::Normal, "km mi", &ok);
+  if (!ok)
+    return;
+  const QStringList parts = text.split(' ', Qt::SkipEmptyParts);
+  if (parts.size() != 2) {
+    QMessageBox::warning(this, "Units", "Expected two units.");
+    return;
+  }
+  const std::string from = parts[0].toStdString();
+  const std::string to = parts[1].toStdString();
+  const auto r = Engine::convertUnits(value, from, to);
+  if (!r) {
+    QMessageBox::warning(this, "Units",
+                         QString("Cannot convert %1 to %2.").arg(parts[0],
+                                                                 parts[1]));
+    return;
+  }
+  const QString result = decimalText(*r);
+  symbolShower->setText(result);
+  history_ << QString("%1 %2 -> %3 %4")
+                  .arg(decimalText(value), parts[0], result, parts[1]);
+}
+
+/// @brief Polynomial roots or a root of f(x) = 0; a real root becomes the
+/// current entry.
+void UICalculator::onSolvePressed() {
+  bool ok = false;
+  const QStringList kinds = {"Polynomial roots", "f(x) = 0"};
+  const QString kind = QInputDialog::getItem(this, "Solve", "Equation:",
+                                             kinds, 0, false, &ok);
+  if (!ok)
+    return;
+
+  if (kind == kinds[0]) {
+    const QString text = QInputDialog::getText(
+        this, "Solve",
+        "Coefficients, highest power first (a+bi allowed):",
+        QLineEdit::Normal, "1 0 -2", &ok);
+    if (!ok)
+      return;
+    std::vector<solver::Complex> coeffs;
+    for (const QString &part :
+         text.split(QRegularExpression("[\\s,;]+"), Qt::SkipEmptyParts)) {
+      const auto a = parseComplexText(part);
+      if (!a) {
+        QMessageBox::warning(this, "Solve", "Not a number: " + part);
+        return;
+      }
+      coeffs.emplace_back(static_cast<double>(a->real()),
+                          static_cast<double>(a->imag()));
+    }
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const auto r = solver::polynomialRoots(coeffs);
+    QApplication::restoreOverrideCursor();
+    if (!r) {
+      QMessageBox::warning(this, "Solve",
+                           "Enter a non-constant polynomial with finite "
+                           "coefficients.");
+      return;
+    }
+    const std::size_t n = r->roots.size();
+    QStringList lines;
+    for (std::size_t i = 0; i < n; ++i) {
+      const std::complex<long double> z(r->roots[i].real(),
+                                        r->roots[i].imag());
+      lines << QString("x%1 = %2  ± %3")
+                   .arg(static_cast<qulonglong>(i + 1))
+                   .arg(resultText(z, std::nullopt))
+                   .arg(QString::number(r->errors[i], 'g', 2));
+    }
+    constexpr int kShown = 20; // the rest go to the details pane
+    QMessageBox box(QMessageBox::Information, "Solve",
+                    QString("Degree %1: %2 sweeps%3, %4 ms\n\n%5%6")
+                        .arg(static_cast<qulonglong>(n))
+                        .arg(r->iterations)
+                        .arg(r->converged ? QString()
+                                          : QString(" (not converged)"))
+                        .arg(r->seconds * 1e3, 0, 'f', 2)
+                        .arg(lines.mid(0, kShown).join('\n'))
+                        .arg(lines.size() > kShown ? "\n..." : ""),
+                    QMessageBox::Ok, this);
+    if (lines.size() > kShown)
+      box.setDetailedText(lines.join('\n'));
+    box.exec();
+    history_ << QString("roots(%1) -> %2 roots")
+                    .arg(text)
+                    .arg(static_cast<qulonglong>(n));
+    return;
+  }
+
+  const QString text = QInputDialog::getText(
+      this, "Solve", "f(x) = 0, with f:", QLineEdit::Normal, "cos(x) - x",
+      &ok);
+  if (!ok || text.trimmed().isEmpty())
+    return;
+  std::string error;
+  const auto expr = Expression::compile(text.toStdString(), {"x"}, &error);
+  if (!expr) {
+    QMessageBox::warning(this, "Solve", QString::fromStdString(error));
+    return;
+  }
+  const QString where = QInputDialog::getText(
+      this, "Solve", "Guess x0, or bracket a b:", QLineEdit::Normal, "1", &ok);
+  if (!ok)
+    return;
+  const QStringList parts = where.split(' ', Qt::SkipEmptyParts);
+  bool valid = parts.size() == 1 || parts.size() == 2;
+  std::vector<long double> args;
+  for (int i = 0; valid && i < parts.size(); ++i) {
+    const auto v = parseDecimal(parts[i]);
+    valid = v.has_value();
+    args.push_back(v.value_or(0.0L));
+  }
+  if (!valid) {
+    QMessageBox::warning(this, "Solve", "Expected x0 or a b.");
+    return;
+  }
+  const auto r = args.size() == 2 ? solver::findRoot(*expr, args[0], args[1])
+                                  : solver::findRoot(*expr, args[0]);
+  if (!r) {
+    QMessageBox::warning(this, "Solve",
+                         args.size() == 2
+                             ? "f(a) and f(b) must be finite with opposite signs."
+                             : "f is not finite at x0.");
+    return;
+  }
+  const QString root = decimalText(r->root);
+  QMessageBox::information(
+      this, "Solve",
+      QString("%1 = 0\nx = %2\n± %3%4\n\nf(x) = %5, %6 evaluations%7")
+          .arg(text, root)
+          .arg(QString::number(static_cast<double>(r->error), 'g', 2))
+          .arg(r->converged ? QString() : QString(" (not converged)"))
+          .arg(QString::number(static_cast<double>(r->value), 'g', 3))
+          .arg(r->evaluations)
+          .arg(r->bracketed ? QString(" (bracketed)") : QString()));
+  if (symbolShower) // the root stays the current entry
+    symbolShower->setText(root);
+  history_ << QString("solve(%1, %2) -> %3").arg(text, where, root);
+}
+
+/// @brief Transform, spectrum or convolution of pasted/loaded series; the full
+/// output goes to the clipboard, one value (or "re im" pair) per line.
+void UICalculator::onFftPressed() {
+  bool ok = false;
+  const QStringList kinds = {"Forward FFT", "Inverse FFT", "Power spectrum",
+                             "Convolution", "Correlation"};
+  const QString kind =
+      QInputDialog::getItem(this, "FFT", "Operation:", kinds, 0, false, &ok);
+  if (!ok)
+    return;
+  const int op = kinds.indexOf(kind);
+
+  // Files are parsed straight from their bytes, without a QString copy.
+  auto readText = [this](const QString &label, const QString &hint,
+                         const QString &example) -> std::optional<QByteArray> {
+    bool picked = false;
+    const QStringList sources = {"Paste values", "Load file..."};
+    const QString source = QInputDialog::getItem(this, "FFT", label, sources,
+                                                 0, false, &picked);
+    if (!picked)
+      return std::nullopt;
+    if (source == sources[0]) {
+      const QString text = QInputDialog::getMultiLineText(
+          this, "FFT", label + " (" + hint + "):", example, &picked);
+      if (!picked)
+        return std::nullopt;
+      return text.toUtf8();
+    }
+    const QString path = QFileDialog::getOpenFileName(this, label);
+    if (path.isEmpty())
+      return std::nullopt;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+      QMessageBox::warning(this, "FFT", "Cannot read " + path + ".");
+      return std::nullopt;
+    }
+    return file.readAll();
+  };
+  auto view = [](const QByteArray &bytes) {
+    return std::string_view(bytes.constData(),
+                            static_cast<std::size_t>(bytes.size()));
+  };
+  auto readSeries = [&](const QString &label)
+      -> std::optional<std::vector<double>> {
+    const auto bytes = readText(
+        label, "numbers separated by spaces, commas or lines", "1 2 3 4");
+    if (!bytes)
+      return std::nullopt;
+    auto values = fft::parseSeries(view(*bytes));
+    if (!values || values->empty()) {
+      QMessageBox::warning(this, "FFT", "Expected a list of numbers.");
+      return std::nullopt;
+    }
+    return values;
+  };
+
+  // The inverse reads what the forward transform writes: "re im" per line.
+  std::optional<std::vector<double>> a, b;
+  std::optional<fft::ComplexSeries> spectrum;
+  if (op == 1) {
+    const auto bytes =
+        readText("Spectrum:", "one \"re im\" pair or real value per line",
+                 "10 0\n-2 2\n-2 0\n-2 -2");
+    if (!bytes)
+      return;
+    spectrum = fft::parseComplexSeries(view(*bytes));
+    if (!spectrum || spectrum->re.empty()) {
+      QMessageBox::warning(this, "FFT",
+                           "Expected one \"re im\" pair per line.");
+      return;
+    }
+  } else if (!(a = readSeries(op >= 3 ? "First series:" : "Series:"))) {
+    return;
+  }
+  if (op >= 3 && !(b = readSeries("Second series:")))
+    return;
+  const std::size_t inputs = spectrum ? spectrum->re.size()
+                                      : a->size() + (b ? b->size() : 0);
+
+  QApplication::setOverrideCursor(Qt::WaitCursor);
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<double> re, im;
+  if (op == 0) { // zero-padded complex transform of the real series
+    const std::size_t n = fft::nextPowerOfTwo(a->size());
+    re.assign(n, 0.0);
+    im.assign(n, 0.0);
+    std::copy(a->begin(), a->end(), re.begin());
+    fft::forward(re.data(), im.data(), n);
+  } else if (op == 1) { // zero-padded like the forward transform
+    const std::size_t n = fft::nextPowerOfTwo(spectrum->re.size());
+    re = std::move(spectrum->re);
+    im = std::move(spectrum->im);
+    re.resize(n, 0.0);
+    im.resize(n, 0.0);
+    fft::inverse(re.data(), im.data(), n);
+  } else {
+    re = *(op == 2   ? fft::powerSpectrum(*a)
+           : op == 3 ? fft::convolve(*a, *b)
+                     : fft::correlate(*a, *b));
+  }
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  // One line per value (shortest round-trip text), then a single QString
+  // conversion.
+  std::string out;
+  if (im.empty()) {
+    out.resize(re.size() * (decimal::kMaxChars + 1));
+    out.resize(decimal::formatBatch(re.data(), re.size(), '\n', out.data()));
+  } else {
+    out.reserve(re.size() * 48);
+    char buffer[2 * decimal::kMaxChars];
+    for (std::size_t i = 0; i < re.size(); ++i) {
+      char *end = decimal::format(buffer, re[i]);
+      *end++ = ' ';
+      end = decimal::format(end, im[i]);
+      *end++ = '\n';
+      out.append(buffer, end);
+    }
+  }
+  QApplication::clipboard()->setText(QString::fromStdString(out));
+  QApplication::restoreOverrideCursor();
+
+  constexpr std::size_t kShown = 10;
+  QStringList shown;
+  for (std::size_t i = 0; i < std::min(re.size(), kShown); ++i)
+    shown << (im.empty() ? QString::number(re[i], 'g', 10)
+                         : QString("%1 %2i")
+                               .arg(QString::number(re[i], 'g', 10),
+                                    QString::number(im[i], 'g', 10)));
+  if (re.size() > kShown)
+    shown << "...";
+  QMessageBox::information(
+      this, "FFT",
+      QString("%1 of %2 values -> %3 values in %4 s\n\n%5\n\n(all copied "
+              "to the clipboard)")
+          .arg(kind)
+          .arg(inputs)
+          .arg(re.size())
+          .arg(seconds, 0, 'g', 3)
+          .arg(shown.join('\n')));
+  history_ << QString("%1 (%2 values)").arg(kind).arg(re.size());
+}
+
+/// @brief Simplify or differentiate an expression symbolically; a value at a
+/// given point becomes the current entry.
+void UICalculator::onSymbolicPressed() {
+  bool ok = false;
+  const QString text = QInputDialog::getText(
+      this, "Symbolic", "Expression in x, y, z:", QLineEdit::Normal,
+      "x^2*sin(x) + x*x", &ok);
+  if (!ok || text.trimmed().isEmpty())
+    return;
+  const QStringList kinds = {"Simplify", "d/dx", "d/dy", "d/dz", "d²/dx²"};
+  const QString kind = QInputDialog::getItem(this, "Symbolic", "Operation:",
+                                             kinds, 1, false, &ok);
+  if (!ok)
+    return;
+
+  symbolic::Graph graph({"x", "y", "z"});
+  std::string error;
+  const auto parsed = graph.parse(text.toStdString(), &error);
+  if (!parsed) {
+    QMessageBox::warning(this, "Symbolic", QString::fromStdString(error));
+    return;
+  }
+  symbolic::NodeId result = *parsed;
+  const int op = kinds.indexOf(kind);
+  switch (op) {
+  case 1:
+  case 2:
+  case 3:
+    result = graph.derivative(result, static_cast<std::size_t>(op - 1));
+    break;
+  case 4:
+    result = graph.derivative(graph.derivative(result, 0), 0);
+    break;
+  default:
+    break;
+  }
+
+  const QString where = QInputDialog::getText(
+      this, "Symbolic", "Evaluate at x y z (empty to skip):",
+      QLineEdit::Normal, "1", &ok);
+  if (!ok)
+    return;
+  const QStringList parts = where.split(' ', Qt::SkipEmptyParts);
+  long double point[3] = {0.0L, 0.0L, 0.0L};
+  bool valid = parts.size() <= 3;
+  for (int i = 0; valid && i < parts.size(); ++i) {
+    const auto v = parseDecimal(parts[i]);
+    valid = v.has_value();
+    point[i] = v.value_or(0.0L);
+  }
+  if (!valid) {
+    QMessageBox::warning(this, "Symbolic", "Expected up to three values.");
+    return;
+  }
+
+  const auto printed = graph.toString(result);
+  QString message = printed ? QString::fromStdString(*printed)
+                            : QString("(too long to show)");
+  message += QString("\n\n%1 shared nodes (%2 as a tree)")
+                 .arg(graph.dagSize(result))
+                 .arg(graph.treeSize(result), 0, 'g', 3);
+  if (!parts.isEmpty()) {
+    const QString value = decimalText(graph.evaluate(result, point));
+    message += QString("\n\nat (%1) = %2").arg(parts.join(", "), value);
+    if (symbolShower)
+      symbolShower->setText(value);
+  }
+  QMessageBox::information(this, "Symbolic", message);
+  history_ << QString("%1 %2").arg(kind, text);
+}
+
+/// @brief Finance mode: cash-flow measures, a schedule view or a CSV export.
+///
+/// Flows are entered one per line ("amount", or "YYYY-MM-DD amount" for the
+/// dated XNPV/XIRR variants). Rates are entered and shown in percent.
+void UICalculator::onFinancePressed() {
+  bool ok = false;
+  const QStringList kinds = {"NPV", "IRR", "PMT", "Amortization schedule",
+                             "Schedules of many loans (CSV)"};
+  const QString kind = QInputDialog::getItem(this, "Finance", "Function:",
+                                             kinds, 0, false, &ok);
+  if (!ok)
+    return;
+  const int op = kinds.indexOf(kind);
+
+  if (op <= 1) {
+    const QString text = QInputDialog::getMultiLineText(
+        this, "Finance",
+        "Cash flows, first at time 0 (amounts, or one \"YYYY-MM-DD amount\" "
+        "per line):",
+        "-1000\n300\n400\n500", &ok);
+    if (!ok)
+      return;
+    const QByteArray bytes = text.toUtf8();
+    const auto flows = finance::parseCashFlows(std::string_view(
+        bytes.constData(), static_cast<std::size_t>(bytes.size())));
+    if (!flows || flows->amounts.empty()) {
+      QMessageBox::warning(this, "Finance", "Expected a list of cash flows.");
+      return;
+    }
+    const bool dated = !flows->days.empty();
+    std::optional<long double> result;
+    QString label;
+    if (op == 0) {
+      const double rate = QInputDialog::getDouble(
+          this, "Finance",
+          dated ? "Annual discount rate (%):" : "Discount rate per period (%):",
+          5.0, -99.999, 1e6, 4, &ok);
+      if (!ok)
+        return;
+      result = dated ? Engine::xnpv(rate / 100.0L, flows->amounts, flows->days)
+                     : Engine::npv(rate / 100.0L, flows->amounts);
+      label = QString(dated ? "XNPV at %1%" : "NPV at %1%").arg(rate);
+    } else {
+      result = dated ? Engine::xirr(flows->amounts, flows->days)
+                     : Engine::irr(flows->amounts);
+      if (result)
+        result = *result * 100.0L;
+      label = dated ? "XIRR (%, annual)" : "IRR (% per period)";
+    }
+    if (!result) {
+      QMessageBox::warning(this, "Finance",
+                           op == 0 ? "The rate must be above -100%."
+                                   : "No rate found: the flows must change "
+                                     "sign.");
+      return;
+    }
+    const QString value = decimalText(*result);
+    if (symbolShower)
+      symbolShower->setText(value);
+    history_ << QString("%1 of %2 flows = %3")
+                    .arg(label)
+                    .arg(static_cast<qulonglong>(flows->amounts.size()))
+                    .arg(value);
+    QMessageBox::information(this, "Finance",
+                             QString("%1: %2").arg(label, value));
+    return;
+  }
+
+  if (op == 2) {
+    const QString text = QInputDialog::getText(
+        this, "Finance",
+        "Rate per period (%), periods, present value [, future value]:",
+        QLineEdit::Normal, "0.5 360 200000", &ok);
+    if (!ok)
+      return;
+    const QStringList parts =
+        text.split(QRegularExpression("[\\s,;]+"), Qt::SkipEmptyParts);
+    bool valid = parts.size() == 3 || parts.size() == 4;
+    long double args[4] = {0.0L, 0.0L, 0.0L, 0.0L};
+    for (int i = 0; valid && i < parts.size(); ++i) {
+      const auto v = parseDecimal(parts[i]);
+      valid = v.has_value();
+      args[i] = v.value_or(0.0L);
+    }
+    const auto payment =
+        valid ? Engine::pmt(args[0] / 100.0L, args[1], args[2], args[3])
+              : std::nullopt;
+    if (!payment) {
+      QMessageBox::warning(this, "Finance",
+                           "Expected a rate above -100%, a positive number "
+                           "of periods and the present value.");
+      return;
+    }
+    const QString value =
+        QString::number(static_cast<double>(*payment), 'f', 2);
+    if (symbolShower)
+      symbolShower->setText(value);
+    history_ << QString("PMT(%1) = %2").arg(parts.join(", "), value);
+    return;
+  }
+
+  if (op == 3) {
+    const QString text = QInputDialog::getText(
+        this, "Finance",
+        "Principal, annual rate (%), years [, payments per year]:",
+        QLineEdit::Normal, "200000 5 30 12", &ok);
+    if (!ok)
+      return;
+    const auto loan = parseLoanText(text);
+    if (!loan) {
+      QMessageBox::warning(this, "Finance", "Not a valid loan: " + text);
+      return;
+    }
+    showSchedule(*loan);
+    return;
+  }
+
+  const QString text = QInputDialog::getMultiLineText(
+      this, "Finance",
+      "One loan per line: principal, annual rate (%), years [, payments per "
+      "year]:",
+      "200000 5 30\n150000 4.5 15\n300000 6 40 12", &ok);
+  if (!ok)
+    return;
+  std::vector<finance::Loan> loans;
+  for (const QString &line : text.split('\n', Qt::SkipEmptyParts)) {
+    if (line.trimmed().isEmpty())
+      continue;
+    const auto loan = parseLoanText(line);
+    if (!loan) {
+      QMessageBox::warning(this, "Finance", "Not a valid loan: " + line);
+      return;
+    }
+    loans.push_back(*loan);
+  }
+  if (!loans.empty())
+    exportSchedules(std::move(loans));
+}
+
+/// @brief Open a non-modal window with the loan's schedule.
+void UICalculator::showSchedule(const finance::Loan &loan) {
+  const double payment = *finance::payment(loan);
+  auto *dialog = new QDialog(this);
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  dialog->setWindowTitle("Amortization schedule");
+  auto *layout = new QVBoxLayout(dialog);
+  layout->addWidget(new QLabel(
+      QString("%1 payments of %2, total interest %3")
+          .arg(static_cast<qulonglong>(loan.periods))
+          .arg(QString::number(payment, 'f', 2),
+               QString::number(payment * static_cast<double>(loan.periods) -
+                                   loan.principal,
+                               'f', 2)),
+      dialog));
+  auto *table = new QTableView(dialog);
+  table->setModel(new ScheduleModel(loan, table));
+  // Fixed row heights: the view never measures rows it does not show.
+  table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+  table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+  layout->addWidget(table);
+  auto *save = new QPushButton("Save as CSV...", dialog);
+  connect(save, &QPushButton::clicked, this,
+          [this, loan] { exportSchedules({loan}); });
+  layout->addWidget(save);
+  dialog->resize(560, 480);
+  dialog->show();
+  history_ << QString("Schedule: %1 payments of %2")
+                  .arg(static_cast<qulonglong>(loan.periods))
+                  .arg(QString::number(payment, 'f', 2));
+}
+
+/// @brief Write schedules to a CSV file chosen by the user, off the GUI
+/// thread; finance::writeSchedules formats straight into a byte buffer.
+void UICalculator::exportSchedules(std::vector<finance::Loan> loans) {
+  const QString path = QFileDialog::getSaveFileName(
+      this, "Save schedules", "schedule.csv", "CSV files (*.csv)");
+  if (path.isEmpty())
+    return;
+  auto task = std::make_shared<Task>();
+  for (const finance::Loan &loan : loans)
+    task->total += loan.periods;
+  const std::uint64_t rows = task->total;
+  auto written = std::make_shared<bool>(false);
+  const auto start = std::chrono::steady_clock::now();
+  runTask(
+      "Finance",
+      QString("Writing %1 rows...").arg(static_cast<qulonglong>(rows)), task,
+      [loans = std::move(loans), path, task, written] {
+        std::FILE *file =
+            std::fopen(QFile::encodeName(path).constData(), "wb");
+        if (!file)
+          return;
+        const bool ok =
+            finance::writeSchedules(loans, file, &task->cancel, &task->done);
+        *written = std::fclose(file) == 0 && ok;
+      },
+      [this, task, written, path, rows, start] {
+        const double seconds = std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+        if (task->cancel) {
+          QFile::remove(path); // only part of the rows made it
+          history_ << QString("Schedules -> %1: cancelled").arg(path);
+          return;
+        }
+        if (!*written) {
+          QMessageBox::warning(this, "Finance", "Cannot write " + path);
+          return;
+        }
+        history_ << QString("Schedules: %1 rows -> %2")
+                        .arg(static_cast<qulonglong>(rows))
+                        .arg(path);
+        QMessageBox::information(this, "Finance",
+                                 QString("%1 rows written to %2 in %3 s.")
+                                     .arg(static_cast<qulonglong>(rows))
+                                     .arg(path)
+                                     .arg(seconds, 0, 'f', 2));
+      });
+}
+
+/// @brief Prompt for a rectangular or polar complex number and show it as the
+/// current entry.
+void UICalculator::onComplexEntryPressed() {
+  bool ok = false;
+  const QString text = QInputDialog::getText(
+      this, "Complex", "a+bi, or polar r∠θ / r@θ (θ in degrees):",
+      QLineEdit::Normal, "0+1i", &ok);
+  if (!ok || !symbolShower)
+    return;
+  const auto z = parseComplexText(text);
+  if (!z) {
+    QMessageBox::warning(this, "Complex", "Not a complex number: " + text);
+    return;
+  }
+  // Shown in rectangular form; the next operator/equals commits it.
+  symbolShower->setText(resultText(*z, std::nullopt));
+}
+
+/// @brief Replace the displayed value by sqrt, exp or ln of it.
+/// @param which 0: sqrt, 1: exp, 2: ln.
+void UICalculator::onComplexFunctionPressed(int which) {
+  if (!symbolShower)
+    return;
+  const auto z = parseComplexText(symbolShower->text());
+  if (!z) {
+    symbolShower->setText("Error");
+    return;
+  }
+  const auto r = which == 0   ? Engine::complexSqrt(*z)
+                 : which == 1 ? Engine::complexExp(*z)
+                              : Engine::complexLog(*z);
+  static const char *const names[] = {"sqrt", "exp", "ln"};
+  const QString before = symbolShower->text();
+  // The result stays the current entry, like a freshly typed number.
+  symbolShower->setText(r ? resultText(*r, std::nullopt) : QString("Error"));
+  history_ << QString("%1(%2) -> %3")
+                  .arg(names[which], before, symbolShower->text());
+}
+
 /// @brief Clear display and full calculation state (UI + Engine).
 void UICalculator::onClearPressed() {
   qDebug() << "[UICalculator] ENTER onClearPressed()";
@@ -551,6 +2317,12 @@ void UICalculator::onClearPressed() {
     symbolShower->setText("0");
   value1_ = 0.0L;
   value2_ = 0.0L;
+  exact1_.reset();
+  imag1_ = 0.0L;
+  frac1_.reset();
+  exact2_.reset();
+  imag2_ = 0.0L;
+  frac2_.reset();
   enteringFirst_ = true;
   if (engine_)
     engine_->clear(); // <- important: erases operators and flags!.
@@ -567,8 +2339,14 @@ void UICalculator::onClearEntryPressed() {
   // operand and it wasn't yet committed, reset value1_ scratch.
   if (!enteringFirst_) {
     value2_ = 0.0L;
+    exact2_.reset();
+    imag2_ = 0.0L;
+    frac2_.reset();
   } else {
     // Do not touch engine_ state; previous committed v1 (if any) stays.
     value1_ = 0.0L;
+    exact1_.reset();
+    imag1_ = 0.0L;
+    frac1_.reset();
   }
 }
\ No newline at end of file
@@ -11,16 +11,31 @@
  */
 #pragma once
 
+#include "bigint.h"
+#include "checked_int.h"
+#include "constants.h"
+#include "finance.h"
+#include "montecarlo.h"
+#include "rational.h"
 #include <QString>
 #include <QStringList>
 #include <QWidget>
+#include <complex>
+#include <functional>
+#include <memory>
+#include <vector>
 
 // Lightweight forward declarations to keep the header minimal
 class QGridLayout;
 class QLineEdit;
 class QPushButton;
 class QKeyEvent;
+class QDragEnterEvent;
+class QDropEvent;
+class QProgressDialog;
+class QThread;
 class Engine;
+class UIPlotter;
 
 /**
  * @class UICalculator
@@ -51,8 +66,8 @@ public:
    * @param parent Optional QWidget parent.
    */
   explicit UICalculator(QWidget *parent = nullptr);
-  /// Default destructor.
-  ~UICalculator() = default;
+  /// Cancel and wait for running background jobs.
+  ~UICalculator() override;
 
 protected:
   /**
@@ -65,7 +80,18 @@ protected:
    */
   void keyPressEvent(QKeyEvent *event) override;
 
+  /** @brief Accept dragged text or local files. */
+  void dragEnterEvent(QDragEnterEvent *event) override;
+
+  /** @brief Ingest the dropped file (first local URL) or text. */
+  void dropEvent(QDropEvent *event) override;
+
 private:
+  /// State shared between the GUI and the ingestion worker (UICalculator.cpp).
+  struct IngestJob;
+  /// Progress and cancellation of a background task (UICalculator.cpp).
+  struct Task;
+
   // ======================= Helpers (construction / interaction)
   // =======================
   /**
@@ -89,6 +115,42 @@ private:
    */
   void commitCurrentNumber();
 
+  /**
+   * @brief Push the UI operand into the engine, keeping its exact integer
+   *        (exact1_/exact2_) or imaginary part (imag1_/imag2_) when known.
+   * @param first true for value1_, false for value2_.
+   */
+  void syncOperand(bool first);
+
+  /**
+   * @brief Evaluate via the engine, preferring exact fractions (fraction
+   *        mode) or the exact integer path and falling back to complex
+   *        evaluation.
+   * @param exact Receives the exact integer result when available.
+   * @param fraction Receives the exact fraction result in fraction mode.
+   * @param big Receives the exact integer result when it overflows
+   *        @p exact (the returned value is then its rounding).
+   * @return Result (imaginary part 0 for real results) or std::nullopt on
+   *         error.
+   */
+  std::optional<std::complex<long double>>
+  evaluateEngine(std::optional<checked::Int> &exact,
+                 std::optional<Rational> &fraction,
+                 std::optional<BigInt> &big);
+
+  /**
+   * @brief Display text for a result; exact integers keep every digit.
+   * @param r Result value (shown as a+bi when it has an imaginary part).
+   * @param exact Exact integer result, if any.
+   * @param fraction Exact fraction result, if any (shown as "n/d").
+   * @param big Exact integer result beyond checked::Int, if any.
+   * @return Text for symbolShower.
+   */
+  QString resultText(const std::complex<long double> &r,
+                     const std::optional<checked::Int> &exact,
+                     const std::optional<Rational> &fraction = std::nullopt,
+                     const std::optional<BigInt> &big = std::nullopt) const;
+
   /**
    * @brief Append a digit to the display text, handling the initial "0" case.
    * @param d Digit (0–9) to append.
@@ -97,9 +159,9 @@ private:
 
   /**
    * @brief Handler for binary operator click/key.
-   * @param opCode Operator code: 0:+, 1:−, 2:×, 3:÷.
+   * @param opCode Operator code: 0:+, 1:−, 2:×, 3:÷, 4:GCD, 5:LCM.
    */
-  void onOperatorPressed(int opCode); // 0:+ 1:- 2:* 3:/
+  void onOperatorPressed(int opCode); // 0:+ 1:- 2:* 3:/ 4:gcd 5:lcm
 
   /**
    * @brief Handler for equals (=) button/key. Evaluates via Engine and shows
@@ -120,6 +182,173 @@ private:
    */
   void onConvertPressed();
 
+  /**
+   * @brief Handler for the Monte Carlo mode. Prompts for an expression, a
+   *        distribution and a sample count, runs montecarlo::simulate and
+   *        shows the mean, confidence interval and a text histogram.
+   */
+  void onSimulatePressed();
+
+  /**
+   * @brief Show the statistics of a finished Monte Carlo run.
+   * @param cancelled The run was cancelled (only the history notes it).
+   * @param res Result, or std::nullopt for invalid parameters.
+   * @param options Options of the run.
+   * @param text Expression as typed.
+   * @param dist Distribution name.
+   */
+  void showSimulation(bool cancelled,
+                      const std::optional<montecarlo::Result> &res,
+                      const montecarlo::Options &options, const QString &text,
+                      const QString &dist);
+
+  /**
+   * @brief Handler for the number-theory "Factor" mode. Shows whether the
+   *        displayed integer is prime and its prime factorization.
+   */
+  void onFactorPressed();
+
+  /**
+   * @brief Handler for the "Modular" mode. Prompts for a, e and m and shows
+   *        a^e mod m and the inverse of a modulo m.
+   */
+  void onModularPressed();
+
+  /**
+   * @brief Handler for the "Combinatorics" mode. Prompts for n!, nCr, nPr,
+   *        Catalan or multinomial and shows the exact result (abbreviated
+   *        to its leading and trailing digits when very long).
+   */
+  void onCombinatoricsPressed();
+
+  /**
+   * @brief Handler for the "Constants" mode. Computes pi, e, sqrt(2) or
+   *        ln(2) to the requested number of digits (or reads them from the
+   *        disk cache) on a background thread that can be cancelled; see
+   *        showConstant().
+   */
+  void onConstantsPressed();
+
+  /**
+   * @brief Show a finished constant computation.
+   * @param cancelled The computation was cancelled (only the history notes
+   *        it).
+   * @param r Digits, or std::nullopt for an unsupported digit count.
+   * @param kind Constant as listed in the dialog.
+   * @param digits Requested digit count.
+   */
+  void showConstant(bool cancelled, const std::optional<constants::Result> &r,
+                    const QString &kind, int digits);
+
+  /**
+   * @brief Handler for the "Calculus" mode. Prompts for an expression in x
+   *        and either integration limits (adaptive Gauss–Kronrod) or a point
+   *        (Richardson-extrapolated derivative), shows the estimate with its
+   *        error and leaves it on the display.
+   */
+  void onCalculusPressed();
+
+  /**
+   * @brief Handler for the "Units" mode. Prompts for a source and target
+   *        unit ("km mi", "degC degF", "kWh J") and converts the value on
+   *        the display.
+   */
+  void onUnitsPressed();
+
+  /**
+   * @brief Handler for the "Solve" mode. Finds all roots of a polynomial
+   *        (Aberth–Ehrlich) or one root of f(x) = 0 from a guess or bracket
+   *        (Newton/Brent), and lists each root with its error bound.
+   */
+  void onSolvePressed();
+
+  /**
+   * @brief Handler for the "FFT" mode. Reads a series (pasted or from a
+   *        file), computes its forward FFT, power spectrum, or
+   *        convolution/correlation with a second series, or the inverse FFT
+   *        of "re im" pairs as the forward FFT writes them; shows the first
+   *        values with the timing and copies the full result to the
+   *        clipboard.
+   */
+  void onFftPressed();
+
+  /**
+   * @brief Handler for the "Symbolic" mode. Simplifies or differentiates an
+   *        expression in x, y, z on a shared-subexpression DAG, shows the
+   *        result and its size, and optionally evaluates it at a point.
+   */
+  void onSymbolicPressed();
+
+  /**
+   * @brief Handler for the "Finance" mode: NPV/XNPV, IRR/XIRR and PMT of
+   *        entered cash flows, an amortization schedule in a table view, or
+   *        the schedules of many loans written to a CSV file.
+   */
+  void onFinancePressed();
+
+  /**
+   * @brief Show a loan's schedule in a table whose rows are computed only
+   *        when scrolled into view, with a button to save it as CSV.
+   */
+  void showSchedule(const finance::Loan &loan);
+
+  /**
+   * @brief Ask for a file and write the schedules of @p loans to it on a
+   *        background thread, behind a cancellable progress dialog.
+   */
+  void exportSchedules(std::vector<finance::Loan> loans);
+
+  /**
+   * @brief Ingest pasted or dropped text on a background thread: a number
+   *        goes to the display, a list of numbers is summed by the engine
+   *        and summarized, anything else is evaluated as an expression.
+   */
+  void ingestText(const QString &text);
+
+  /** @brief Same as ingestText(), reading a file in chunks. */
+  void ingestFile(const QString &path);
+
+  /**
+   * @brief Run an ingestion job on a worker thread, showing a cancellable
+   *        progress dialog polled by a timer so the GUI thread never waits.
+   * @param job Shared state; its reader is executed on the worker.
+   * @param total Input size in bytes (progress range).
+   * @param source Short description for the history and messages.
+   */
+  void startIngest(std::shared_ptr<IngestJob> job, qint64 total,
+                   const QString &source);
+
+  /** @brief Show the outcome of a finished ingestion job. */
+  void showIngestResult(const IngestJob &job, const QString &source);
+
+  /**
+   * @brief Run a long computation on a worker thread behind a cancellable
+   *        progress dialog polled by a timer, like startIngest(). One task
+   *        runs at a time.
+   * @param title Dialog title (also used for the "busy" message).
+   * @param label Text of the progress dialog.
+   * @param task Shared progress/cancel state, read by @p work.
+   * @param work Runs on the worker; must poll task->cancel.
+   * @param finished Runs on the GUI thread once @p work returns.
+   * @return false (and nothing runs) if another task is still running.
+   */
+  bool runTask(const QString &title, const QString &label,
+               std::shared_ptr<Task> task, std::function<void()> work,
+               std::function<void()> finished);
+
+  /**
+   * @brief Handler for "Complex > Enter...". Accepts rectangular (a+bi) or
+   *        polar (r∠θ or r@θ, θ in degrees) input and places the value on
+   *        the display as the current entry.
+   */
+  void onComplexEntryPressed();
+
+  /**
+   * @brief Apply a complex function to the displayed value.
+   * @param which 0: sqrt, 1: exp, 2: ln.
+   */
+  void onComplexFunctionPressed(int which);
+
   /**
    * @brief Clear display and internal state (operands, operator, input mode).
    */
@@ -158,6 +387,12 @@ private:
   QPushButton *btnMul = nullptr;     ///< Multiplication (×).
   QPushButton *btnDiv = nullptr;     ///< Division (÷).
   QPushButton *btnConvert = nullptr; ///< Button to trigger conversions.
+  QPushButton *btnModes = nullptr;   ///< Menu button for extra modes.
+  UIPlotter *plotter_ = nullptr; ///< Plot panel beside the keypad (hidden).
+  QThread *ingestWorker_ = nullptr;     ///< Running ingestion job, if any.
+  std::shared_ptr<IngestJob> ingestJob_; ///< State of that job.
+  QThread *taskWorker_ = nullptr;        ///< Running runTask() work, if any.
+  std::shared_ptr<Task> task_;           ///< State of that task.
 
   /// Array of digit buttons (0..9). Entries may be null until created.
   QPushButton *digitButtons[10] = {nullptr};
@@ -165,6 +400,13 @@ private:
   // =============================== Input state ===============================
   long double value1_ = 0.0L; ///< First accumulated operand.
   long double value2_ = 0.0L; ///< Second accumulated operand.
+  std::optional<checked::Int> exact1_; ///< value1_ as an exact integer.
+  std::optional<checked::Int> exact2_; ///< value2_ as an exact integer.
+  long double imag1_ = 0.0L; ///< Imaginary part of the first operand.
+  long double imag2_ = 0.0L; ///< Imaginary part of the second operand.
+  std::optional<Rational> frac1_; ///< value1_ as an exact fraction.
+  std::optional<Rational> frac2_; ///< value2_ as an exact fraction.
+  bool fractionMode_ = false;     ///< Whether results are kept as fractions.
   bool enteringFirst_ =
       true;                  ///< true while filling value1_, false for value2_.
   Engine *engine_ = nullptr; ///< Calculation engine managed by the UI.
@@ -0,0 +1,238 @@
+/**
+ * @file UIPlotter.cpp
+ * @brief Implementation of the UIPlotter class (function plot panel).
+ *
+ * Samples are produced on a QThread and swapped in when ready; only one job
+ * runs at a time and a request made while busy is re-issued when the job
+ * finishes. The sampled domain extends one view width to each side so short
+ * pans never need new samples.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "UIPlotter.h"
+#include "expression.h"
+#include "plotsampler.h"
+#include <QMouseEvent>
+#include <QPainter>
+#include <QThread>
+#include <QWheelEvent>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QVBoxLayout>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/// Samples per pixel column requested from PlotSampler before refinement.
+constexpr int kSamplesPerPixel = 64;
+} // namespace
+
+/// @brief Build the input box, status line and empty plot area.
+/// @param parent Parent widget.
+UIPlotter::UIPlotter(QWidget *parent) : QWidget(parent) {
+  exprEdit_ = new QLineEdit();
+  exprEdit_->setObjectName("plotExpression");
+  exprEdit_->setPlaceholderText("f(x), e.g. sin(x)/x");
+  status_ = new QLabel();
+
+  QVBoxLayout *layout = new QVBoxLayout();
+  layout->setContentsMargins(0, 0, 0, 0);
+  layout->addWidget(exprEdit_);
+  layout->addWidget(status_);
+  layout->addStretch(1);
+  setLayout(layout);
+  setMinimumSize(320, 240);
+
+  connect(exprEdit_, &QLineEdit::returnPressed, this,
+          [this] { onExpressionEntered(); });
+}
+
+/// @brief Wait for an in-flight sampling job so it never outlives the widget.
+UIPlotter::~UIPlotter() {
+  if (worker_) {
+    worker_->wait();
+    delete worker_; // its deleteLater() would never run now
+  }
+}
+
+/// @brief Compile the typed expression and sample it around the view.
+void UIPlotter::onExpressionEntered() {
+  std::string error;
+  auto compiled =
+      Expression::compile(exprEdit_->text().toStdString(), {"x"}, &error);
+  if (!compiled) {
+    status_->setText(QString::fromStdString(error));
+    return;
+  }
+  expr_ = std::make_shared<const Expression>(std::move(*compiled));
+  requestSamples(true);
+}
+
+/// @brief Sample the view (plus one width per side) in the background.
+/// @param force Ignore the coverage check.
+void UIPlotter::requestSamples(bool force) {
+  if (!expr_)
+    return;
+  const double span = viewX1_ - viewX0_;
+  const double pixelWidth = span / std::max(1, width());
+  if (!force && sampler_ && sampler_->domainMin() <= viewX0_ &&
+      sampler_->domainMax() >= viewX1_ &&
+      sampler_->spacing() <= pixelWidth)
+    return;
+  if (worker_) {
+    pending_ = true;
+    pendingForce_ = pendingForce_ || force;
+    return;
+  }
+
+  const double x0 = viewX0_ - span, x1 = viewX1_ + span;
+  PlotSampler::Options options;
+  options.baseSamples =
+      static_cast<std::size_t>(3 * std::max(1, width()) * kSamplesPerPixel);
+  auto expr = expr_;
+  auto result = std::make_shared<PlotSampler>();
+  worker_ = QThread::create([expr, result, x0, x1, options] {
+    result->sample(*expr, x0, x1, options);
+  });
+  connect(worker_, &QThread::finished, this, [this, result, expr] {
+    worker_->deleteLater();
+    worker_ = nullptr;
+    const bool replaced = expr != expr_;
+    if (!replaced) { // drop results for a replaced expression
+      sampler_ = result;
+      status_->setText(QString("%1 samples").arg(result->size()));
+      update();
+    }
+    // The displayed samples belong to the old expression, so a replaced one
+    // must be sampled even if they cover the view.
+    if (pending_ || replaced) {
+      const bool force = pendingForce_ || replaced;
+      pending_ = false;
+      pendingForce_ = false;
+      requestSamples(force);
+    }
+  });
+  status_->setText("Sampling...");
+  worker_->start();
+}
+
+/// @brief Top edge of the drawing area.
+/// @return Pixel row just below the status line.
+int UIPlotter::plotTop() const { return status_->geometry().bottom() + 4; }
+
+/// @brief Paint axes and the curve as per-pixel min/max spans.
+/// @param event Unused.
+void UIPlotter::paintEvent(QPaintEvent *event) {
+  QWidget::paintEvent(event);
+  QPainter p(this);
+  const int top = plotTop();
+  const int w = width();
+  const int h = height() - top;
+  if (w <= 0 || h <= 0)
+    return;
+  p.fillRect(0, top, w, h, palette().base());
+  if (!sampler_)
+    return;
+
+  const auto cols = sampler_->decimate(viewX0_, viewX1_,
+                                       static_cast<std::size_t>(w));
+  // Fit y to what is visible, with a small margin.
+  double lo = 0.0, hi = 0.0;
+  bool any = false;
+  for (const auto &c : cols) {
+    if (!c.valid)
+      continue;
+    lo = any ? std::min(lo, c.yMin) : c.yMin;
+    hi = any ? std::max(hi, c.yMax) : c.yMax;
+    any = true;
+  }
+  if (!any)
+    return;
+  if (hi - lo < 1e-12) {
+    lo -= 1.0;
+    hi += 1.0;
+  }
+  const double margin = 0.05 * (hi - lo);
+  lo -= margin;
+  hi += margin;
+  auto toY = [&](double y) {
+    return top + static_cast<int>(std::lround((hi - y) / (hi - lo) * h));
+  };
+
+  // Axes through the origin when visible.
+  p.setPen(palette().mid().color());
+  if (lo < 0.0 && hi > 0.0)
+    p.drawLine(0, toY(0.0), w, toY(0.0));
+  if (viewX0_ < 0.0 && viewX1_ > 0.0) {
+    const int x0 = static_cast<int>(-viewX0_ / (viewX1_ - viewX0_) * w);
+    p.drawLine(x0, top, x0, top + h);
+  }
+
+  // One vertical span per column, stretched to meet the previous column so
+  // the curve stays connected.
+  p.setPen(palette().text().color());
+  for (int x = 0; x < w; ++x) {
+    const auto &c = cols[static_cast<std::size_t>(x)];
+    if (!c.valid)
+      continue;
+    double a = c.yMin, b = c.yMax;
+    if (x > 0 && cols[static_cast<std::size_t>(x - 1)].valid) {
+      const auto &prev = cols[static_cast<std::size_t>(x - 1)];
+      a = std::min(a, prev.yMax);
+      b = std::max(b, prev.yMin);
+    }
+    p.drawLine(x, toY(b), x, toY(a));
+  }
+}
+
+/// @brief Begin panning.
+/// @param event Mouse event.
+void UIPlotter::mousePressEvent(QMouseEvent *event) {
+  dragging_ = true;
+  dragX_ = static_cast<int>(event->position().x());
+}
+
+/// @brief Pan by the mouse delta (repaint only).
+/// @param event Mouse event.
+void UIPlotter::mouseMoveEvent(QMouseEvent *event) {
+  if (!dragging_)
+    return;
+  const int x = static_cast<int>(event->position().x());
+  const double shift =
+      (dragX_ - x) * (viewX1_ - viewX0_) / std::max(1, width());
+  viewX0_ += shift;
+  viewX1_ += shift;
+  dragX_ = x;
+  update();
+}
+
+/// @brief End panning and fetch samples if the view left the domain.
+/// @param event Mouse event.
+void UIPlotter::mouseReleaseEvent(QMouseEvent *event) {
+  Q_UNUSED(event);
+  dragging_ = false;
+  requestSamples();
+}
+
+/// @brief Zoom by 1.2x per wheel notch around the cursor.
+/// @param event Wheel event.
+void UIPlotter::wheelEvent(QWheelEvent *event) {
+  const double notches = event->angleDelta().y() / 120.0;
+  const double factor = std::pow(1.2, -notches);
+  const double anchor =
+      viewX0_ + (viewX1_ - viewX0_) * event->position().x() /
+                    std::max(1, width());
+  viewX0_ = anchor + (viewX0_ - anchor) * factor;
+  viewX1_ = anchor + (viewX1_ - anchor) * factor;
+  update();
+  requestSamples();
+}
+
+/// @brief Re-check resolution after a resize.
+/// @param event Resize event.
+void UIPlotter::resizeEvent(QResizeEvent *event) {
+  QWidget::resizeEvent(event);
+  requestSamples();
+}
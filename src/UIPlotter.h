@@ -0,0 +1,88 @@
+/**
+ * @file UIPlotter.h
+ * @brief Declaration of the UIPlotter class (function plot panel).
+ *
+ * UIPlotter shows y = f(x) for an expression typed by the user. Sampling is
+ * done by PlotSampler on a worker thread; painting only asks the sampler for
+ * one min/max pair per pixel column, so pan (drag) and zoom (wheel) stay
+ * smooth regardless of how many points back the curve.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#pragma once
+
+#include <QWidget>
+#include <memory>
+
+class QLineEdit;
+class QLabel;
+class QThread;
+class PlotSampler;
+class Expression;
+
+/**
+ * @class UIPlotter
+ * @brief Plot panel placed next to the keypad.
+ *
+ * ### Responsibilities
+ * - Compile the expression typed in its input box.
+ * - Keep a sampled copy of the curve covering (and extending past) the view,
+ *   re-sampling in the background when the view leaves it or zooms past its
+ *   resolution.
+ * - Paint the decimated curve and handle pan/zoom.
+ */
+class UIPlotter : public QWidget {
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Construct the plot panel.
+   * @param parent Optional QWidget parent.
+   */
+  explicit UIPlotter(QWidget *parent = nullptr);
+  /// Waits for a running sampling job before destruction.
+  ~UIPlotter() override;
+
+protected:
+  /** @brief Draw axes and the decimated curve. */
+  void paintEvent(QPaintEvent *event) override;
+  /** @brief Start a pan. */
+  void mousePressEvent(QMouseEvent *event) override;
+  /** @brief Continue a pan. */
+  void mouseMoveEvent(QMouseEvent *event) override;
+  /** @brief Finish a pan (may trigger re-sampling). */
+  void mouseReleaseEvent(QMouseEvent *event) override;
+  /** @brief Zoom around the cursor. */
+  void wheelEvent(QWheelEvent *event) override;
+  /** @brief Re-check sampling resolution for the new width. */
+  void resizeEvent(QResizeEvent *event) override;
+
+private:
+  /** @brief Compile the input box text and sample it for the current view. */
+  void onExpressionEntered();
+
+  /**
+   * @brief Start a background sampling job if the view is not covered by
+   *        the current samples at pixel resolution.
+   * @param force Re-sample even if the current samples are adequate.
+   */
+  void requestSamples(bool force = false);
+
+  /** @brief Top of the plot area (below the input box). */
+  int plotTop() const;
+
+  QLineEdit *exprEdit_ = nullptr; ///< Expression input, e.g. "sin(x)/x".
+  QLabel *status_ = nullptr;      ///< Sample count / error line.
+
+  std::shared_ptr<const PlotSampler> sampler_; ///< Samples being displayed.
+  std::shared_ptr<const Expression> expr_;     ///< Current expression.
+  QThread *worker_ = nullptr; ///< Running sampling job, if any.
+  bool pending_ = false;      ///< A re-sample was requested while busy.
+  bool pendingForce_ = false; ///< That request ignores the coverage check.
+
+  double viewX0_ = -10.0; ///< Left edge of the view.
+  double viewX1_ = 10.0;  ///< Right edge of the view.
+  int dragX_ = 0;         ///< Last mouse x while panning.
+  bool dragging_ = false; ///< Whether a pan is in progress.
+};
@@ -0,0 +1,541 @@
+/**
+ * @file baseconv.cpp
+ * @brief Implementation of the streaming base converter and its kernels.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "baseconv.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BASECONV_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace baseconv {
+namespace {
+
+/// Bytes per output line of a byte dump (hex uses 32, the others 16).
+constexpr std::size_t kHexLineBytes = 32;
+constexpr std::size_t kLineBytes = 16;
+
+/// Lookup tables shared by the scalar paths.
+struct Tables {
+  std::int8_t digit[256];   ///< Digit value of a character (-1 if none).
+  std::uint8_t reverse[256]; ///< Bit-reversed byte.
+  char dec[256][4];          ///< Decimal token: length, then digits.
+  char oct[256][4];          ///< Octal token: length, then digits.
+};
+
+constexpr Tables makeTables() {
+  Tables t{};
+  for (int c = 0; c < 256; ++c) {
+    t.digit[c] = c >= '0' && c <= '9'   ? static_cast<std::int8_t>(c - '0')
+                 : c >= 'A' && c <= 'F' ? static_cast<std::int8_t>(c - 'A' + 10)
+                 : c >= 'a' && c <= 'f' ? static_cast<std::int8_t>(c - 'a' + 10)
+                                        : -1;
+    int r = 0;
+    for (int b = 0; b < 8; ++b)
+      r |= ((c >> b) & 1) << (7 - b);
+    t.reverse[c] = static_cast<std::uint8_t>(r);
+
+    char tmp[3] = {0, 0, 0};
+    int n = 0;
+    for (int v = c; n == 0 || v > 0; v /= 10)
+      tmp[n++] = static_cast<char>('0' + v % 10);
+    t.dec[c][0] = static_cast<char>(n);
+    for (int i = 0; i < n; ++i)
+      t.dec[c][1 + i] = tmp[n - 1 - i];
+    n = 0;
+    for (int v = c; n == 0 || v > 0; v /= 8)
+      tmp[n++] = static_cast<char>('0' + v % 8);
+    t.oct[c][0] = static_cast<char>(n);
+    for (int i = 0; i < n; ++i)
+      t.oct[c][1 + i] = tmp[n - 1 - i];
+  }
+  return t;
+}
+
+constexpr Tables kTables = makeTables();
+
+inline bool isSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' ||
+         c == '\f';
+}
+
+inline std::uint8_t u8(char c) { return static_cast<std::uint8_t>(c); }
+
+int radix(Format f) {
+  switch (f) {
+  case Format::Hex:
+    return 16;
+  case Format::Oct:
+    return 8;
+  case Format::Bin:
+    return 2;
+  default:
+    return 10;
+  }
+}
+
+/// Output of one chunk (or the reason it failed).
+struct ChunkResult {
+  std::string out;
+  const char *error = nullptr; ///< Failure description, nullptr on success.
+  std::size_t errorAt = 0;     ///< Offset of the failing token in the input.
+};
+
+/// Raw bytes -> text dump.
+void encodeChunk(const std::uint8_t *in, std::size_t n, Format to,
+                 std::string &out) {
+  if (to == Format::Hex || to == Format::Bin) {
+    const std::size_t line = to == Format::Hex ? kHexLineBytes : kLineBytes;
+    const std::size_t width = to == Format::Hex ? 2 : 8;
+    out.resize(n * width + (n + line - 1) / line);
+    char *p = &out[0];
+    for (std::size_t i = 0; i < n; i += line) {
+      const std::size_t k = std::min(line, n - i);
+      if (to == Format::Hex)
+        encodeHex(in + i, k, p);
+      else
+        encodeBin(in + i, k, p);
+      p += k * width;
+      *p++ = '\n';
+    }
+    return;
+  }
+  const auto &table = to == Format::Dec ? kTables.dec : kTables.oct;
+  out.resize(n * 4);
+  char *p = &out[0];
+  for (std::size_t i = 0; i < n; ++i) {
+    const char *tok = table[in[i]];
+    for (int d = 1; d <= tok[0]; ++d)
+      *p++ = tok[d];
+    *p++ = (i + 1) % kLineBytes == 0 || i + 1 == n ? '\n' : ' ';
+  }
+  out.resize(static_cast<std::size_t>(p - out.data()));
+}
+
+/// Text dump -> raw bytes.
+void decodeChunk(const char *in, std::size_t n, std::size_t base, Format from,
+                 ChunkResult &res) {
+  res.out.resize(n); // every byte needs at least one input character
+  std::uint8_t *out = reinterpret_cast<std::uint8_t *>(&res.out[0]);
+  std::size_t o = 0;
+  const int r = radix(from);
+  for (std::size_t i = 0; i < n;) {
+    if (isSpace(in[i])) {
+      ++i;
+      continue;
+    }
+    std::size_t e = i;
+    while (e < n && !isSpace(in[e]))
+      ++e;
+    const std::size_t len = e - i;
+    bool ok = true;
+    if (from == Format::Hex) {
+      ok = len % 2 == 0 && decodeHex(in + i, len / 2, out + o);
+      o += len / 2;
+    } else if (from == Format::Bin) {
+      ok = len % 8 == 0 && decodeBin(in + i, len / 8, out + o);
+      o += len / 8;
+    } else {
+      unsigned v = 0;
+      ok = len <= 3;
+      for (std::size_t k = i; ok && k < e; ++k) {
+        const int d = kTables.digit[u8(in[k])];
+        ok = d >= 0 && d < r;
+        v = v * static_cast<unsigned>(r) + static_cast<unsigned>(d);
+      }
+      ok = ok && v <= 255;
+      out[o++] = static_cast<std::uint8_t>(v);
+    }
+    if (!ok) {
+      res.error = "invalid byte token";
+      res.errorAt = base + i;
+      return;
+    }
+    i = e;
+  }
+  res.out.resize(o);
+}
+
+/// Append @p v in base @p r (2, 8, 10 or 16).
+void appendNumber(std::string &out, bool neg, std::uint64_t v, int r) {
+  char buf[66];
+  char *p = buf + sizeof(buf);
+  if (r == 10) {
+    do {
+      *--p = static_cast<char>('0' + v % 10);
+      v /= 10;
+    } while (v);
+  } else {
+    const int shift = r == 16 ? 4 : r == 8 ? 3 : 1;
+    const std::uint64_t mask = static_cast<std::uint64_t>(r - 1);
+    do {
+      *--p = "0123456789ABCDEF"[v & mask];
+      v >>= shift;
+    } while (v);
+  }
+  if (neg)
+    *--p = '-';
+  out.append(p, static_cast<std::size_t>(buf + sizeof(buf) - p));
+  out.push_back('\n');
+}
+
+/// Text integers in one base -> text integers in another.
+void rebaseChunk(const char *in, std::size_t n, std::size_t base, Format from,
+                 Format to, ChunkResult &res) {
+  res.out.reserve(n + n / 2);
+  const int rin = radix(from);
+  const int rout = radix(to);
+  const std::uint64_t limit = UINT64_MAX / static_cast<std::uint64_t>(rin);
+  for (std::size_t i = 0; i < n;) {
+    if (isSpace(in[i])) {
+      ++i;
+      continue;
+    }
+    const std::size_t start = i;
+    const bool neg = in[i] == '-';
+    if (neg)
+      ++i;
+    bool ok = i < n && !isSpace(in[i]);
+    std::uint64_t v = 0;
+    for (; i < n && !isSpace(in[i]); ++i) {
+      const int d = kTables.digit[u8(in[i])];
+      if (d < 0 || d >= rin || v > limit ||
+          v * rin > UINT64_MAX - static_cast<std::uint64_t>(d)) {
+        ok = false;
+        break;
+      }
+      v = v * static_cast<std::uint64_t>(rin) + static_cast<std::uint64_t>(d);
+    }
+    if (!ok) {
+      res.error = "invalid or out-of-range number";
+      res.errorAt = base + start;
+      return;
+    }
+    appendNumber(res.out, neg && v != 0, v, rout);
+  }
+}
+
+/// Split the input into [begin, end) chunks on line/token boundaries.
+std::vector<std::pair<std::size_t, std::size_t>>
+splitChunks(const char *data, std::size_t size, std::size_t chunk,
+            bool rawInput) {
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+  if (rawInput) // keep dump lines whole: chunk = multiple of every line size
+    chunk = std::max(kHexLineBytes, chunk / kHexLineBytes * kHexLineBytes);
+  else
+    chunk = std::max<std::size_t>(chunk, 1);
+  for (std::size_t b = 0; b < size;) {
+    std::size_t e = size - b <= chunk ? size : b + chunk;
+    if (!rawInput)
+      while (e < size && !isSpace(data[e - 1]))
+        ++e;
+    ranges.emplace_back(b, e);
+    b = e;
+  }
+  return ranges;
+}
+
+} // namespace
+
+/**
+ * @brief Format name lookup.
+ * @param name "bytes", "dec", "hex", "oct" or "bin".
+ * @return The format, or std::nullopt for unknown names.
+ */
+std::optional<Format> parseFormat(const std::string &name) {
+  if (name == "bytes")
+    return Format::Bytes;
+  if (name == "dec")
+    return Format::Dec;
+  if (name == "hex")
+    return Format::Hex;
+  if (name == "oct")
+    return Format::Oct;
+  if (name == "bin")
+    return Format::Bin;
+  return std::nullopt;
+}
+
+/**
+ * @brief Hex encoder: nibbles are spread with unpack and mapped to ASCII
+ *        with one compare (16 bytes per SSE2 step).
+ */
+void encodeHex(const std::uint8_t *in, std::size_t n, char *out) {
+  std::size_t i = 0;
+#ifdef BASECONV_SSE2
+  const __m128i lowNibble = _mm_set1_epi8(0x0F);
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i gap = _mm_set1_epi8('A' - '0' - 10);
+  auto ascii = [&](__m128i v) {
+    return _mm_add_epi8(_mm_add_epi8(v, zero),
+                        _mm_and_si128(_mm_cmpgt_epi8(v, nine), gap));
+  };
+  for (; i + 16 <= n; i += 16) {
+    const __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), lowNibble);
+    const __m128i lo = _mm_and_si128(x, lowNibble);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i),
+                     ascii(_mm_unpacklo_epi8(hi, lo)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 16),
+                     ascii(_mm_unpackhi_epi8(hi, lo)));
+  }
+#endif
+  for (; i < n; ++i) {
+    out[2 * i] = "0123456789ABCDEF"[in[i] >> 4];
+    out[2 * i + 1] = "0123456789ABCDEF"[in[i] & 0x0F];
+  }
+}
+
+/**
+ * @brief Hex decoder: classifies 16 characters at once, then merges
+ *        adjacent nibbles within 16-bit lanes (8 bytes per SSE2 step).
+ */
+bool decodeHex(const char *in, std::size_t n, std::uint8_t *out) {
+  std::size_t i = 0;
+#ifdef BASECONV_SSE2
+  const __m128i caseBit = _mm_set1_epi8(0x20);
+  const __m128i beforeDigit = _mm_set1_epi8('0' - 1);
+  const __m128i afterDigit = _mm_set1_epi8('9' + 1);
+  const __m128i beforeAlpha = _mm_set1_epi8('a' - 1);
+  const __m128i afterAlpha = _mm_set1_epi8('f' + 1);
+  const __m128i digitBias = _mm_set1_epi8('0');
+  const __m128i alphaBias = _mm_set1_epi8('a' - 10);
+  const __m128i lowByte = _mm_set1_epi16(0x00FF);
+  for (; i + 8 <= n; i += 8) {
+    const __m128i c =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 2 * i));
+    const __m128i lower = _mm_or_si128(c, caseBit);
+    const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, beforeDigit),
+                                          _mm_cmplt_epi8(c, afterDigit));
+    const __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, beforeAlpha),
+                                          _mm_cmplt_epi8(lower, afterAlpha));
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) != 0xFFFF)
+      return false;
+    const __m128i v =
+        _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(c, digitBias)),
+                     _mm_and_si128(isAlpha, _mm_sub_epi8(lower, alphaBias)));
+    // Lane k holds (first digit, second digit) as (low byte, high byte).
+    const __m128i bytes = _mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(v, lowByte), 4), _mm_srli_epi16(v, 8));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i),
+                     _mm_packus_epi16(bytes, bytes));
+  }
+#endif
+  for (; i < n; ++i) {
+    const int hi = kTables.digit[u8(in[2 * i])];
+    const int lo = kTables.digit[u8(in[2 * i + 1])];
+    if (hi < 0 || lo < 0)
+      return false;
+    out[i] = static_cast<std::uint8_t>(hi << 4 | lo);
+  }
+  return true;
+}
+
+/**
+ * @brief Binary encoder: each byte is broadcast to 8 lanes and tested
+ *        against a per-lane bit mask (16 bytes per SSE2 step).
+ */
+void encodeBin(const std::uint8_t *in, std::size_t n, char *out) {
+  std::size_t i = 0;
+#ifdef BASECONV_SSE2
+  const __m128i bits = _mm_setr_epi8(
+      static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+      static_cast<char>(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+  const __m128i zero = _mm_set1_epi8('0');
+  auto emit = [&](__m128i v, char *p) {
+    // '0' - (-1) = '1' where the bit is set.
+    const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(v, bits), bits);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm_sub_epi8(zero, set));
+  };
+  for (; i + 16 <= n; i += 16) {
+    const __m128i x =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    char *p = out + 8 * i;
+    const __m128i halves[2] = {_mm_unpacklo_epi8(x, x),
+                               _mm_unpackhi_epi8(x, x)};
+    for (const __m128i &h : halves) {
+      const __m128i quads[2] = {_mm_unpacklo_epi16(h, h),
+                                _mm_unpackhi_epi16(h, h)};
+      for (const __m128i &q : quads) {
+        emit(_mm_unpacklo_epi32(q, q), p);
+        emit(_mm_unpackhi_epi32(q, q), p + 16);
+        p += 32;
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i)
+    for (int b = 0; b < 8; ++b)
+      out[8 * i + b] = static_cast<char>('0' + ((in[i] >> (7 - b)) & 1));
+}
+
+/**
+ * @brief Binary decoder: validates 16 characters at once and gathers the
+ *        digits with movemask (2 bytes per SSE2 step).
+ */
+bool decodeBin(const char *in, std::size_t n, std::uint8_t *out) {
+  std::size_t i = 0;
+#ifdef BASECONV_SSE2
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i notOne = _mm_set1_epi8(static_cast<char>(0xFE));
+  const __m128i one = _mm_set1_epi8(1);
+  for (; i + 2 <= n; i += 2) {
+    const __m128i d = _mm_sub_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 8 * i)), zero);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(d, notOne),
+                                         _mm_setzero_si128())) != 0xFFFF)
+      return false;
+    // movemask puts the first character in bit 0; bytes are MSB first.
+    const int m = _mm_movemask_epi8(_mm_cmpeq_epi8(d, one));
+    out[i] = kTables.reverse[m & 0xFF];
+    out[i + 1] = kTables.reverse[m >> 8];
+  }
+#endif
+  for (; i < n; ++i) {
+    unsigned v = 0;
+    for (int b = 0; b < 8; ++b) {
+      const char c = in[8 * i + b];
+      if (c != '0' && c != '1')
+        return false;
+      v = v << 1 | static_cast<unsigned>(c - '0');
+    }
+    out[i] = static_cast<std::uint8_t>(v);
+  }
+  return true;
+}
+
+/**
+ * @brief Parallel chunked conversion with in-order output.
+ *
+ * Workers claim chunks from an atomic counter but may run at most `window`
+ * chunks ahead of the writer, which bounds memory on huge inputs. The
+ * calling thread hands finished chunks to the sink in input order.
+ */
+std::optional<Stats> convert(const char *data, std::size_t size, Format from,
+                             Format to, const Sink &sink,
+                             const Options &options, std::string *error) {
+  if (from == Format::Bytes && to == Format::Bytes) {
+    if (error)
+      *error = "nothing to convert: input and output are both raw bytes";
+    return std::nullopt;
+  }
+  const auto t0 = std::chrono::steady_clock::now();
+  const auto ranges =
+      splitChunks(data, size, options.chunkBytes, from == Format::Bytes);
+  const std::size_t count = ranges.size();
+
+  unsigned threads = options.threads ? options.threads
+                                     : std::thread::hardware_concurrency();
+  threads = std::max(1u, std::min<unsigned>(
+                             threads, static_cast<unsigned>(
+                                          std::max<std::size_t>(count, 1))));
+  const std::size_t window = 2 * static_cast<std::size_t>(threads);
+
+  std::vector<ChunkResult> results(count);
+  std::vector<char> done(count, 0);
+  std::atomic<std::size_t> next{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::size_t written = 0; // guarded by mutex
+  bool abort = false;      // guarded by mutex
+  // Written buffers are recycled so huge outputs do not page-fault fresh
+  // allocations for every chunk.
+  std::vector<std::string> spare; // guarded by mutex
+
+  auto work = [&] {
+    for (;;) {
+      ChunkResult res;
+      const std::size_t idx = next.fetch_add(1);
+      if (idx >= count)
+        return;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return abort || idx < written + window; });
+        if (abort)
+          return;
+        if (!spare.empty()) {
+          res.out = std::move(spare.back());
+          spare.pop_back();
+        }
+      }
+      const char *in = data + ranges[idx].first;
+      const std::size_t n = ranges[idx].second - ranges[idx].first;
+      if (from == Format::Bytes)
+        encodeChunk(reinterpret_cast<const std::uint8_t *>(in), n, to,
+                    res.out);
+      else if (to == Format::Bytes)
+        decodeChunk(in, n, ranges[idx].first, from, res);
+      else
+        rebaseChunk(in, n, ranges[idx].first, from, to, res);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        results[idx] = std::move(res);
+        done[idx] = 1;
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (unsigned t = 0; t < threads; ++t)
+    pool.emplace_back(work);
+
+  Stats stats;
+  bool ok = true;
+  for (std::size_t i = 0; i < count && ok; ++i) {
+    ChunkResult res;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return done[i] != 0; });
+      res = std::move(results[i]);
+    }
+    if (res.error) {
+      if (error)
+        *error = std::string(res.error) + " at input offset " +
+                 std::to_string(res.errorAt);
+      ok = false;
+    } else if (!res.out.empty() && !sink(res.out.data(), res.out.size())) {
+      if (error)
+        *error = "output write failed";
+      ok = false;
+    } else {
+      stats.bytesOut += res.out.size();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      written = i + 1;
+      abort = !ok;
+      res.out.clear();
+      spare.push_back(std::move(res.out));
+    }
+    cv.notify_all();
+  }
+  for (auto &t : pool)
+    t.join();
+  if (!ok)
+    return std::nullopt;
+
+  stats.bytesIn = size;
+  stats.seconds = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - t0)
+                      .count();
+  return stats;
+}
+
+} // namespace baseconv
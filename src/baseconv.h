@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+/**
+ * @file baseconv.h
+ * @brief Streaming base conversion for large inputs (headless).
+ *
+ * Converts whole buffers (typically a MappedFile) between raw bytes and
+ * decimal, hexadecimal, octal or binary text, or re-bases lists of integers
+ * from one text base to another. The input is cut into chunks on line/token
+ * boundaries, chunks are converted in parallel and handed to the sink in
+ * input order, so output can be streamed with large writes while memory
+ * stays bounded to a small window of chunks.
+ *
+ * Byte dumps are written as 32 bytes per line for hex, 16 bytes per line for
+ * binary (contiguous digits, most significant bit first) and 16
+ * space-separated tokens per line for octal and decimal. Hex digits are
+ * upper-case, as in the Convert dialog. Decoding accepts any whitespace
+ * between tokens; hex and binary tokens must hold whole bytes.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace baseconv {
+
+/// Input/output representation.
+enum class Format {
+  Bytes, ///< Raw binary data.
+  Dec,   ///< Decimal text.
+  Hex,   ///< Hexadecimal text.
+  Oct,   ///< Octal text.
+  Bin    ///< Binary text.
+};
+
+/** @brief Parse "bytes", "dec", "hex", "oct" or "bin". */
+std::optional<Format> parseFormat(const std::string &name);
+
+// --- Kernels (SSE2 where available, scalar otherwise) ---
+/** @brief Write 2 * n upper-case hex digits for @p n bytes. */
+void encodeHex(const std::uint8_t *in, std::size_t n, char *out);
+/**
+ * @brief Read 2 * n hex digits (either case) into @p n bytes.
+ * @return false if a character is not a hex digit.
+ */
+bool decodeHex(const char *in, std::size_t n, std::uint8_t *out);
+/** @brief Write 8 * n binary digits (MSB first) for @p n bytes. */
+void encodeBin(const std::uint8_t *in, std::size_t n, char *out);
+/**
+ * @brief Read 8 * n binary digits into @p n bytes.
+ * @return false if a character is not '0' or '1'.
+ */
+bool decodeBin(const char *in, std::size_t n, std::uint8_t *out);
+
+/// Conversion tuning.
+struct Options {
+  unsigned threads = 0;             ///< Worker threads (0 = all cores).
+  std::size_t chunkBytes = 8 << 20; ///< Input bytes per chunk.
+};
+
+/// Totals for one conversion.
+struct Stats {
+  std::uint64_t bytesIn = 0;  ///< Input bytes consumed.
+  std::uint64_t bytesOut = 0; ///< Output bytes handed to the sink.
+  double seconds = 0.0;       ///< Wall time.
+};
+
+/// Receives output blocks in order; returns false to abort (e.g. I/O error).
+using Sink = std::function<bool(const char *, std::size_t)>;
+
+/**
+ * @brief Convert a buffer and stream the result to @p sink.
+ *
+ * Bytes -> text dumps the data, text -> Bytes parses a dump back, and
+ * text -> text re-bases whitespace-separated integers (an optional leading
+ * '-' is kept; magnitudes must fit in 64 bits), one per output line.
+ *
+ * @param data Input buffer.
+ * @param size Input size in bytes.
+ * @param from Input format.
+ * @param to Output format.
+ * @param sink Output consumer.
+ * @param options Threads and chunk size.
+ * @param error Receives a message (with the input offset) on failure.
+ * @return Totals, or std::nullopt on invalid input, an unsupported format
+ *         pair (Bytes -> Bytes) or when the sink fails.
+ */
+std::optional<Stats> convert(const char *data, std::size_t size, Format from,
+                             Format to, const Sink &sink,
+                             const Options &options = {},
+                             std::string *error = nullptr);
+
+} // namespace baseconv
@@ -0,0 +1,186 @@
+/**
+ * @file basicengine.cpp
+ * @brief Implementation of BasicEngine<T> and its explicit instantiations.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "basicengine.h"
+#include "numbertheory.h"
+#include <algorithm>
+
+/**
+ * @brief Reset operands and operator.
+ */
+template <typename T> void BasicEngine<T>::clear() {
+  value1_ = value2_ = T(0);
+  op_ = Op::None;
+  hasV1_ = hasV2_ = false;
+}
+
+/**
+ * @brief Set the first operand value.
+ * @param v Value to set as first operand.
+ */
+template <typename T> void BasicEngine<T>::setValue1(T v) {
+  value1_ = v;
+  hasV1_ = true;
+}
+
+/**
+ * @brief Set the second operand value.
+ * @param v Value to set as second operand.
+ */
+template <typename T> void BasicEngine<T>::setValue2(T v) {
+  value2_ = v;
+  hasV2_ = true;
+}
+
+/**
+ * @brief Add value1 and value2.
+ * @return Sum, or std::nullopt if an operand is missing.
+ */
+template <typename T> std::optional<T> BasicEngine<T>::add() const {
+  if (!hasV1_ || !hasV2_)
+    return std::nullopt;
+  return value1_ + value2_;
+}
+
+/**
+ * @brief Subtract value2 from value1.
+ * @return Difference, or std::nullopt if an operand is missing.
+ */
+template <typename T> std::optional<T> BasicEngine<T>::sub() const {
+  if (!hasV1_ || !hasV2_)
+    return std::nullopt;
+  return value1_ - value2_;
+}
+
+/**
+ * @brief Multiply value1 by value2.
+ * @return Product, or std::nullopt if an operand is missing.
+ */
+template <typename T> std::optional<T> BasicEngine<T>::mul() const {
+  if (!hasV1_ || !hasV2_)
+    return std::nullopt;
+  return value1_ * value2_;
+}
+
+/**
+ * @brief Divide value1 by value2.
+ * @return Quotient, or std::nullopt on missing operands or division by zero.
+ */
+template <typename T> std::optional<T> BasicEngine<T>::div() const {
+  if (!hasV1_ || !hasV2_)
+    return std::nullopt;
+  return apply(Op::Div, value1_, value2_);
+}
+
+/**
+ * @brief Evaluate the current operator on the stored operands.
+ * @return Result, or std::nullopt on missing operands or an invalid op.
+ */
+template <typename T> std::optional<T> BasicEngine<T>::evaluate() const {
+  if (!hasV1_ || !hasV2_)
+    return std::nullopt;
+  return apply(op_, value1_, value2_);
+}
+
+/**
+ * @brief Apply a binary arithmetic operator to explicit operands.
+ * @param op Operator to apply (Add, Sub, Mul, Div, Gcd, Lcm, Pow).
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return Result, or std::nullopt for division by zero or non-arithmetic ops.
+ */
+template <typename T>
+std::optional<T> BasicEngine<T>::apply(Op op, T a, T b) {
+  switch (op) {
+  case Op::Add:
+    return a + b;
+  case Op::Sub:
+    return a - b;
+  case Op::Mul:
+    return a * b;
+  case Op::Div:
+    if (b == T(0))
+      return std::nullopt;
+    return a / b;
+  case Op::Gcd:
+  case Op::Lcm: {
+    Integer ia = 0, ib = 0;
+    if (!toInteger(a, ia) || !toInteger(b, ib))
+      return std::nullopt;
+    const auto r =
+        op == Op::Gcd ? numtheory::gcd(ia, ib) : numtheory::lcm(ia, ib);
+    if (!r)
+      return std::nullopt;
+    return static_cast<T>(*r);
+  }
+  case Op::Pow:
+    // Negative bases only have real powers for integral exponents.
+    if ((a < T(0) && precision::trunc(b) != b) || (a == T(0) && b < T(0)))
+      return std::nullopt;
+    return precision::pow(a, b);
+  default:
+    return std::nullopt;
+  }
+}
+
+/**
+ * @brief Element-wise apply(); the arithmetic cases are plain loops the
+ *        compiler vectorizes for float and double.
+ */
+template <typename T>
+void BasicEngine<T>::applyBatch(Op op, const T *a, const T *b, T *out,
+                                std::size_t n) {
+  const T nan = precision::nan<T>();
+  switch (op) {
+  case Op::Add:
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = a[i] + b[i];
+    break;
+  case Op::Sub:
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = a[i] - b[i];
+    break;
+  case Op::Mul:
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = a[i] * b[i];
+    break;
+  case Op::Div:
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = b[i] == T(0) ? nan : a[i] / b[i];
+    break;
+  default:
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto r = apply(op, a[i], b[i]);
+      out[i] = r ? *r : nan;
+    }
+    break;
+  }
+}
+
+/**
+ * @brief Exact integer view of a value.
+ * @param v Value to inspect.
+ * @param out Receives the integer when the conversion is exact.
+ * @return true if @p v is integral, below 2^(mantissa bits) and fits Integer.
+ */
+template <typename T> bool BasicEngine<T>::toInteger(T v, Integer &out) {
+  constexpr int intBits = static_cast<int>(sizeof(Integer)) * 8 - 2;
+  constexpr int bits = std::min(precision::mantissaBits<T>(), intBits);
+  static const T limit = static_cast<T>(static_cast<Integer>(1) << bits);
+  if (!(precision::fabs(v) < limit) || precision::trunc(v) != v)
+    return false;
+  out = static_cast<Integer>(v);
+  return true;
+}
+
+template class BasicEngine<float>;
+template class BasicEngine<double>;
+template class BasicEngine<long double>;
+#ifdef CALCULATOR_HAS_FLOAT128
+template class BasicEngine<__float128>;
+#endif
@@ -0,0 +1,143 @@
+#pragma once
+#include "checked_int.h"
+#include "precision.h"
+#include <cstddef>
+#include <optional>
+
+/**
+ * @file basicengine.h
+ * @brief Declaration of BasicEngine<T> (real arithmetic at a chosen precision).
+ *
+ * BasicEngine is the real-valued core of Engine (two operands, an
+ * operator, add/sub/mul/div/evaluate and the stateless apply()) templated on
+ * the floating-point type. Engine keeps its operands in a
+ * BasicEngine<Engine::Real>, the tier picked at build time, and adds the
+ * integer, complex and fraction paths around it; every tier follows the
+ * keypad's rules (a / 0 and undefined powers give std::nullopt, Gcd/Lcm need
+ * integral operands).
+ *
+ * applyBatch() runs one operator over whole arrays; for float and double the
+ * loops vectorize, which is where lower tiers pay off.
+ *
+ * Explicit instantiations exist for float, double, long double and, when
+ * CALCULATOR_HAS_FLOAT128 is set, __float128 (see precision.h).
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+/**
+ * @brief Operators of every tier, also known as Engine::Op.
+ * - Arithmetic: Add, Sub, Mul, Div
+ * - Base conversions: ToDec, ToHex, ToOct (UI formats the string; engine
+ *   only passes through the numeric value1_ when present)
+ * - Number theory: Gcd, Lcm (integral operands only)
+ * - Pow: value1^value2 (complex when the real power is undefined)
+ */
+enum class EngineOp {
+  None,
+  Add,
+  Sub,
+  Mul,
+  Div,
+  ToDec,
+  ToHex,
+  ToOct,
+  ToBin,
+  Random,
+  Gcd,
+  Lcm,
+  Pow
+};
+
+template <typename T> class BasicEngine {
+public:
+  /// Operand/result type of this tier.
+  using Real = T;
+  /// Operators are shared with Engine.
+  using Op = EngineOp;
+  /// Exact integer type of Gcd/Lcm (Engine::Integer).
+  using Integer = checked::Int;
+
+  /** @brief Reset operands and operator. */
+  void clear();
+  /** @brief Set the current operator. @param op Operator to apply. */
+  void setOp(Op op) { op_ = op; }
+  /** @brief Get the current operator. @return Current operator. */
+  Op op() const { return op_; }
+  /** @brief Set first operand and mark it present. @param v Operand value. */
+  void setValue1(T v);
+  /** @brief Set second operand and mark it present. @param v Operand value. */
+  void setValue2(T v);
+  /** @brief Get first operand. @return value1_. */
+  T value1() const { return value1_; }
+  /** @brief Get second operand. @return value2_. */
+  T value2() const { return value2_; }
+  /** @brief Whether first operand is present. */
+  bool hasV1() const { return hasV1_; }
+  /** @brief Whether second operand is present. */
+  bool hasV2() const { return hasV2_; }
+
+  /** @brief value1_ + value2_, or std::nullopt if an operand is missing. */
+  std::optional<T> add() const;
+  /** @brief value1_ - value2_, or std::nullopt if an operand is missing. */
+  std::optional<T> sub() const;
+  /** @brief value1_ * value2_, or std::nullopt if an operand is missing. */
+  std::optional<T> mul() const;
+  /**
+   * @brief value1_ / value2_.
+   * @return Quotient, or std::nullopt on division by zero or missing inputs.
+   */
+  std::optional<T> div() const;
+  /**
+   * @brief Evaluate the current operator on the stored operands.
+   * @return Result, or std::nullopt on invalid state.
+   */
+  std::optional<T> evaluate() const;
+
+  /**
+   * @brief Apply a binary arithmetic operator to explicit operands.
+   * @param op Arithmetic operator (Add, Sub, Mul, Div, Gcd, Lcm or Pow).
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return The result, or std::nullopt for non-arithmetic ops, a / 0,
+   *         undefined real powers or Gcd/Lcm of non-integral values.
+   */
+  static std::optional<T> apply(Op op, T a, T b);
+
+  /**
+   * @brief Element-wise out[i] = a[i] op b[i].
+   *
+   * Entries where apply() would return std::nullopt become NaN.
+   * In-place use (out == a or out == b) is allowed.
+   *
+   * @param op Arithmetic operator (as for apply()).
+   * @param a Left operands.
+   * @param b Right operands.
+   * @param out Output array of @p n values.
+   * @param n Element count.
+   */
+  static void applyBatch(Op op, const T *a, const T *b, T *out, std::size_t n);
+
+  /**
+   * @brief Exact integer view of a value of this tier.
+   * @param v Value to inspect.
+   * @param out Receives the integer when the conversion is exact.
+   * @return true if @p v is integral and below 2^(mantissa bits of T), so no
+   *         rounding has happened yet, and the integer fits Integer.
+   */
+  static bool toInteger(T v, Integer &out);
+
+private:
+  T value1_ = T(0);    ///< First operand.
+  T value2_ = T(0);    ///< Second operand.
+  Op op_ = Op::None;   ///< Current operator.
+  bool hasV1_ = false; ///< Whether value1_ is set.
+  bool hasV2_ = false; ///< Whether value2_ is set.
+};
+
+extern template class BasicEngine<float>;
+extern template class BasicEngine<double>;
+extern template class BasicEngine<long double>;
+#ifdef CALCULATOR_HAS_FLOAT128
+extern template class BasicEngine<__float128>;
+#endif
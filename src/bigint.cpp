@@ -0,0 +1,901 @@
+/**
+ * @file bigint.cpp
+ * @brief Implementation of BigInt (base 10^9 limbs, Karatsuba/NTT multiply).
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "bigint.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+namespace {
+
+/// a^e mod P.
+template <std::uint32_t P> std::uint32_t powMod(std::uint64_t a, std::uint64_t e) {
+  std::uint64_t r = 1;
+  a %= P;
+  while (e) {
+    if (e & 1)
+      r = r * a % P;
+    a = a * a % P;
+    e >>= 1;
+  }
+  return static_cast<std::uint32_t>(r);
+}
+
+/**
+ * @brief In-place iterative number-theoretic transform modulo P.
+ *
+ * P is a compile-time constant so every "% P" becomes a multiply-shift.
+ * All three primes used have primitive root 3.
+ */
+template <std::uint32_t P>
+void ntt(std::vector<std::uint32_t> &a, bool inverse) {
+  const std::size_t n = a.size();
+  for (std::size_t i = 1, j = 0; i < n; ++i) {
+    std::size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+      std::swap(a[i], a[j]);
+  }
+  std::vector<std::uint32_t> w(n / 2);
+  for (std::size_t len = 2; len <= n; len <<= 1) {
+    std::uint32_t root = powMod<P>(3, (P - 1) / len);
+    if (inverse)
+      root = powMod<P>(root, P - 2);
+    const std::size_t half = len / 2;
+    w[0] = 1;
+    for (std::size_t k = 1; k < half; ++k)
+      w[k] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(w[k - 1]) *
+                                        root % P);
+    for (std::size_t i = 0; i < n; i += len) {
+      for (std::size_t k = 0; k < half; ++k) {
+        const std::uint32_t u = a[i + k];
+        const std::uint32_t v = static_cast<std::uint32_t>(
+            static_cast<std::uint64_t>(a[i + k + half]) * w[k] % P);
+        a[i + k] = u + v >= P ? u + v - P : u + v;
+        a[i + k + half] = u >= v ? u - v : u + P - v;
+      }
+    }
+  }
+  if (inverse) {
+    const std::uint64_t nInv = powMod<P>(n, P - 2);
+    for (auto &x : a)
+      x = static_cast<std::uint32_t>(x * nInv % P);
+  }
+}
+
+/// Cyclic convolution of two limb arrays modulo P (length n, power of two).
+template <std::uint32_t P>
+std::vector<std::uint32_t> convolve(const std::uint32_t *a, std::size_t an,
+                                    const std::uint32_t *b, std::size_t bn,
+                                    std::size_t n) {
+  std::vector<std::uint32_t> fa(n, 0), fb(n, 0);
+  for (std::size_t i = 0; i < an; ++i)
+    fa[i] = a[i] % P;
+  for (std::size_t i = 0; i < bn; ++i)
+    fb[i] = b[i] % P;
+  ntt<P>(fa, false);
+  ntt<P>(fb, false);
+  for (std::size_t i = 0; i < n; ++i)
+    fa[i] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(fa[i]) *
+                                       fb[i] % P);
+  ntt<P>(fa, true);
+  return fa;
+}
+
+constexpr std::uint32_t kP1 = 998244353u; // 119 * 2^23 + 1
+constexpr std::uint32_t kP2 = 167772161u; // 5 * 2^25 + 1
+constexpr std::uint32_t kP3 = 469762049u; // 7 * 2^26 + 1
+/// Longest transform all three primes support.
+constexpr std::size_t kMaxNtt = std::size_t(1) << 23;
+/// From this transform length the three primes are convolved in parallel.
+constexpr std::size_t kParallelNtt = std::size_t(1) << 16;
+
+} // namespace
+
+/**
+ * @brief Magnitude kernels shared by the BigInt operators.
+ *
+ * All functions work on little-endian base-10^9 limb vectors without sign.
+ */
+class BigIntOps {
+public:
+  using Limbs = BigInt::Limbs;
+  /// Below this many limbs (smaller operand) schoolbook beats Karatsuba.
+  static constexpr std::size_t kKaratsuba = 40;
+  /// From this many limbs (smaller operand) the NTT beats Karatsuba.
+  static constexpr std::size_t kNtt = 1500;
+  /// From this many limbs (divisor and quotient) Newton division beats
+  /// Knuth's algorithm D.
+  static constexpr std::size_t kNewtonDiv = 600;
+
+  static void trim(Limbs &a) {
+    while (!a.empty() && a.back() == 0)
+      a.pop_back();
+  }
+
+  static int cmp(const Limbs &a, const Limbs &b) {
+    if (a.size() != b.size())
+      return a.size() < b.size() ? -1 : 1;
+    for (std::size_t i = a.size(); i-- > 0;)
+      if (a[i] != b[i])
+        return a[i] < b[i] ? -1 : 1;
+    return 0;
+  }
+
+  /// acc += x * kBase^shift.
+  static void addInto(Limbs &acc, const std::uint32_t *x, std::size_t n,
+                      std::size_t shift) {
+    if (acc.size() < shift + n)
+      acc.resize(shift + n, 0);
+    std::uint32_t carry = 0;
+    std::size_t i = 0;
+    for (; i < n; ++i) {
+      std::uint32_t v = acc[shift + i] + x[i] + carry;
+      carry = v >= BigInt::kBase;
+      acc[shift + i] = carry ? v - BigInt::kBase : v;
+    }
+    for (std::size_t k = shift + i; carry; ++k) {
+      if (k == acc.size())
+        acc.push_back(0);
+      std::uint32_t v = acc[k] + carry;
+      carry = v >= BigInt::kBase;
+      acc[k] = carry ? v - BigInt::kBase : v;
+    }
+  }
+
+  /// a -= b (requires a >= b).
+  static void subInPlace(Limbs &a, const std::uint32_t *b, std::size_t n) {
+    std::int64_t borrow = 0;
+    std::size_t i = 0;
+    for (; i < n || borrow; ++i) {
+      std::int64_t v = static_cast<std::int64_t>(a[i]) - borrow -
+                       (i < n ? static_cast<std::int64_t>(b[i]) : 0);
+      borrow = v < 0;
+      a[i] = static_cast<std::uint32_t>(borrow ? v + BigInt::kBase : v);
+    }
+    trim(a);
+  }
+
+  static Limbs add(const Limbs &a, const Limbs &b) {
+    Limbs r = a;
+    addInto(r, b.data(), b.size(), 0);
+    return r;
+  }
+
+  /// Schoolbook product; rows are normalised as they go so sums fit in u64.
+  static Limbs school(const std::uint32_t *a, std::size_t n,
+                      const std::uint32_t *b, std::size_t m) {
+    Limbs r(n + m, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+      std::uint64_t carry = 0;
+      const std::uint64_t ai = a[i];
+      if (ai == 0)
+        continue;
+      for (std::size_t j = 0; j < m; ++j) {
+        const std::uint64_t cur = r[i + j] + ai * b[j] + carry;
+        carry = cur / BigInt::kBase;
+        r[i + j] = static_cast<std::uint32_t>(cur - carry * BigInt::kBase);
+      }
+      for (std::size_t k = i + m; carry; ++k) {
+        const std::uint64_t cur = r[k] + carry;
+        carry = cur / BigInt::kBase;
+        r[k] = static_cast<std::uint32_t>(cur - carry * BigInt::kBase);
+      }
+    }
+    trim(r);
+    return r;
+  }
+
+#if defined(__SIZEOF_INT128__)
+  /**
+   * @brief Product via three-prime NTT and Garner CRT.
+   *
+   * Each convolution term is below n * 10^18, which stays under the ~7.9e25
+   * product of the primes for every supported length, so the CRT
+   * reconstruction is exact.
+   */
+  static Limbs nttMul(const std::uint32_t *a, std::size_t n,
+                      const std::uint32_t *b, std::size_t m) {
+    std::size_t len = 1;
+    while (len < n + m)
+      len <<= 1;
+    // The three residue convolutions are independent; large ones run on
+    // their own threads.
+    std::vector<std::uint32_t> r1, r2, r3;
+    if (len >= kParallelNtt) {
+      std::thread t2([&] { r2 = convolve<kP2>(a, n, b, m, len); });
+      std::thread t3([&] { r3 = convolve<kP3>(a, n, b, m, len); });
+      r1 = convolve<kP1>(a, n, b, m, len);
+      t2.join();
+      t3.join();
+    } else {
+      r1 = convolve<kP1>(a, n, b, m, len);
+      r2 = convolve<kP2>(a, n, b, m, len);
+      r3 = convolve<kP3>(a, n, b, m, len);
+    }
+
+    const std::uint64_t inv1 = powMod<kP2>(kP1, kP2 - 2);
+    const std::uint64_t inv12 =
+        powMod<kP3>(static_cast<std::uint64_t>(kP1) * kP2 % kP3, kP3 - 2);
+    const std::uint64_t p12 = static_cast<std::uint64_t>(kP1) * kP2;
+    Limbs r(n + m + 1, 0);
+    unsigned __int128 carry = 0;
+    for (std::size_t i = 0; i < n + m; ++i) {
+      // Garner: x = r1 + p1 * k1 + p1 * p2 * k2.
+      const std::uint64_t k1 =
+          (r2[i] + kP2 - r1[i] % kP2) % kP2 * inv1 % kP2;
+      const std::uint64_t x12 = r1[i] + kP1 * k1; // < p1 * p2
+      const std::uint64_t k2 =
+          (r3[i] + kP3 - x12 % kP3) % kP3 * inv12 % kP3;
+      carry += x12 + static_cast<unsigned __int128>(p12) * k2;
+      r[i] = static_cast<std::uint32_t>(carry % BigInt::kBase);
+      carry /= BigInt::kBase;
+    }
+    for (std::size_t i = n + m; carry; ++i) {
+      if (i == r.size())
+        r.push_back(0);
+      r[i] = static_cast<std::uint32_t>(carry % BigInt::kBase);
+      carry /= BigInt::kBase;
+    }
+    trim(r);
+    return r;
+  }
+#endif
+
+  /// Product of magnitudes (n >= m after the swap).
+  static Limbs mul(const std::uint32_t *a, std::size_t n,
+                   const std::uint32_t *b, std::size_t m) {
+    if (n < m) {
+      std::swap(a, b);
+      std::swap(n, m);
+    }
+    if (m == 0)
+      return {};
+    if (m < kKaratsuba)
+      return school(a, n, b, m);
+#if defined(__SIZEOF_INT128__)
+    if (m >= kNtt && n + m <= kMaxNtt)
+      return nttMul(a, n, b, m);
+#endif
+
+    const std::size_t half = n / 2;
+    if (m <= half) {
+      // Unbalanced: cut the long operand into m-sized pieces.
+      Limbs r;
+      for (std::size_t off = 0; off < n; off += m) {
+        const std::size_t len = std::min(m, n - off);
+        Limbs part = mul(a + off, len, b, m);
+        addInto(r, part.data(), part.size(), off);
+      }
+      trim(r);
+      return r;
+    }
+
+    // Karatsuba: a = a0 + a1 B^h, b = b0 + b1 B^h.
+    auto limbs = [](const std::uint32_t *p, std::size_t len) {
+      Limbs v(p, p + len);
+      trim(v);
+      return v;
+    };
+    const Limbs a0 = limbs(a, half), a1 = limbs(a + half, n - half);
+    const Limbs b0 = limbs(b, half), b1 = limbs(b + half, m - half);
+    Limbs z0 = mul(a0.data(), a0.size(), b0.data(), b0.size());
+    Limbs z2 = mul(a1.data(), a1.size(), b1.data(), b1.size());
+    const Limbs sa = add(a0, a1), sb = add(b0, b1);
+    Limbs z1 = mul(sa.data(), sa.size(), sb.data(), sb.size());
+    subInPlace(z1, z0.data(), z0.size());
+    subInPlace(z1, z2.data(), z2.size());
+
+    Limbs r = std::move(z0);
+    addInto(r, z1.data(), z1.size(), half);
+    addInto(r, z2.data(), z2.size(), 2 * half);
+    trim(r);
+    return r;
+  }
+
+  /**
+   * @brief Magnitude division, Knuth algorithm D (TAOCP 4.3.1) in base 10^9.
+   *
+   * Operands are scaled so the divisor's top limb is at least kBase / 2,
+   * which makes the two-limb quotient estimate at most one too large after
+   * the usual correction step.
+   */
+  static void knuthDivMod(const Limbs &a, const Limbs &b, Limbs &q, Limbs &r) {
+    if (cmp(a, b) < 0) {
+      q.clear();
+      r = a;
+      return;
+    }
+    const std::uint64_t B = BigInt::kBase;
+    if (b.size() == 1) {
+      q.assign(a.size(), 0);
+      std::uint64_t rem = 0;
+      for (std::size_t i = a.size(); i-- > 0;) {
+        const std::uint64_t cur = rem * B + a[i];
+        q[i] = static_cast<std::uint32_t>(cur / b[0]);
+        rem = cur % b[0];
+      }
+      trim(q);
+      r.assign(1, static_cast<std::uint32_t>(rem));
+      trim(r);
+      return;
+    }
+
+    const std::uint32_t norm = static_cast<std::uint32_t>(B / (b.back() + 1ull));
+    auto scale = [&](const Limbs &x) {
+      Limbs y(x.size() + 1, 0);
+      std::uint64_t carry = 0;
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        const std::uint64_t cur = static_cast<std::uint64_t>(x[i]) * norm + carry;
+        carry = cur / B;
+        y[i] = static_cast<std::uint32_t>(cur - carry * B);
+      }
+      y[x.size()] = static_cast<std::uint32_t>(carry);
+      return y;
+    };
+    Limbs u = scale(a);
+    Limbs v = scale(b);
+    v.pop_back(); // scaling never grows the divisor
+    const std::size_t n = v.size();
+    const std::size_t m = u.size() - n;
+    q.assign(m, 0);
+
+    for (std::size_t j = m; j-- > 0;) {
+      const std::uint64_t num = u[j + n] * B + u[j + n - 1];
+      std::uint64_t qhat = num / v[n - 1];
+      std::uint64_t rhat = num % v[n - 1];
+      while (qhat >= B || qhat * v[n - 2] > rhat * B + u[j + n - 2]) {
+        --qhat;
+        rhat += v[n - 1];
+        if (rhat >= B)
+          break;
+      }
+      // u[j .. j+n] -= qhat * v
+      std::uint64_t carry = 0;
+      std::int64_t borrow = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        const std::uint64_t p = qhat * v[i] + carry;
+        carry = p / B;
+        std::int64_t t = static_cast<std::int64_t>(u[i + j]) -
+                         static_cast<std::int64_t>(p - carry * B) - borrow;
+        borrow = t < 0;
+        u[i + j] = static_cast<std::uint32_t>(borrow ? t + static_cast<std::int64_t>(B) : t);
+      }
+      std::int64_t top = static_cast<std::int64_t>(u[j + n]) -
+                         static_cast<std::int64_t>(carry) - borrow;
+      if (top < 0) { // qhat was one too large: add v back
+        --qhat;
+        std::uint32_t c = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+          std::uint32_t s = u[i + j] + v[i] + c;
+          c = s >= B;
+          u[i + j] = c ? s - static_cast<std::uint32_t>(B) : s;
+        }
+        top += c;
+      }
+      u[j + n] = static_cast<std::uint32_t>(top);
+      q[j] = static_cast<std::uint32_t>(qhat);
+    }
+    trim(q);
+
+    // Remainder = u[0 .. n) / norm.
+    r.assign(u.begin(), u.begin() + static_cast<std::ptrdiff_t>(n));
+    std::uint64_t rem = 0;
+    for (std::size_t i = r.size(); i-- > 0;) {
+      const std::uint64_t cur = rem * B + r[i];
+      r[i] = static_cast<std::uint32_t>(cur / norm);
+      rem = cur % norm;
+    }
+    trim(r);
+  }
+
+  /// x * kBase^k.
+  static Limbs shiftUp(const Limbs &x, std::size_t k) {
+    if (x.empty())
+      return {};
+    Limbs r(k, 0);
+    r.insert(r.end(), x.begin(), x.end());
+    return r;
+  }
+
+  /// x / kBase^k, truncated.
+  static Limbs shiftDown(const Limbs &x, std::size_t k) {
+    if (k >= x.size())
+      return {};
+    return Limbs(x.begin() + static_cast<std::ptrdiff_t>(k), x.end());
+  }
+
+  static Limbs mul(const Limbs &a, const Limbs &b) {
+    return mul(a.data(), a.size(), b.data(), b.size());
+  }
+
+  /// a += 1 or a -= 1 (a > 0 for the decrement).
+  static void step(Limbs &a, bool up) {
+    const std::uint32_t one = 1;
+    if (up)
+      addInto(a, &one, 1, 0);
+    else
+      subInPlace(a, &one, 1);
+  }
+
+  /**
+   * @brief X ~ kBase^(m + p) / b (m = b.size()), good to a few units.
+   *
+   * Newton's iteration X += X (kBase^(m+p) - b X) / kBase^(m+p) doubles the
+   * correct limbs per step, so the recursion computes a half-precision
+   * reciprocal from a truncated divisor and lifts it; the total cost is a
+   * small multiple of one full-size multiplication.
+   */
+  static Limbs reciprocal(const Limbs &b, std::size_t p) {
+    const std::size_t m = b.size();
+    if (m > p + 2) // lower limbs do not affect p limbs of the result
+      return reciprocal(shiftDown(b, m - (p + 2)), p);
+    if (p <= 32) {
+      Limbs q, r;
+      knuthDivMod(shiftUp(Limbs{1}, m + p), b, q, r);
+      return q;
+    }
+    const std::size_t h = p / 2 + 2;
+    const Limbs x = shiftUp(reciprocal(b, h), p - h);
+    Limbs one = shiftUp(Limbs{1}, m + p);
+    Limbs bx = mul(b, x);
+    const bool low = cmp(bx, one) <= 0; // x too small: correct upwards
+    Limbs e = low ? std::move(one) : std::move(bx);
+    subInPlace(e, low ? bx.data() : one.data(), low ? bx.size() : one.size());
+    const Limbs corr = shiftDown(mul(x, e), m + p);
+    Limbs r = x;
+    if (low)
+      addInto(r, corr.data(), corr.size(), 0);
+    else
+      subInPlace(r, corr.data(), corr.size());
+    return r;
+  }
+
+  /// Division through reciprocal(); only the top limbs of a that reach the
+  /// quotient enter the product, then the remainder corrects the last units.
+  static void newtonDivMod(const Limbs &a, const Limbs &b, Limbs &q,
+                           Limbs &r) {
+    const std::size_t n = a.size(), m = b.size();
+    const std::size_t qlen = n - m + 1;
+    const std::size_t p = qlen + 1;
+    const Limbs x = reciprocal(b, p);
+    const std::size_t cut = n > qlen + 2 ? n - (qlen + 2) : 0;
+    q = shiftDown(mul(shiftDown(a, cut), x), m + p - cut);
+    trim(q);
+    Limbs qb = mul(q, b);
+    while (cmp(qb, a) > 0) {
+      step(q, false);
+      subInPlace(qb, b.data(), b.size());
+    }
+    r = a;
+    subInPlace(r, qb.data(), qb.size());
+    while (cmp(r, b) >= 0) {
+      step(q, true);
+      subInPlace(r, b.data(), b.size());
+    }
+  }
+
+  /// Quotient and remainder; Newton's method once both are large.
+  static void divMod(const Limbs &a, const Limbs &b, Limbs &q, Limbs &r) {
+    if (cmp(a, b) >= 0 && b.size() >= kNewtonDiv &&
+        a.size() - b.size() + 1 >= kNewtonDiv)
+      newtonDivMod(a, b, q, r);
+    else
+      knuthDivMod(a, b, q, r);
+  }
+
+  /// floor(sqrt(a)): Newton step from the root of the top half of a.
+  static Limbs sqrt(const Limbs &a) {
+    const std::size_t n = a.size();
+    if (n <= 4) {
+      // Below 10^36 the long double root is within a unit or two.
+      long double v = 0.0L;
+      for (std::size_t i = n; i-- > 0;)
+        v = v * BigInt::kBase + a[i];
+      Limbs x;
+      for (auto e = static_cast<std::uint64_t>(std::sqrt(v)); e;
+           e /= BigInt::kBase)
+        x.push_back(static_cast<std::uint32_t>(e % BigInt::kBase));
+      while (!x.empty() && cmp(mul(x, x), a) > 0)
+        step(x, false);
+      for (Limbs y = x;; x = y) {
+        step(y, true);
+        if (cmp(mul(y, y), a) > 0)
+          break;
+      }
+      return x;
+    }
+    const std::size_t k = n / 4;
+    // x <= sqrt(a) with about half the limbs right; one Newton step
+    // (x + a/x) / 2 lands at or just above the floor.
+    Limbs x = shiftUp(sqrt(shiftDown(a, 2 * k)), k);
+    Limbs quot, rem;
+    divMod(a, x, quot, rem);
+    addInto(x, quot.data(), quot.size(), 0);
+    std::uint64_t carry = 0;
+    for (std::size_t i = x.size(); i-- > 0;) {
+      const std::uint64_t cur = carry * BigInt::kBase + x[i];
+      x[i] = static_cast<std::uint32_t>(cur / 2);
+      carry = cur % 2;
+    }
+    trim(x);
+    while (cmp(mul(x, x), a) > 0)
+      step(x, false);
+    return x;
+  }
+
+  /// Signed add of (a, an) and (b, bn) into out.
+  static void signedAdd(const Limbs &a, bool an, const Limbs &b, bool bn,
+                        Limbs &out, bool &outNeg) {
+    if (an == bn) {
+      out = add(a, b);
+      outNeg = an;
+      return;
+    }
+    const int c = cmp(a, b);
+    if (c >= 0) {
+      out = a;
+      subInPlace(out, b.data(), b.size());
+      outNeg = an;
+    } else {
+      out = b;
+      subInPlace(out, a.data(), a.size());
+      outNeg = bn;
+    }
+  }
+};
+
+/**
+ * @brief Construct from a native integer.
+ * @param v Value.
+ */
+BigInt::BigInt(long long v) { *this = fromInteger(v); }
+
+/**
+ * @brief Construct from checked::Int.
+ * @param v Value.
+ * @return BigInt equal to v.
+ */
+BigInt BigInt::fromInteger(checked::Int v) {
+  BigInt r;
+  r.neg_ = v < 0;
+  for (checked::UInt m = checked::magnitude(v); m != 0; m /= kBase)
+    r.mag_.push_back(static_cast<std::uint32_t>(m % kBase));
+  return r;
+}
+
+/**
+ * @brief Parse decimal text.
+ * @param text Optionally signed digits.
+ * @return Value or std::nullopt.
+ */
+std::optional<BigInt> BigInt::fromString(const std::string &text) {
+  std::size_t start = 0;
+  bool neg = false;
+  if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+    neg = text[0] == '-';
+    start = 1;
+  }
+  if (start == text.size())
+    return std::nullopt;
+  BigInt r;
+  for (std::size_t end = text.size(); end > start;) {
+    const std::size_t begin =
+        end - std::min<std::size_t>(kBaseDigits, end - start);
+    std::uint32_t limb = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+      if (text[i] < '0' || text[i] > '9')
+        return std::nullopt;
+      limb = limb * 10 + static_cast<std::uint32_t>(text[i] - '0');
+    }
+    r.mag_.push_back(limb);
+    end = begin;
+  }
+  r.neg_ = neg;
+  r.trim();
+  return r;
+}
+
+/**
+ * @brief Decimal text.
+ * @return Digits, '-' prefixed when negative.
+ */
+std::string BigInt::toString() const {
+  if (mag_.empty())
+    return "0";
+  std::string s = neg_ ? "-" : "";
+  s += std::to_string(mag_.back());
+  char buf[kBaseDigits];
+  for (std::size_t i = mag_.size() - 1; i-- > 0;) {
+    std::uint32_t v = mag_[i];
+    for (int k = kBaseDigits - 1; k >= 0; --k) {
+      buf[k] = static_cast<char>('0' + v % 10);
+      v /= 10;
+    }
+    s.append(buf, kBaseDigits);
+  }
+  return s;
+}
+
+/**
+ * @brief Decimal digit count.
+ * @return Digits of |this| (1 for zero).
+ */
+std::size_t BigInt::digitCount() const {
+  if (mag_.empty())
+    return 1;
+  return (mag_.size() - 1) * kBaseDigits + std::to_string(mag_.back()).size();
+}
+
+/**
+ * @brief Convert to checked::Int if it fits.
+ * @return Value or std::nullopt.
+ */
+std::optional<checked::Int> BigInt::toInteger() const {
+  checked::Int v = 0;
+  for (std::size_t i = mag_.size(); i-- > 0;) {
+    if (!checked::mul(v, kBase, v) ||
+        !checked::sub(v, static_cast<checked::Int>(mag_[i]), v))
+      return std::nullopt; // accumulate negatively so kMin fits
+  }
+  if (!neg_ && !checked::mul(v, -1, v))
+    return std::nullopt;
+  return v;
+}
+
+/**
+ * @brief Approximate as long double.
+ * @return Nearest value (top limbs only; infinity on overflow).
+ */
+long double BigInt::toLongDouble() const {
+  long double v = 0.0L;
+  // Three limbs (27 digits) exceed long double precision.
+  const std::size_t top = mag_.size() > 3 ? mag_.size() - 3 : 0;
+  for (std::size_t i = mag_.size(); i-- > top;)
+    v = v * kBase + mag_[i];
+  if (top > 0)
+    v *= std::pow(static_cast<long double>(kBase), static_cast<long double>(top));
+  return neg_ ? -v : v;
+}
+
+/** @brief Zero test. @return true if zero. */
+bool BigInt::isZero() const { return mag_.empty(); }
+
+/** @brief Sign test. @return true if negative. */
+bool BigInt::isNegative() const { return neg_; }
+
+/**
+ * @brief Three-way comparison.
+ * @param o Other value.
+ * @return Negative, zero or positive.
+ */
+int BigInt::compare(const BigInt &o) const {
+  if (neg_ != o.neg_)
+    return neg_ ? -1 : 1;
+  const int c = BigIntOps::cmp(mag_, o.mag_);
+  return neg_ ? -c : c;
+}
+
+/**
+ * @brief Sum.
+ * @return a + b.
+ */
+BigInt operator+(const BigInt &a, const BigInt &b) {
+  BigInt r;
+  BigIntOps::signedAdd(a.mag_, a.neg_, b.mag_, b.neg_, r.mag_, r.neg_);
+  r.trim();
+  return r;
+}
+
+/**
+ * @brief Difference.
+ * @return a - b.
+ */
+BigInt operator-(const BigInt &a, const BigInt &b) {
+  BigInt r;
+  BigIntOps::signedAdd(a.mag_, a.neg_, b.mag_, !b.neg_ && !b.isZero(),
+                       r.mag_, r.neg_);
+  r.trim();
+  return r;
+}
+
+/**
+ * @brief Product.
+ * @return a * b.
+ */
+BigInt operator*(const BigInt &a, const BigInt &b) {
+  BigInt r;
+  r.mag_ = BigIntOps::mul(a.mag_.data(), a.mag_.size(), b.mag_.data(),
+                          b.mag_.size());
+  r.neg_ = a.neg_ != b.neg_;
+  r.trim();
+  return r;
+}
+
+/**
+ * @brief Negation.
+ * @return -a.
+ */
+BigInt operator-(const BigInt &a) {
+  BigInt r = a;
+  r.neg_ = !a.neg_ && !a.isZero();
+  return r;
+}
+
+/**
+ * @brief Truncating division.
+ * @param a Dividend.
+ * @param b Divisor.
+ * @return (a / b, a % b) or std::nullopt when b == 0.
+ */
+std::optional<std::pair<BigInt, BigInt>> BigInt::divMod(const BigInt &a,
+                                                        const BigInt &b) {
+  if (b.isZero())
+    return std::nullopt;
+  BigInt q, r;
+  BigIntOps::divMod(a.mag_, b.mag_, q.mag_, r.mag_);
+  q.neg_ = a.neg_ != b.neg_;
+  r.neg_ = a.neg_;
+  q.trim();
+  r.trim();
+  return std::make_pair(std::move(q), std::move(r));
+}
+
+/**
+ * @brief Greatest common divisor.
+ * @param a First value.
+ * @param b Second value.
+ * @return gcd(|a|, |b|) (0 when both are zero).
+ */
+BigInt BigInt::gcd(BigInt a, BigInt b) {
+  a.neg_ = false;
+  b.neg_ = false;
+  while (!b.isZero()) {
+    Limbs q, r;
+    BigIntOps::divMod(a.mag_, b.mag_, q, r);
+    a.mag_ = std::move(b.mag_);
+    b.mag_ = std::move(r);
+  }
+  return a;
+}
+
+/**
+ * @brief Integer square root.
+ * @param a Radicand.
+ * @return floor(sqrt(a)), or std::nullopt when a is negative.
+ */
+std::optional<BigInt> BigInt::isqrt(const BigInt &a) {
+  if (a.neg_)
+    return std::nullopt;
+  BigInt r;
+  if (!a.isZero())
+    r.mag_ = BigIntOps::sqrt(a.mag_);
+  return r;
+}
+
+/**
+ * @brief Shift by whole limbs.
+ * @param limbs Positive: multiply by kBase^limbs; negative: divide
+ *        (truncating toward zero).
+ * @return Shifted value.
+ */
+BigInt BigInt::shiftLimbs(std::ptrdiff_t limbs) const {
+  BigInt r;
+  r.mag_ = limbs >= 0
+               ? BigIntOps::shiftUp(mag_, static_cast<std::size_t>(limbs))
+               : BigIntOps::shiftDown(mag_, static_cast<std::size_t>(-limbs));
+  r.neg_ = neg_;
+  r.trim();
+  return r;
+}
+
+/** @brief Number of base-10^9 limbs of the magnitude (0 for zero). */
+std::size_t BigInt::limbCount() const { return mag_.size(); }
+
+/**
+ * @brief Multiply by a small factor in place.
+ * @param m Factor.
+ * @return *this.
+ */
+BigInt &BigInt::operator*=(std::uint32_t m) {
+  std::uint64_t carry = 0;
+  for (auto &limb : mag_) {
+    const std::uint64_t cur = static_cast<std::uint64_t>(limb) * m + carry;
+    carry = cur / kBase;
+    limb = static_cast<std::uint32_t>(cur - carry * kBase);
+  }
+  while (carry) {
+    mag_.push_back(static_cast<std::uint32_t>(carry % kBase));
+    carry /= kBase;
+  }
+  trim();
+  return *this;
+}
+
+/**
+ * @brief Truncating division by a small divisor in place.
+ * @param d Divisor (non-zero).
+ * @return Remainder of the magnitude.
+ */
+std::uint32_t BigInt::divideSmall(std::uint32_t d) {
+  std::uint64_t rem = 0;
+  for (std::size_t i = mag_.size(); i-- > 0;) {
+    const std::uint64_t cur = rem * kBase + mag_[i];
+    mag_[i] = static_cast<std::uint32_t>(cur / d);
+    rem = cur % d;
+  }
+  trim();
+  return static_cast<std::uint32_t>(rem);
+}
+
+/**
+ * @brief Balanced product tree.
+ * @param factors Values to multiply.
+ * @return Product (1 when empty).
+ */
+BigInt BigInt::product(std::vector<BigInt> factors) {
+  if (factors.empty())
+    return BigInt(1);
+  while (factors.size() > 1) {
+    std::size_t out = 0;
+    for (std::size_t i = 0; i + 1 < factors.size(); i += 2)
+      factors[out++] = factors[i] * factors[i + 1];
+    if (factors.size() % 2)
+      factors[out++] = std::move(factors.back());
+    factors.resize(out);
+  }
+  return std::move(factors.front());
+}
+
+/**
+ * @brief Product of the integers in [lo, hi] by binary splitting.
+ * @param lo First factor.
+ * @param hi Last factor.
+ * @return Product (1 when lo > hi).
+ */
+BigInt BigInt::rangeProduct(std::uint64_t lo, std::uint64_t hi) {
+  if (lo > hi)
+    return BigInt(1);
+  if (hi - lo < 8) {
+    BigInt r(1);
+    for (std::uint64_t k = lo; k <= hi; ++k)
+      r = r * fromInteger(static_cast<checked::Int>(k));
+    return r;
+  }
+  const std::uint64_t mid = lo + (hi - lo) / 2;
+  return rangeProduct(lo, mid) * rangeProduct(mid + 1, hi);
+}
+
+/**
+ * @brief Integer power.
+ * @param e Exponent.
+ * @return this^e.
+ */
+BigInt BigInt::pow(std::uint64_t e) const {
+  BigInt result(1), base = *this;
+  while (e) {
+    if (e & 1)
+      result = result * base;
+    e >>= 1;
+    if (e)
+      base = base * base;
+  }
+  return result;
+}
+
+/**
+ * @brief Normalise: drop leading zero limbs, zero is non-negative.
+ */
+void BigInt::trim() {
+  BigIntOps::trim(mag_);
+  if (mag_.empty())
+    neg_ = false;
+}
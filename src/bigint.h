@@ -0,0 +1,136 @@
+#pragma once
+#include "checked_int.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file bigint.h
+ * @brief Declaration of BigInt (arbitrary-precision signed integer).
+ *
+ * Magnitudes are stored little-endian in base 10^9 limbs, so decimal text
+ * conversion is linear-time (the calculator mostly prints its big results).
+ * Multiplication switches from schoolbook to Karatsuba and then to a
+ * three-prime NTT as operands grow; product() multiplies many factors as a
+ * balanced product tree so operand sizes stay matched. Large divisions and
+ * square roots use Newton's method, so they cost a few multiplications.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+class BigInt {
+public:
+  /// Limb radix.
+  static constexpr std::uint32_t kBase = 1000000000u;
+  /// Decimal digits per limb.
+  static constexpr int kBaseDigits = 9;
+
+  /** @brief Zero. */
+  BigInt() = default;
+  /** @brief From a native integer. @param v Value. */
+  explicit BigInt(long long v);
+  /** @brief From the engine's exact integer type. @param v Value. */
+  static BigInt fromInteger(checked::Int v);
+  /**
+   * @brief Parse an optionally signed decimal integer.
+   * @return Value, or std::nullopt if @p text is not an integer.
+   */
+  static std::optional<BigInt> fromString(const std::string &text);
+
+  /** @brief Decimal text (with '-' when negative). */
+  std::string toString() const;
+  /** @brief Number of decimal digits of the magnitude (1 for zero). */
+  std::size_t digitCount() const;
+  /** @brief Exact value if it fits in checked::Int. */
+  std::optional<checked::Int> toInteger() const;
+  /** @brief Nearest long double (may overflow to infinity). */
+  long double toLongDouble() const;
+
+  /** @brief Whether the value is zero. */
+  bool isZero() const;
+  /** @brief Whether the value is negative. */
+  bool isNegative() const;
+  /** @brief Three-way compare: <0, 0 or >0. */
+  int compare(const BigInt &o) const;
+
+  /** @brief Sum. */
+  friend BigInt operator+(const BigInt &a, const BigInt &b);
+  /** @brief Difference. */
+  friend BigInt operator-(const BigInt &a, const BigInt &b);
+  /** @brief Negation. */
+  friend BigInt operator-(const BigInt &a);
+  /** @brief Product (schoolbook, Karatsuba or NTT by size). */
+  friend BigInt operator*(const BigInt &a, const BigInt &b);
+  /** @brief Multiply in place by a small factor. */
+  BigInt &operator*=(std::uint32_t m);
+  /**
+   * @brief Divide in place by a small non-zero divisor (truncating).
+   * @return The remainder of the magnitude.
+   */
+  std::uint32_t divideSmall(std::uint32_t d);
+
+  friend bool operator==(const BigInt &a, const BigInt &b) {
+    return a.compare(b) == 0;
+  }
+  friend bool operator!=(const BigInt &a, const BigInt &b) {
+    return a.compare(b) != 0;
+  }
+  friend bool operator<(const BigInt &a, const BigInt &b) {
+    return a.compare(b) < 0;
+  }
+
+  /**
+   * @brief Truncating division (Knuth algorithm D on base-10^9 limbs).
+   * @return (quotient, remainder) with the remainder taking the dividend's
+   *         sign, or std::nullopt when @p b is zero.
+   */
+  static std::optional<std::pair<BigInt, BigInt>> divMod(const BigInt &a,
+                                                         const BigInt &b);
+
+  /**
+   * @brief Integer square root (Newton's method on top of divMod).
+   * @return floor(sqrt(a)), or std::nullopt when @p a is negative.
+   */
+  static std::optional<BigInt> isqrt(const BigInt &a);
+
+  /** @brief Greatest common divisor of |a| and |b| (Euclid on divMod). */
+  static BigInt gcd(BigInt a, BigInt b);
+
+  /**
+   * @brief Product of all factors as a balanced product tree.
+   * @param factors Values to multiply (consumed).
+   * @return The product (1 for an empty list).
+   */
+  static BigInt product(std::vector<BigInt> factors);
+
+  /**
+   * @brief Product lo * (lo + 1) * ... * hi by binary splitting.
+   * @return The product (1 if lo > hi).
+   */
+  static BigInt rangeProduct(std::uint64_t lo, std::uint64_t hi);
+
+  /** @brief this^e by repeated squaring. */
+  BigInt pow(std::uint64_t e) const;
+
+  /**
+   * @brief this * kBase^limbs; a negative count divides (truncating), which
+   *        makes base-10^9 fixed-point arithmetic cheap.
+   */
+  BigInt shiftLimbs(std::ptrdiff_t limbs) const;
+  /** @brief Number of base-10^9 limbs of the magnitude (0 for zero). */
+  std::size_t limbCount() const;
+
+private:
+  using Limbs = std::vector<std::uint32_t>;
+
+  /// Drop leading zero limbs (and the sign of zero).
+  void trim();
+
+  Limbs mag_;        ///< Magnitude, little-endian base-10^9 limbs.
+  bool neg_ = false; ///< Sign (false for zero).
+
+  friend class BigIntOps;
+};
@@ -0,0 +1,332 @@
+/**
+ * @file calculus.cpp
+ * @brief Implementation of adaptive Gauss–Kronrod integration and Ridders
+ *        differentiation.
+ *
+ * integrate() starts from a fixed uniform split of [a, b] (enough pieces
+ * to keep every worker busy from the start), fixes the tolerance from that
+ * first estimate and hands every piece whose error exceeds its
+ * length-proportional share to the work-stealing pool. A task either
+ * accepts its piece or bisects it and spawns the halves. If the refined
+ * integral turns out much smaller than the first estimate (cancellation),
+ * another round tightens the tolerance and re-queues the pieces that no
+ * longer meet it.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "calculus.h"
+#include "worksteal.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace calculus {
+namespace {
+
+// Kronrod abscissae on [-1, 1] (positive half, descending; last is 0).
+// Odd indices are the 7-point Gauss abscissae.
+constexpr double kXgk[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.0};
+// 15-point Kronrod weights.
+constexpr double kWgk[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+// 7-point Gauss weights for kXgk[1], kXgk[3], kXgk[5], kXgk[7].
+constexpr double kWg[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+constexpr std::size_t kNodes = 15;
+/// Pieces of the first pass; fixed so results do not depend on threads.
+constexpr std::size_t kInitial = 32;
+constexpr double kEps = std::numeric_limits<double>::epsilon();
+
+/// One subinterval with its Kronrod estimate and error.
+struct Piece {
+  double a = 0.0;
+  double b = 0.0;
+  double value = 0.0;
+  double error = 0.0;
+  double floor = 0.0; ///< Roundoff floor 50 eps |f|-integral (error >= it).
+};
+
+/// Nodes of [a, b] in the order gk15() expects (center, then +/- pairs).
+void nodes(double a, double b, double *x) {
+  const double center = 0.5 * (a + b);
+  const double half = 0.5 * (b - a);
+  x[0] = center;
+  for (int j = 0; j < 7; ++j) {
+    x[1 + 2 * j] = center - half * kXgk[j];
+    x[2 + 2 * j] = center + half * kXgk[j];
+  }
+}
+
+/**
+ * @brief QUADPACK QK15 rule from the 15 function values at nodes().
+ * @return false if a value is not finite.
+ */
+bool gk15(Piece &p, const double *fx) {
+  const double half = 0.5 * (p.b - p.a);
+  const double fc = fx[0];
+  double resk = fc * kWgk[7];
+  double resg = fc * kWg[3];
+  double resabs = std::fabs(resk);
+  bool finite = std::isfinite(fc);
+  for (int j = 0; j < 7; ++j) {
+    const double f1 = fx[1 + 2 * j], f2 = fx[2 + 2 * j];
+    finite = finite && std::isfinite(f1) && std::isfinite(f2);
+    resk += kWgk[j] * (f1 + f2);
+    resabs += kWgk[j] * (std::fabs(f1) + std::fabs(f2));
+    if (j % 2 == 1)
+      resg += kWg[j / 2] * (f1 + f2);
+  }
+  if (!finite)
+    return false;
+  const double reskh = 0.5 * resk;
+  double resasc = kWgk[7] * std::fabs(fc - reskh);
+  for (int j = 0; j < 7; ++j)
+    resasc += kWgk[j] * (std::fabs(fx[1 + 2 * j] - reskh) +
+                         std::fabs(fx[2 + 2 * j] - reskh));
+  const double scale = std::fabs(half);
+  resasc *= scale;
+  resabs *= scale;
+  double err = std::fabs((resk - resg) * half);
+  if (resasc != 0.0 && err != 0.0)
+    err = resasc * std::min(1.0, std::pow(200.0 * err / resasc, 1.5));
+  p.floor = 0.0;
+  if (resabs > std::numeric_limits<double>::min() / (50.0 * kEps))
+    p.floor = 50.0 * kEps * resabs;
+  p.value = resk * half;
+  p.error = std::max(p.floor, err);
+  return true;
+}
+
+/// Evaluate the rule on @p count pieces with a single batch call.
+bool evaluatePieces(const Expression &f, Piece *pieces, std::size_t count,
+                    std::vector<double> &xs, std::vector<double> &fx) {
+  xs.resize(count * kNodes);
+  fx.resize(count * kNodes);
+  for (std::size_t i = 0; i < count; ++i)
+    nodes(pieces[i].a, pieces[i].b, xs.data() + i * kNodes);
+  f.evaluateBatch(xs.data(), fx.data(), xs.size());
+  for (std::size_t i = 0; i < count; ++i)
+    if (!gk15(pieces[i], fx.data() + i * kNodes))
+      return false;
+  return true;
+}
+
+/**
+ * @brief Whether a piece needs no further bisection: its error fits its
+ *        @p density share, it is at its roundoff floor (bisecting cannot
+ *        help), or it is too short to split in double.
+ */
+bool done(const Piece &p, double density) {
+  return p.error <= std::max(density * (p.b - p.a), p.floor) ||
+         p.b - p.a <= 64.0 * kEps * std::max(std::fabs(p.a), std::fabs(p.b));
+}
+
+} // namespace
+
+/**
+ * @brief Adaptive parallel Gauss–Kronrod quadrature.
+ * @param f Integrand in one variable.
+ * @param a Lower limit.
+ * @param b Upper limit.
+ * @param options Tolerances, threads and interval cap.
+ * @return Estimate or std::nullopt (invalid input, non-finite integrand).
+ */
+std::optional<IntegrateResult> integrate(const Expression &f, double a,
+                                         double b,
+                                         const IntegrateOptions &options) {
+  if (f.variableCount() > 1 || !std::isfinite(a) || !std::isfinite(b) ||
+      !(options.relTol >= 0.0) || !(options.absTol >= 0.0) ||
+      (options.relTol == 0.0 && options.absTol == 0.0))
+    return std::nullopt;
+  const auto start = std::chrono::steady_clock::now();
+  IntegrateResult result;
+  if (a == b) {
+    result.converged = true;
+    return result;
+  }
+  const double sign = a < b ? 1.0 : -1.0;
+  if (b < a)
+    std::swap(a, b);
+  const double length = b - a;
+
+  // First pass: a uniform split gives the initial estimate and one root task
+  // per piece for the pool.
+  const unsigned workers = worksteal::workerCount(options.threads);
+  const std::size_t initial = kInitial;
+  std::vector<Piece> pieces(initial);
+  for (std::size_t i = 0; i < initial; ++i) {
+    pieces[i].a = a + length * static_cast<double>(i) / initial;
+    pieces[i].b = i + 1 == initial
+                      ? b
+                      : a + length * static_cast<double>(i + 1) / initial;
+  }
+  std::vector<double> xs, fx;
+  if (!evaluatePieces(f, pieces.data(), pieces.size(), xs, fx))
+    return std::nullopt;
+  std::atomic<std::size_t> evaluations(initial * kNodes);
+  std::atomic<std::size_t> intervals(initial);
+  std::atomic<bool> failed(false);
+  bool capped = false;
+
+  double floor = 0.0;
+  auto total = [&](const std::vector<Piece> &ps, double &err) {
+    // Kahan sum in left-to-right order, independent of the thread count.
+    double sum = 0.0, carry = 0.0;
+    err = 0.0;
+    floor = 0.0;
+    for (const Piece &p : ps) {
+      floor += p.floor;
+      const double y = p.value - carry;
+      const double t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+      err += p.error;
+    }
+    return sum;
+  };
+
+  double error = 0.0;
+  double value = total(pieces, error);
+  for (int round = 0; round < 4; ++round) {
+    const double target =
+        std::max({options.absTol, options.relTol * std::fabs(value), floor});
+    if (error <= target || capped)
+      break;
+    // Each piece may spend a share of the target proportional to its length.
+    const double density = target / length;
+    std::vector<Piece> accepted, pending;
+    for (const Piece &p : pieces)
+      (done(p, density) ? accepted : pending).push_back(p);
+
+    std::vector<std::vector<Piece>> finished(workers);
+    std::vector<std::vector<double>> scratchX(workers), scratchF(workers);
+    worksteal::run(
+        std::move(pending), workers,
+        [&](Piece &&p, const worksteal::Spawner<Piece> &spawn, unsigned w) {
+          if (failed.load(std::memory_order_relaxed))
+            return;
+          if (done(p, density) || intervals.load(std::memory_order_relaxed) >=
+                                      options.maxIntervals) {
+            finished[w].push_back(p);
+            return;
+          }
+          const double mid = 0.5 * (p.a + p.b);
+          Piece halves[2];
+          halves[0].a = p.a;
+          halves[0].b = mid;
+          halves[1].a = mid;
+          halves[1].b = p.b;
+          evaluations.fetch_add(2 * kNodes, std::memory_order_relaxed);
+          intervals.fetch_add(1, std::memory_order_relaxed);
+          if (!evaluatePieces(f, halves, 2, scratchX[w], scratchF[w])) {
+            failed.store(true, std::memory_order_relaxed);
+            return;
+          }
+          spawn(halves[0]);
+          spawn(halves[1]);
+        });
+    if (failed.load())
+      return std::nullopt;
+
+    pieces = std::move(accepted);
+    for (auto &d : finished)
+      pieces.insert(pieces.end(), d.begin(), d.end());
+    std::sort(pieces.begin(), pieces.end(),
+              [](const Piece &l, const Piece &r) { return l.a < r.a; });
+    capped = intervals.load() >= options.maxIntervals;
+    value = total(pieces, error);
+  }
+
+  result.value = sign * value;
+  result.error = error;
+  result.converged = error <= std::max({options.absTol,
+                                        options.relTol * std::fabs(value),
+                                        floor});
+  result.intervals = pieces.size();
+  result.evaluations = evaluations.load();
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return result;
+}
+
+/**
+ * @brief Ridders' extrapolation of central differences (Numerical Recipes
+ *        dfridr), generalized to the second derivative.
+ * @param f Expression in one variable.
+ * @param x Point.
+ * @param order 1 or 2.
+ * @param step Initial step (0 = automatic).
+ * @return Estimate or std::nullopt.
+ */
+std::optional<DerivativeResult> differentiate(const Expression &f, double x,
+                                              int order, double step) {
+  if (f.variableCount() > 1 || !std::isfinite(x) || (order != 1 && order != 2) ||
+      !(step >= 0.0) || !std::isfinite(step))
+    return std::nullopt;
+  constexpr int kTable = 10;       // extrapolation table size
+  constexpr long double kCon = 1.4L; // step shrink factor
+  constexpr long double kCon2 = kCon * kCon;
+  constexpr long double kSafe = 2.0L; // stop when error grows this much
+
+  DerivativeResult result;
+  long double h = step > 0.0 ? step : 0.1 * std::max(std::fabs(x), 1.0);
+  const long double lx = x;
+  const long double f0 = order == 2 ? f.evaluate(lx) : 0.0L;
+  result.evaluations = order == 2 ? 1 : 0;
+  bool finite = std::isfinite(static_cast<double>(f0));
+  // Central difference with step h (error expansion in even powers of h).
+  auto estimate = [&](long double step) {
+    const long double up = f.evaluate(lx + step);
+    const long double down = f.evaluate(lx - step);
+    result.evaluations += 2;
+    finite = finite && std::isfinite(static_cast<double>(up)) &&
+             std::isfinite(static_cast<double>(down));
+    return order == 1 ? (up - down) / (2.0L * step)
+                      : (up - 2.0L * f0 + down) / (step * step);
+  };
+
+  long double table[kTable][kTable];
+  table[0][0] = estimate(h);
+  long double best = table[0][0];
+  long double err = std::numeric_limits<long double>::max();
+  for (int i = 1; i < kTable; ++i) {
+    h /= kCon;
+    table[0][i] = estimate(h);
+    long double fac = kCon2;
+    for (int j = 1; j <= i; ++j) {
+      table[j][i] = (table[j - 1][i] * fac - table[j - 1][i - 1]) / (fac - 1.0L);
+      fac *= kCon2;
+      const long double errt =
+          std::max(std::fabs(table[j][i] - table[j - 1][i]),
+                   std::fabs(table[j][i] - table[j - 1][i - 1]));
+      if (errt <= err) {
+        err = errt;
+        best = table[j][i];
+      }
+    }
+    if (std::fabs(table[i][i] - table[i - 1][i - 1]) >= kSafe * err)
+      break;
+  }
+  if (!finite || !std::isfinite(static_cast<double>(best)))
+    return std::nullopt;
+  result.value = static_cast<double>(best);
+  result.error = static_cast<double>(err);
+  return result;
+}
+
+} // namespace calculus
@@ -0,0 +1,80 @@
+#pragma once
+#include "expression.h"
+#include <cstddef>
+#include <optional>
+
+/**
+ * @file calculus.h
+ * @brief Definite integrals and derivatives of a compiled Expression.
+ *
+ * Integration is globally adaptive Gauss–Kronrod (7-point Gauss embedded in
+ * 15-point Kronrod, QUADPACK's QK15 error estimate). Subintervals whose error
+ * exceeds their share of the tolerance (proportional to their length) are
+ * bisected; the pieces are processed by a work-stealing pool (worksteal.h),
+ * and each bisection evaluates both halves' 30 nodes in one batch call.
+ * Accepted pieces are summed in left-to-right order, so the result does not
+ * depend on the thread count.
+ *
+ * Derivatives use Ridders' Richardson extrapolation of central differences,
+ * which also yields an error estimate.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace calculus {
+
+/** @brief Knobs for integrate(). */
+struct IntegrateOptions {
+  double relTol = 1e-12;          ///< Target error relative to |integral|.
+  double absTol = 0.0;            ///< Absolute error that is always enough.
+  unsigned threads = 0;           ///< Worker count; 0 = all cores.
+  std::size_t maxIntervals = 1u << 20; ///< Subinterval cap (non-convergence).
+};
+
+/** @brief Integral estimate plus diagnostics. */
+struct IntegrateResult {
+  double value = 0.0;          ///< Integral estimate.
+  double error = 0.0;          ///< Estimated absolute error.
+  /// Whether the tolerance was met, or the error is down to the roundoff
+  /// floor of double (50 eps times the integral of |f|), whichever is larger.
+  bool converged = false;
+  std::size_t intervals = 0;   ///< Final number of subintervals.
+  std::size_t evaluations = 0; ///< Function evaluations.
+  double seconds = 0.0;        ///< Wall-clock duration.
+};
+
+/**
+ * @brief Definite integral of @p f over [a, b] (b < a gives the negative).
+ * @param f Expression in one variable (or constant).
+ * @param a Lower limit (finite).
+ * @param b Upper limit (finite).
+ * @param options Tolerances, threads and interval cap.
+ * @return Estimate, or std::nullopt for invalid input (more than one
+ *         variable, non-finite limits or tolerances) or when @p f is not
+ *         finite at a quadrature node.
+ */
+std::optional<IntegrateResult> integrate(const Expression &f, double a,
+                                         double b,
+                                         const IntegrateOptions &options = {});
+
+/** @brief Derivative estimate plus its extrapolation error. */
+struct DerivativeResult {
+  double value = 0.0;    ///< Derivative estimate.
+  double error = 0.0;    ///< Estimated absolute error.
+  int evaluations = 0;   ///< Function evaluations.
+};
+
+/**
+ * @brief Numerical derivative of @p f at @p x (Ridders' method).
+ * @param f Expression in one variable (or constant).
+ * @param x Point of evaluation.
+ * @param order 1 (f') or 2 (f'').
+ * @param step Initial step; 0 picks 0.1 * max(|x|, 1).
+ * @return Estimate, or std::nullopt for invalid input or when @p f is not
+ *         finite near @p x.
+ */
+std::optional<DerivativeResult> differentiate(const Expression &f, double x,
+                                              int order = 1,
+                                              double step = 0.0);
+
+} // namespace calculus
@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+
+/**
+ * @file checked_int.h
+ * @brief Native exact integer type with overflow-checked arithmetic.
+ *
+ * checked::Int is the widest native signed integer the compiler offers
+ * (__int128 on GCC/Clang, long long elsewhere). The helpers return false on
+ * overflow instead of wrapping, using the compiler's overflow builtins where
+ * available, so callers can promote to a wider representation only when
+ * needed.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace checked {
+
+#if defined(__SIZEOF_INT128__)
+using Int = __int128;               ///< Exact integer type.
+using UInt = unsigned __int128;     ///< Unsigned counterpart.
+#else
+using Int = long long;              ///< Exact integer type.
+using UInt = unsigned long long;    ///< Unsigned counterpart.
+#endif
+
+/// Largest representable value.
+constexpr Int kMax = static_cast<Int>(~static_cast<UInt>(0) >> 1);
+/// Smallest representable value.
+constexpr Int kMin = -kMax - 1;
+
+/** @brief out = a + b. @return false on overflow. */
+inline bool add(Int a, Int b, Int &out) {
+#if defined(__GNUC__) || defined(__clang__)
+  return !__builtin_add_overflow(a, b, &out);
+#else
+  if ((b > 0 && a > kMax - b) || (b < 0 && a < kMin - b))
+    return false;
+  out = a + b;
+  return true;
+#endif
+}
+
+/** @brief out = a - b. @return false on overflow. */
+inline bool sub(Int a, Int b, Int &out) {
+#if defined(__GNUC__) || defined(__clang__)
+  return !__builtin_sub_overflow(a, b, &out);
+#else
+  if ((b < 0 && a > kMax + b) || (b > 0 && a < kMin + b))
+    return false;
+  out = a - b;
+  return true;
+#endif
+}
+
+/** @brief out = a * b. @return false on overflow. */
+inline bool mul(Int a, Int b, Int &out) {
+#if defined(__GNUC__) || defined(__clang__)
+  return !__builtin_mul_overflow(a, b, &out);
+#else
+  // CERT INT32-C style pre-checks.
+  bool overflow;
+  if (a > 0)
+    overflow = b > 0 ? a > kMax / b : b < kMin / a;
+  else
+    overflow = b > 0 ? a < kMin / b : (a != 0 && b < kMax / a);
+  if (overflow)
+    return false;
+  out = a * b;
+  return true;
+#endif
+}
+
+/**
+ * @brief Exact division.
+ * @return false on division by zero, overflow (kMin / -1) or a non-zero
+ *         remainder.
+ */
+inline bool divExact(Int a, Int b, Int &out) {
+  if (b == 0 || (a == kMin && b == -1) || a % b != 0)
+    return false;
+  out = a / b;
+  return true;
+}
+
+/** @brief Magnitude as unsigned (well defined for kMin). */
+inline UInt magnitude(Int v) {
+  return v < 0 ? static_cast<UInt>(0) - static_cast<UInt>(v)
+               : static_cast<UInt>(v);
+}
+
+/** @brief Decimal text of @p v. */
+inline std::string toString(Int v) {
+  char buf[48];
+  char *p = buf + sizeof(buf);
+  UInt m = magnitude(v);
+  do {
+    *--p = static_cast<char>('0' + static_cast<int>(m % 10));
+    m /= 10;
+  } while (m != 0);
+  if (v < 0)
+    *--p = '-';
+  return std::string(p, buf + sizeof(buf));
+}
+
+/**
+ * @brief Parse an optionally signed decimal integer.
+ * @return The value, or std::nullopt if the text is not an integer or does
+ *         not fit in Int.
+ */
+inline std::optional<Int> parse(const std::string &text) {
+  std::size_t i = 0;
+  bool negative = false;
+  if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+    negative = text[i++] == '-';
+  if (i == text.size())
+    return std::nullopt;
+  Int v = 0;
+  for (; i < text.size(); ++i) {
+    const char c = text[i];
+    if (c < '0' || c > '9')
+      return std::nullopt;
+    // Accumulate negatively so kMin parses too.
+    if (!mul(v, 10, v) || !sub(v, c - '0', v))
+      return std::nullopt;
+  }
+  if (!negative && !mul(v, -1, v))
+    return std::nullopt;
+  return v;
+}
+
+} // namespace checked
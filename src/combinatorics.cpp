@@ -0,0 +1,188 @@
+/**
+ * @file combinatorics.cpp
+ * @brief Implementation of the prime-swing factorial and friends.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "combinatorics.h"
+#include "numbertheory.h"
+#include <mutex>
+
+namespace combinatorics {
+namespace {
+
+/// Exponent of prime p in n! (Legendre).
+std::uint64_t legendre(std::uint64_t n, std::uint64_t p) {
+  std::uint64_t e = 0;
+  while (n) {
+    n /= p;
+    e += n;
+  }
+  return e;
+}
+
+/**
+ * @brief Collects prime powers and multiplies them with a product tree.
+ *
+ * Small powers are packed into one machine word before they become BigInt
+ * leaves, which keeps the tree shallow.
+ */
+class PrimePowerProduct {
+public:
+  void add(std::uint64_t p, std::uint64_t e) {
+    for (; e > 0; --e) {
+      if (word_ > kWordLimit / p) // keep leaves within checked::Int
+        flush();
+      word_ *= p;
+    }
+  }
+
+  BigInt finish() {
+    flush();
+    return BigInt::product(std::move(leaves_));
+  }
+
+private:
+  void flush() {
+    if (word_ > 1)
+      leaves_.push_back(BigInt::fromInteger(static_cast<checked::Int>(word_)));
+    word_ = 1;
+  }
+
+  static constexpr std::uint64_t kWordLimit = UINT64_MAX >> 1;
+  std::uint64_t word_ = 1;
+  std::vector<BigInt> leaves_;
+};
+
+/// Primes <= n from the shared sieve.
+std::shared_ptr<const std::vector<std::uint32_t>> primesUpTo(std::uint64_t n) {
+  return numtheory::smallPrimes(static_cast<std::uint32_t>(n + 1));
+}
+
+/// swing(n) = n! / ((n/2)!)^2 from its prime factorization.
+BigInt swing(std::uint64_t n) {
+  PrimePowerProduct acc;
+  for (std::uint32_t p : *primesUpTo(n)) {
+    if (p > n)
+      break;
+    std::uint64_t e = 0;
+    for (std::uint64_t q = n / p; q > 0; q /= p)
+      e += q & 1;
+    acc.add(p, e);
+  }
+  return acc.finish();
+}
+
+std::mutex cacheMutex;
+std::vector<BigInt> factorialCache; ///< factorialCache[k] = k!
+
+BigInt factorialRec(std::uint64_t n) {
+  if (n < kCachedFactorials) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (factorialCache.empty())
+      factorialCache.push_back(BigInt(1));
+    while (factorialCache.size() <= n) {
+      BigInt next = factorialCache.back();
+      next *= static_cast<std::uint32_t>(factorialCache.size());
+      factorialCache.push_back(std::move(next));
+    }
+    return factorialCache[static_cast<std::size_t>(n)];
+  }
+  BigInt half = factorialRec(n / 2);
+  return half * half * swing(n);
+}
+
+} // namespace
+
+/**
+ * @brief Factorial via prime swing.
+ * @param n Argument.
+ * @return n! or std::nullopt when n > kMaxN.
+ */
+std::optional<BigInt> factorial(std::uint64_t n) {
+  if (n > kMaxN)
+    return std::nullopt;
+  return factorialRec(n);
+}
+
+/**
+ * @brief Binomial coefficient from Kummer exponents.
+ * @param n Set size.
+ * @param r Subset size.
+ * @return C(n, r).
+ */
+std::optional<BigInt> choose(std::uint64_t n, std::uint64_t r) {
+  if (n > kMaxN)
+    return std::nullopt;
+  if (r > n)
+    return BigInt(0);
+  PrimePowerProduct acc;
+  for (std::uint32_t p : *primesUpTo(n)) {
+    if (p > n)
+      break;
+    acc.add(p, legendre(n, p) - legendre(r, p) - legendre(n - r, p));
+  }
+  return acc.finish();
+}
+
+/**
+ * @brief Falling factorial by binary splitting.
+ * @param n Set size.
+ * @param r Number of picks.
+ * @return n! / (n - r)!.
+ */
+std::optional<BigInt> permutations(std::uint64_t n, std::uint64_t r) {
+  if (n > kMaxN)
+    return std::nullopt;
+  if (r > n)
+    return BigInt(0);
+  return BigInt::rangeProduct(n - r + 1, n);
+}
+
+/**
+ * @brief Catalan number.
+ * @param n Index.
+ * @return C(2n, n) / (n + 1).
+ */
+std::optional<BigInt> catalan(std::uint64_t n) {
+  if (n > kMaxN / 2)
+    return std::nullopt;
+  PrimePowerProduct acc;
+  for (std::uint32_t p : *primesUpTo(2 * n)) {
+    if (p > 2 * n)
+      break;
+    std::uint64_t e = legendre(2 * n, p) - 2 * legendre(n, p);
+    for (std::uint64_t m = n + 1; m % p == 0; m /= p)
+      --e; // divide out n + 1
+    acc.add(p, e);
+  }
+  return acc.finish();
+}
+
+/**
+ * @brief Multinomial coefficient.
+ * @param ks Group sizes.
+ * @return (sum ks)! / prod(ks!).
+ */
+std::optional<BigInt> multinomial(const std::vector<std::uint64_t> &ks) {
+  std::uint64_t total = 0;
+  for (std::uint64_t k : ks) {
+    if (k > kMaxN - total)
+      return std::nullopt;
+    total += k;
+  }
+  PrimePowerProduct acc;
+  for (std::uint32_t p : *primesUpTo(total)) {
+    if (p > total)
+      break;
+    std::uint64_t e = legendre(total, p);
+    for (std::uint64_t k : ks)
+      e -= legendre(k, p);
+    acc.add(p, e);
+  }
+  return acc.finish();
+}
+
+} // namespace combinatorics
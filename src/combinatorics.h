@@ -0,0 +1,46 @@
+#pragma once
+#include "bigint.h"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @file combinatorics.h
+ * @brief Exact factorials and combinatorial counts as BigInt.
+ *
+ * n! uses the prime-swing recursion n! = ((n/2)!)^2 * swing(n), where the
+ * swing factor is assembled from prime powers with a product tree. Binomial,
+ * Catalan and multinomial numbers are built directly from their prime
+ * factorizations (Legendre/Kummer exponents), so no large division is ever
+ * needed. Primes come from the cached sieve in numbertheory, and factorials
+ * below kCachedFactorials are cached.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace combinatorics {
+
+/// Largest argument accepted (bounded by the 32-bit prime sieve).
+constexpr std::uint64_t kMaxN = 100000000ull;
+/// Factorials below this are cached after first use.
+constexpr std::uint64_t kCachedFactorials = 256;
+
+/** @brief n!. @return std::nullopt if n > kMaxN. */
+std::optional<BigInt> factorial(std::uint64_t n);
+
+/** @brief Binomial coefficient C(n, r). @return 0 if r > n. */
+std::optional<BigInt> choose(std::uint64_t n, std::uint64_t r);
+
+/** @brief Permutations n! / (n - r)!. @return 0 if r > n. */
+std::optional<BigInt> permutations(std::uint64_t n, std::uint64_t r);
+
+/** @brief n-th Catalan number C(2n, n) / (n + 1). */
+std::optional<BigInt> catalan(std::uint64_t n);
+
+/**
+ * @brief Multinomial coefficient (k1 + ... + km)! / (k1! ... km!).
+ * @return std::nullopt if the sum overflows or exceeds kMaxN.
+ */
+std::optional<BigInt> multinomial(const std::vector<std::uint64_t> &ks);
+
+} // namespace combinatorics
@@ -0,0 +1,178 @@
+/**
+ * @file complexbatch.cpp
+ * @brief Implementation of the complex array kernels (SSE2 + scalar).
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "complexbatch.h"
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMPLEXBATCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace complexbatch {
+namespace {
+
+inline double *raw(Complex *p) { return reinterpret_cast<double *>(p); }
+inline const double *raw(const Complex *p) {
+  return reinterpret_cast<const double *>(p);
+}
+
+} // namespace
+
+/**
+ * @brief Interleaved multiply; one complex per SSE2 register:
+ *        [ar br - ai bi, ai br + ar bi] = a*[br,br] + swap(a)*[-bi,bi].
+ */
+void multiply(const Complex *a, const Complex *b, Complex *out,
+              std::size_t n) {
+  const double *pa = raw(a);
+  const double *pb = raw(b);
+  double *po = raw(out);
+  std::size_t i = 0;
+#ifdef COMPLEXBATCH_SSE2
+  const __m128d negRe = _mm_set_pd(0.0, -0.0);
+  for (; i < n; ++i) {
+    const __m128d va = _mm_loadu_pd(pa + 2 * i);
+    const __m128d vb = _mm_loadu_pd(pb + 2 * i);
+    const __m128d t1 = _mm_mul_pd(va, _mm_unpacklo_pd(vb, vb));
+    const __m128d t2 = _mm_mul_pd(_mm_shuffle_pd(va, va, 1),
+                                  _mm_unpackhi_pd(vb, vb));
+    _mm_storeu_pd(po + 2 * i, _mm_add_pd(t1, _mm_xor_pd(t2, negRe)));
+  }
+#endif
+  for (; i < n; ++i) {
+    const double ar = pa[2 * i], ai = pa[2 * i + 1];
+    const double br = pb[2 * i], bi = pb[2 * i + 1];
+    po[2 * i] = ar * br - ai * bi;
+    po[2 * i + 1] = ai * br + ar * bi;
+  }
+}
+
+/**
+ * @brief Interleaved divide: a * conj(b) (same shuffle as multiply with the
+ *        other sign) over the broadcast |b|^2.
+ */
+void divide(const Complex *a, const Complex *b, Complex *out, std::size_t n) {
+  const double *pa = raw(a);
+  const double *pb = raw(b);
+  double *po = raw(out);
+  std::size_t i = 0;
+#ifdef COMPLEXBATCH_SSE2
+  const __m128d negIm = _mm_set_pd(-0.0, 0.0);
+  for (; i < n; ++i) {
+    const __m128d va = _mm_loadu_pd(pa + 2 * i);
+    const __m128d vb = _mm_loadu_pd(pb + 2 * i);
+    const __m128d t1 = _mm_mul_pd(va, _mm_unpacklo_pd(vb, vb));
+    const __m128d t2 = _mm_mul_pd(_mm_shuffle_pd(va, va, 1),
+                                  _mm_unpackhi_pd(vb, vb));
+    const __m128d num = _mm_add_pd(t1, _mm_xor_pd(t2, negIm));
+    const __m128d sq = _mm_mul_pd(vb, vb);
+    const __m128d den = _mm_add_pd(sq, _mm_shuffle_pd(sq, sq, 1));
+    _mm_storeu_pd(po + 2 * i, _mm_div_pd(num, den));
+  }
+#endif
+  for (; i < n; ++i) {
+    const double ar = pa[2 * i], ai = pa[2 * i + 1];
+    const double br = pb[2 * i], bi = pb[2 * i + 1];
+    const double den = br * br + bi * bi;
+    po[2 * i] = (ar * br + ai * bi) / den;
+    po[2 * i + 1] = (ai * br - ar * bi) / den;
+  }
+}
+
+/**
+ * @brief Split multiply, two elements per SSE2 step.
+ */
+void multiply(const double *aRe, const double *aIm, const double *bRe,
+              const double *bIm, double *outRe, double *outIm,
+              std::size_t n) {
+  std::size_t i = 0;
+#ifdef COMPLEXBATCH_SSE2
+  for (; i + 2 <= n; i += 2) {
+    const __m128d ar = _mm_loadu_pd(aRe + i), ai = _mm_loadu_pd(aIm + i);
+    const __m128d br = _mm_loadu_pd(bRe + i), bi = _mm_loadu_pd(bIm + i);
+    _mm_storeu_pd(outRe + i,
+                  _mm_sub_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi)));
+    _mm_storeu_pd(outIm + i,
+                  _mm_add_pd(_mm_mul_pd(ai, br), _mm_mul_pd(ar, bi)));
+  }
+#endif
+  for (; i < n; ++i) {
+    const double ar = aRe[i], ai = aIm[i], br = bRe[i], bi = bIm[i];
+    outRe[i] = ar * br - ai * bi;
+    outIm[i] = ai * br + ar * bi;
+  }
+}
+
+/**
+ * @brief Split divide, two elements per SSE2 step.
+ */
+void divide(const double *aRe, const double *aIm, const double *bRe,
+            const double *bIm, double *outRe, double *outIm, std::size_t n) {
+  std::size_t i = 0;
+#ifdef COMPLEXBATCH_SSE2
+  for (; i + 2 <= n; i += 2) {
+    const __m128d ar = _mm_loadu_pd(aRe + i), ai = _mm_loadu_pd(aIm + i);
+    const __m128d br = _mm_loadu_pd(bRe + i), bi = _mm_loadu_pd(bIm + i);
+    const __m128d den = _mm_add_pd(_mm_mul_pd(br, br), _mm_mul_pd(bi, bi));
+    _mm_storeu_pd(outRe + i,
+                  _mm_div_pd(_mm_add_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi)),
+                             den));
+    _mm_storeu_pd(outIm + i,
+                  _mm_div_pd(_mm_sub_pd(_mm_mul_pd(ai, br), _mm_mul_pd(ar, bi)),
+                             den));
+  }
+#endif
+  for (; i < n; ++i) {
+    const double ar = aRe[i], ai = aIm[i], br = bRe[i], bi = bIm[i];
+    const double den = br * br + bi * bi;
+    outRe[i] = (ar * br + ai * bi) / den;
+    outIm[i] = (ai * br - ar * bi) / den;
+  }
+}
+
+/**
+ * @brief Pack split arrays into interleaved pairs.
+ */
+void interleave(const double *re, const double *im, Complex *out,
+                std::size_t n) {
+  double *po = raw(out);
+  std::size_t i = 0;
+#ifdef COMPLEXBATCH_SSE2
+  for (; i + 2 <= n; i += 2) {
+    const __m128d r = _mm_loadu_pd(re + i), m = _mm_loadu_pd(im + i);
+    _mm_storeu_pd(po + 2 * i, _mm_unpacklo_pd(r, m));
+    _mm_storeu_pd(po + 2 * i + 2, _mm_unpackhi_pd(r, m));
+  }
+#endif
+  for (; i < n; ++i) {
+    po[2 * i] = re[i];
+    po[2 * i + 1] = im[i];
+  }
+}
+
+/**
+ * @brief Unpack interleaved pairs into split arrays.
+ */
+void deinterleave(const Complex *in, double *re, double *im, std::size_t n) {
+  const double *pi = raw(in);
+  std::size_t i = 0;
+#ifdef COMPLEXBATCH_SSE2
+  for (; i + 2 <= n; i += 2) {
+    const __m128d x = _mm_loadu_pd(pi + 2 * i), y = _mm_loadu_pd(pi + 2 * i + 2);
+    _mm_storeu_pd(re + i, _mm_unpacklo_pd(x, y));
+    _mm_storeu_pd(im + i, _mm_unpackhi_pd(x, y));
+  }
+#endif
+  for (; i < n; ++i) {
+    re[i] = pi[2 * i];
+    im[i] = pi[2 * i + 1];
+  }
+}
+
+} // namespace complexbatch
@@ -0,0 +1,46 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+
+/**
+ * @file complexbatch.h
+ * @brief Vectorized element-wise complex arithmetic over arrays.
+ *
+ * Signal-processing style workloads keep complex samples either interleaved
+ * (re, im, re, im, ... i.e. an array of std::complex<double>) or split into
+ * separate real and imaginary arrays. Both layouts get multiply and divide
+ * kernels with SSE2 paths (scalar fallback elsewhere); in-place use
+ * (out == a or out == b) is allowed.
+ *
+ * Division uses the textbook formula a * conj(b) / |b|^2 without rescaling,
+ * which is what makes it vectorizable: magnitudes beyond ~1e154 may overflow
+ * and b == 0 yields inf/NaN. Use Engine::applyComplex for single values that
+ * need the careful path.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace complexbatch {
+
+/// Interleaved element type (layout-compatible with double[2]).
+using Complex = std::complex<double>;
+
+/** @brief out[i] = a[i] * b[i] (interleaved). */
+void multiply(const Complex *a, const Complex *b, Complex *out, std::size_t n);
+/** @brief out[i] = a[i] / b[i] (interleaved). */
+void divide(const Complex *a, const Complex *b, Complex *out, std::size_t n);
+
+/** @brief out[i] = a[i] * b[i] (split real/imaginary arrays). */
+void multiply(const double *aRe, const double *aIm, const double *bRe,
+              const double *bIm, double *outRe, double *outIm, std::size_t n);
+/** @brief out[i] = a[i] / b[i] (split real/imaginary arrays). */
+void divide(const double *aRe, const double *aIm, const double *bRe,
+            const double *bIm, double *outRe, double *outIm, std::size_t n);
+
+/** @brief Split layout -> interleaved. */
+void interleave(const double *re, const double *im, Complex *out,
+                std::size_t n);
+/** @brief Interleaved -> split layout. */
+void deinterleave(const Complex *in, double *re, double *im, std::size_t n);
+
+} // namespace complexbatch
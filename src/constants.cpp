@@ -0,0 +1,373 @@
+/**
+ * @file constants.cpp
+ * @brief Implementation of the binary-splitting constants and their cache.
+ *
+ * Every series is written as
+ *   S = sum_k  a(k) / b(k) * prod_{j<=k} p(j) / q(j),
+ * and split(a, b) returns the integers P, Q, B, T of the range [a, b) with
+ * S(a, b) = T / (B Q) (Haible and Papanikolaou). Values are then formed in
+ * fixed point with a scale of 10^(9 L), i.e. L whole BigInt limbs, so the
+ * scaling is a limb shift; two guard limbs absorb the truncation errors.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "constants.h"
+#include "bigint.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace constants {
+namespace {
+
+/// Limbs of guard precision below the requested digits.
+constexpr std::size_t kGuardLimbs = 2;
+/// Below this many terms a range is summed on the calling thread.
+constexpr std::uint64_t kMinParallelTerms = 64;
+
+/// Integers of one binary-splitting range: S = T / (B Q).
+struct Sums {
+  BigInt p, q, b, t;
+};
+
+/// Set when the caller gave up; the series then unwind with zeros.
+using Cancel = const std::atomic<bool> *;
+
+bool cancelled(Cancel cancel) {
+  return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Binary splitting over [a, b).
+ * @param term Fills the Sums of a single index.
+ * @param depth Recursion levels that still fork a thread.
+ * @param cancel Checked for every range; a cancelled range is all zeros.
+ */
+template <typename Term>
+Sums split(std::uint64_t a, std::uint64_t b, const Term &term,
+           unsigned depth, Cancel cancel) {
+  if (cancelled(cancel))
+    return {};
+  if (b - a == 1) {
+    Sums s;
+    term(a, s);
+    return s;
+  }
+  const std::uint64_t mid = a + (b - a) / 2;
+  const bool fork = depth > 0 && b - a >= kMinParallelTerms;
+  const unsigned next = depth > 0 ? depth - 1 : 0;
+  Sums l, r;
+  if (fork) {
+    std::thread left([&] { l = split(a, mid, term, next, cancel); });
+    r = split(mid, b, term, next, cancel);
+    left.join();
+  } else {
+    l = split(a, mid, term, 0, cancel);
+    r = split(mid, b, term, 0, cancel);
+  }
+  if (cancelled(cancel))
+    return {};
+
+  // T = Br Qr Tl + Bl Pl Tr; Q and the rest are plain products.
+  Sums s;
+  auto lower = [&] { s.q = l.q * r.q; };
+  std::thread other;
+  if (fork)
+    other = std::thread(lower);
+  else
+    lower();
+  s.t = r.b * r.q * l.t + l.b * l.p * r.t;
+  s.p = l.p * r.p;
+  s.b = l.b * r.b;
+  if (other.joinable())
+    other.join();
+  return s;
+}
+
+/// Thread levels for @p threads workers (each level doubles the workers).
+unsigned forkDepth(unsigned threads) {
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  unsigned depth = 0;
+  while ((1u << depth) < threads && depth < 8)
+    ++depth;
+  return depth;
+}
+
+/// pi * kBase^L by the Chudnovsky series.
+BigInt pi(std::size_t limbs, unsigned depth, Cancel cancel) {
+  const std::uint64_t terms =
+      static_cast<std::uint64_t>(limbs * BigInt::kBaseDigits / 14.18) + 2;
+  const auto term = [](std::uint64_t k, Sums &s) {
+    s.b = BigInt(1);
+    if (k == 0) {
+      s.p = s.q = BigInt(1);
+      s.t = BigInt(13591409);
+      return;
+    }
+    // p(k) = -(6k-5)(2k-1)(6k-1), q(k) = k^3 640320^3 / 24.
+    s.p = BigInt(static_cast<long long>(6 * k - 5));
+    s.p *= static_cast<std::uint32_t>(2 * k - 1);
+    s.p *= static_cast<std::uint32_t>(6 * k - 1);
+    s.p = -s.p;
+    s.q = BigInt(static_cast<long long>(k * k));
+    s.q *= static_cast<std::uint32_t>(k);
+    s.q *= 640320u;
+    s.q *= 640320u;
+    s.q *= 26680u; // 640320 / 24
+    s.t = BigInt(static_cast<long long>(13591409 + 545140134 * k)) * s.p;
+  };
+  const Sums s = split(0, terms, term, depth, cancel);
+  if (cancelled(cancel))
+    return {};
+  // pi = 426880 sqrt(10005) Q / T.
+  BigInt num = *BigInt::isqrt(BigInt(10005).shiftLimbs(
+                   2 * static_cast<std::ptrdiff_t>(limbs))) *
+               s.q;
+  num *= 426880u;
+  return BigInt::divMod(num, s.t)->first;
+}
+
+/// e * kBase^L as 1 + sum 1/k!.
+BigInt e(std::size_t limbs, unsigned depth, Cancel cancel) {
+  // Smallest N with log10(N!) beyond the requested precision.
+  const double target = static_cast<double>(limbs * BigInt::kBaseDigits) + 2;
+  std::uint64_t terms = 2;
+  while (std::lgamma(static_cast<double>(terms) + 1.0) / std::log(10.0) <
+         target)
+    terms = terms * 2;
+  std::uint64_t lo = terms / 2;
+  while (lo < terms) { // first N reaching the target
+    const std::uint64_t mid = lo + (terms - lo) / 2;
+    if (std::lgamma(static_cast<double>(mid) + 1.0) / std::log(10.0) < target)
+      lo = mid + 1;
+    else
+      terms = mid;
+  }
+  const auto term = [](std::uint64_t k, Sums &s) {
+    s.p = s.b = s.t = BigInt(1);
+    s.q = BigInt(static_cast<long long>(k));
+  };
+  const Sums s = split(1, terms + 1, term, depth, cancel);
+  if (cancelled(cancel))
+    return {};
+  const std::ptrdiff_t shift = static_cast<std::ptrdiff_t>(limbs);
+  return BigInt::divMod(s.t.shiftLimbs(shift), s.q)->first +
+         BigInt(1).shiftLimbs(shift);
+}
+
+/// atanh(1/x) * kBase^L = sum 1 / ((2k+1) x^(2k+1)).
+BigInt atanhInv(std::uint32_t x, std::size_t limbs, unsigned depth,
+                Cancel cancel) {
+  const double perTerm = 2.0 * std::log10(static_cast<double>(x));
+  const std::uint64_t terms = static_cast<std::uint64_t>(
+      static_cast<double>(limbs * BigInt::kBaseDigits) / perTerm) + 2;
+  const auto term = [x](std::uint64_t k, Sums &s) {
+    s.p = s.t = BigInt(1);
+    s.q = BigInt(static_cast<long long>(k == 0 ? x : std::uint64_t(x) * x));
+    s.b = BigInt(static_cast<long long>(2 * k + 1));
+  };
+  const Sums s = split(0, terms, term, depth, cancel);
+  if (cancelled(cancel))
+    return {};
+  return BigInt::divMod(s.t.shiftLimbs(static_cast<std::ptrdiff_t>(limbs)),
+                        s.b * s.q)
+      ->first;
+}
+
+/// ln(2) * kBase^L from three atanh series.
+BigInt ln2(std::size_t limbs, unsigned depth, Cancel cancel) {
+  BigInt a, b, c;
+  const unsigned inner = depth > 1 ? depth - 1 : 0;
+  auto first = [&] { a = atanhInv(26, limbs, inner, cancel); };
+  auto second = [&] { b = atanhInv(4801, limbs, inner, cancel); };
+  if (depth > 0) { // the three series are independent
+    std::thread t1(first), t2(second);
+    c = atanhInv(8749, limbs, depth - 1, cancel);
+    t1.join();
+    t2.join();
+  } else {
+    first();
+    second();
+    c = atanhInv(8749, limbs, 0, cancel);
+  }
+  a *= 18u;
+  b *= 2u;
+  c *= 8u;
+  return a - b + c;
+}
+
+/// c * kBase^L, truncated (up to the guard limbs' error). sqrt(2) has no
+/// series, so only the three series constants stop early on @p cancel.
+BigInt fixedPoint(Constant c, std::size_t limbs, unsigned depth,
+                  Cancel cancel) {
+  switch (c) {
+  case Constant::Pi:
+    return pi(limbs, depth, cancel);
+  case Constant::E:
+    return e(limbs, depth, cancel);
+  case Constant::Ln2:
+    return ln2(limbs, depth, cancel);
+  case Constant::Sqrt2:
+  default:
+    return *BigInt::isqrt(
+        BigInt(2).shiftLimbs(2 * static_cast<std::ptrdiff_t>(limbs)));
+  }
+}
+
+/// Leading digits every cache file must start with.
+const char *prefix(Constant c) {
+  switch (c) {
+  case Constant::Pi:
+    return "3.1415926535";
+  case Constant::E:
+    return "2.7182818284";
+  case Constant::Sqrt2:
+    return "1.4142135623";
+  case Constant::Ln2:
+  default:
+    return "0.6931471805";
+  }
+}
+
+std::string cachePath(Constant c, const Options &options) {
+  const std::string dir =
+      options.cacheDir.empty() ? defaultCacheDir() : options.cacheDir;
+  return dir.empty() ? std::string() : dir + "/" + name(c) + ".txt";
+}
+
+/// Up to @p bytes leading bytes of @p path.
+std::string readPrefix(const std::string &path, std::size_t bytes) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in)
+    return {};
+  const auto size = static_cast<std::size_t>(in.tellg());
+  std::string text(std::min(size, bytes), '\0');
+  in.seekg(0);
+  in.read(&text[0], static_cast<std::streamsize>(text.size()));
+  return in ? text : std::string();
+}
+
+/// Replace @p path atomically (write a sibling, then rename over it).
+void writeCache(const std::string &path, const std::string &text) {
+  std::error_code ec;
+  std::filesystem::create_directories(
+      std::filesystem::path(path).parent_path(), ec);
+  const std::string tmp = path + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out.write(text.data(), static_cast<std::streamsize>(text.size())))
+      return;
+  }
+  std::filesystem::rename(tmp, path, ec);
+  if (ec)
+    std::filesystem::remove(tmp, ec);
+}
+
+} // namespace
+
+/**
+ * @brief Short name of a constant.
+ * @param c Constant.
+ * @return "pi", "e", "sqrt2" or "ln2".
+ */
+const char *name(Constant c) {
+  switch (c) {
+  case Constant::Pi:
+    return "pi";
+  case Constant::E:
+    return "e";
+  case Constant::Sqrt2:
+    return "sqrt2";
+  case Constant::Ln2:
+  default:
+    return "ln2";
+  }
+}
+
+/**
+ * @brief Parse a short name.
+ * @param text "pi", "e", "sqrt2" or "ln2".
+ * @return The constant, or std::nullopt.
+ */
+std::optional<Constant> parse(std::string_view text) {
+  for (Constant c : {Constant::Pi, Constant::E, Constant::Sqrt2, Constant::Ln2})
+    if (text == name(c))
+      return c;
+  return std::nullopt;
+}
+
+/**
+ * @brief Per-user cache directory.
+ * @return Directory path, or "" when no home directory is known.
+ */
+std::string defaultCacheDir() {
+  if (const char *xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+    return std::string(xdg) + "/calculator";
+  if (const char *home = std::getenv("HOME"); home && *home)
+    return std::string(home) + "/.cache/calculator";
+  return {};
+}
+
+/**
+ * @brief Digits of a constant, from the cache when it holds enough.
+ * @return Text, or std::nullopt for an unsupported digit count or a
+ *         cancelled computation.
+ */
+std::optional<Result> compute(Constant c, std::size_t digits,
+                              const Options &options) {
+  if (digits == 0 || digits > kMaxDigits)
+    return std::nullopt;
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+  };
+  const std::size_t wanted = digits + 2; // "d." then the digits
+  const std::string path = options.useCache ? cachePath(c, options) : "";
+  if (!path.empty()) {
+    std::string text = readPrefix(path, wanted);
+    const std::string_view head(prefix(c));
+    if (text.size() == wanted &&
+        text.compare(0, std::min(head.size(), wanted), head, 0,
+                     std::min(head.size(), wanted)) == 0) {
+      Result r;
+      r.text = std::move(text);
+      r.cached = true;
+      r.seconds = elapsed();
+      return r;
+    }
+  }
+
+  const std::size_t limbs =
+      (digits + BigInt::kBaseDigits - 1) / BigInt::kBaseDigits + kGuardLimbs;
+  const BigInt value =
+      fixedPoint(c, limbs, forkDepth(options.threads), options.cancel);
+  if (cancelled(options.cancel))
+    return std::nullopt;
+  const std::string raw = value.toString();
+  // raw is floor(c * 10^(9 L)); every constant here is below 10.
+  const std::size_t fraction = limbs * BigInt::kBaseDigits;
+  std::string padded =
+      raw.size() > fraction ? raw : std::string(fraction + 1 - raw.size(), '0') + raw;
+  Result r;
+  r.text.reserve(wanted);
+  r.text.append(padded, 0, padded.size() - fraction);
+  r.text.push_back('.');
+  r.text.append(padded, padded.size() - fraction, digits);
+  // Reaching here means the cache was missing, too short or failed the
+  // check above, so it is replaced in every case.
+  if (!path.empty())
+    writeCache(path, r.text);
+  r.seconds = elapsed();
+  return r;
+}
+
+} // namespace constants
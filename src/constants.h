@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @file constants.h
+ * @brief pi, e, sqrt(2) and ln(2) to any number of decimal digits.
+ *
+ * Series constants are summed by binary splitting: the partial sums of a
+ * hypergeometric series are built as exact big-integer fractions over a
+ * balanced recursion, so the cost is dominated by a few large (NTT)
+ * multiplications near the top. The two halves of the upper recursion levels
+ * and their products run on separate threads. Square roots and the final
+ * division use BigInt's Newton iterations.
+ *
+ * - pi: Chudnovsky, about 14 digits per term.
+ * - e: sum of 1/k!.
+ * - ln(2): 18 atanh(1/26) - 2 atanh(1/4801) + 8 atanh(1/8749).
+ * - sqrt(2): integer square root of 2 * 10^(2n).
+ *
+ * Results are cached on disk (one text file per constant holding the most
+ * digits computed so far), so a repeated or shorter request only reads a
+ * prefix of that file.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace constants {
+
+/** @brief Supported constants. */
+enum class Constant { Pi, E, Sqrt2, Ln2 };
+
+/// Largest supported request (decimal digits after the point).
+constexpr std::size_t kMaxDigits = 100000000;
+
+/** @brief Knobs for compute(). */
+struct Options {
+  unsigned threads = 0;  ///< Worker count; 0 = all cores.
+  bool useCache = true;  ///< Read and update the disk cache.
+  std::string cacheDir;  ///< Cache directory; empty = defaultCacheDir().
+  /// Polled as the series are summed; once set, compute() gives up.
+  const std::atomic<bool> *cancel = nullptr;
+};
+
+/** @brief Digits plus diagnostics. */
+struct Result {
+  std::string text;     ///< "3.1415..." with the requested digits.
+  double seconds = 0.0; ///< Wall-clock duration.
+  bool cached = false;  ///< Whether the digits came from the disk cache.
+};
+
+/** @brief Short name ("pi", "e", "sqrt2", "ln2"), also the cache file name. */
+const char *name(Constant c);
+
+/** @brief Constant from its short name. */
+std::optional<Constant> parse(std::string_view text);
+
+/**
+ * @brief $XDG_CACHE_HOME/calculator, else $HOME/.cache/calculator.
+ * @return The directory, or an empty string when neither is set.
+ */
+std::string defaultCacheDir();
+
+/**
+ * @brief Decimal expansion of @p c, truncated after @p digits fractional
+ *        digits.
+ * @return Text, or std::nullopt if @p digits is 0 or above kMaxDigits or
+ *         when options.cancel was set.
+ */
+std::optional<Result> compute(Constant c, std::size_t digits,
+                              const Options &options = {});
+
+} // namespace constants
@@ -0,0 +1,145 @@
+/**
+ * @file convert_main.cpp
+ * @brief Headless streaming base converter (calculator_convert).
+ *
+ * Memory-maps the input, converts it in parallel chunks with
+ * baseconv::convert and streams the result with large unbuffered writes.
+ * Throughput is reported on stderr.
+ *
+ * Usage:
+ *   calculator_convert --from FMT --to FMT [--threads N] [--chunk-mb M]
+ *                      INPUT [OUTPUT]
+ *
+ * FMT is one of bytes, dec, hex, oct, bin. OUTPUT defaults to stdout ("-").
+ * A file OUTPUT is written to OUTPUT.tmp and renamed into place only when
+ * the whole conversion succeeds, so a failed run leaves no partial output.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#include "baseconv.h"
+#include "mappedfile.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+void usage() {
+  std::fprintf(stderr,
+               "usage: calculator_convert --from FMT --to FMT [--threads N]\n"
+               "                          [--chunk-mb M] INPUT [OUTPUT]\n"
+               "FMT: bytes | dec | hex | oct | bin\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::optional<baseconv::Format> from, to;
+  baseconv::Options options;
+  std::string input, output = "-";
+  int positional = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--from" && hasValue) {
+      from = baseconv::parseFormat(argv[++i]);
+    } else if (arg == "--to" && hasValue) {
+      to = baseconv::parseFormat(argv[++i]);
+    } else if (arg == "--threads" && hasValue) {
+      options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--chunk-mb" && hasValue) {
+      options.chunkBytes =
+          std::max<std::size_t>(1, std::strtoul(argv[++i], nullptr, 10)) << 20;
+    } else if (arg.size() > 1 && arg[0] == '-' && arg != "-") {
+      usage();
+      return 1;
+    } else if (positional == 0) {
+      input = arg;
+      ++positional;
+    } else if (positional == 1) {
+      output = arg;
+      ++positional;
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (!from || !to || input.empty()) {
+    usage();
+    return 1;
+  }
+
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  if (output != "-" && fs::equivalent(input, output, ec)) {
+    // Replacing the input would throw away the data being converted (and
+    // truncating it would pull the pages out from under the mapping).
+    std::fprintf(stderr, "calculator_convert: OUTPUT must differ from INPUT\n");
+    return 1;
+  }
+
+  std::string error;
+  auto file = MappedFile::open(input, &error);
+  if (!file) {
+    std::fprintf(stderr, "calculator_convert: %s\n", error.c_str());
+    return 1;
+  }
+
+  // Regular (or new) files go through a sibling temporary; devices and
+  // pipes such as /dev/null are written directly. A symlink is followed so
+  // the rename replaces the file it names, not the link.
+  if (output != "-" && fs::is_symlink(fs::symlink_status(output, ec))) {
+    const fs::path resolved = fs::canonical(output, ec);
+    if (!ec)
+      output = resolved.string();
+  }
+  const fs::file_status status = fs::status(output, ec);
+  const bool replace = output != "-" && (!fs::exists(status) ||
+                                         fs::is_regular_file(status));
+  const std::string target = replace ? output + ".tmp" : output;
+  std::FILE *out = output == "-" ? stdout : std::fopen(target.c_str(), "wb");
+  if (!out) {
+    std::fprintf(stderr, "calculator_convert: %s: %s\n", target.c_str(),
+                 std::strerror(errno));
+    return 1;
+  }
+  // Chunks arrive as multi-megabyte blocks; write them straight through.
+  std::setvbuf(out, nullptr, _IONBF, 0);
+
+  const auto stats = baseconv::convert(
+      file->data(), file->size(), *from, *to,
+      [out](const char *p, std::size_t n) {
+        return std::fwrite(p, 1, n, out) == n;
+      },
+      options, &error);
+  const bool closed = out == stdout ? std::fflush(out) == 0
+                                    : std::fclose(out) == 0;
+  if (!stats || !closed) {
+    std::fprintf(stderr, "calculator_convert: %s\n",
+                 stats ? "output write failed" : error.c_str());
+    if (replace)
+      fs::remove(target, ec);
+    return 1;
+  }
+  if (replace) {
+    fs::rename(target, output, ec);
+    if (ec) {
+      std::fprintf(stderr, "calculator_convert: %s: %s\n", output.c_str(),
+                   ec.message().c_str());
+      fs::remove(target, ec);
+      return 1;
+    }
+  }
+
+  const double gb = static_cast<double>(stats->bytesIn) / 1e9;
+  std::fprintf(stderr, "%.3f GB in -> %.3f GB out in %.3f s (%.2f GB/s)\n",
+               gb, static_cast<double>(stats->bytesOut) / 1e9, stats->seconds,
+               stats->seconds > 0 ? gb / stats->seconds : 0.0);
+  return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+
+/**
+ * @file decimal.h
+ * @brief Shortest round-trip decimal formatting and exact parsing of double
+ *        and long double.
+ *
+ * format() writes the shortest decimal that reads back as exactly the same
+ * value. Doubles use the Schubfach algorithm (R. Giulietti): one 64x128-bit
+ * multiplication per bound against a table of 128-bit powers of ten, with
+ * no loops over digits and no big integers. Long doubles that are whole
+ * numbers below 2^64, or that have a short decimal form (at most 15 or so
+ * digits, as typed values do), are found with a few exact multiplications;
+ * any other long double defers to std::to_chars, which is exact but several
+ * times slower. Both are laid out the same way: fixed notation for decimal
+ * exponents in [-7, 21), otherwise scientific ("1.5e+30"), with no trailing
+ * zeros and "inf" / "nan" for the special values.
+ *
+ * parse() follows std::from_chars (the longest prefix that forms a number,
+ * general format, "inf", "infinity" and "nan" in any case) and also accepts
+ * a leading '+'. Results are correctly rounded. Up to 19 significant digits
+ * with a small decimal exponent take Clinger's fast path (the digits and
+ * the power of ten are exact, so one multiplication rounds correctly); other
+ * doubles go to std::from_chars, and other long doubles start from an
+ * estimate and are settled by comparing against the halfway points in
+ * exact integer arithmetic on the stack.
+ *
+ * Neither side consults the locale or allocates.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace decimal {
+
+/// Room format() needs at its output: it stores kMaxChars bytes at once,
+/// of which at most 30 are text (no terminator is added).
+constexpr std::size_t kMaxChars = 32;
+
+/**
+ * @brief Shortest round-trip text of @p value.
+ * @param out Room for kMaxChars characters.
+ * @return One past the last character written.
+ */
+char *format(char *out, double value);
+
+/** @copydoc format(char *, double) */
+char *format(char *out, long double value);
+
+/**
+ * @brief Format @p n doubles, each followed by @p separator.
+ * @param out Room for n * (kMaxChars + 1) characters.
+ * @return Characters written.
+ */
+std::size_t formatBatch(const double *values, std::size_t n, char separator,
+                        char *out);
+
+/**
+ * @brief Parse a decimal number at the start of [first, last).
+ * @return ptr past the number and errc() on success; first and
+ *         errc::invalid_argument if there is no number;
+ *         errc::result_out_of_range when it overflows (value is then ±inf)
+ *         or underflows to zero.
+ */
+std::from_chars_result parse(const char *first, const char *last,
+                             double &value);
+
+/** @copydoc parse(const char *, const char *, double &) */
+std::from_chars_result parse(const char *first, const char *last,
+                             long double &value);
+
+} // namespace decimal
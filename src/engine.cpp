@@ -11,40 +11,65 @@
  */
 
 #include "engine.h"
+#include "combinatorics.h"
+#include "complexbatch.h"
+#include "numbertheory.h"
+#include "units.h"
 #include <cmath>
+#include <limits>
 #include <random>
 
+namespace {
+/// Result of the Real core as the interface's long double.
+template <typename T> std::optional<long double> widen(std::optional<T> r) {
+  if (!r)
+    return std::nullopt;
+  return static_cast<long double>(*r);
+}
+
+/// Whether both parts of @p z are finite.
+bool isFinite(const Engine::Complex &z) {
+  return std::isfinite(z.real()) && std::isfinite(z.imag());
+}
+} // namespace
+
 // --- State management ---
 /**
  * @brief Reset all state (operands, operator, flags).
  */
 void Engine::clear() {
-  value1_ = 0.0L;
-  value2_ = 0.0L;
-  op_ = Op::None;
-  hasV1_ = false;
-  hasV2_ = false;
+  real_.clear();
+  int1_ = 0;
+  int2_ = 0;
+  isInt1_ = false;
+  isInt2_ = false;
+  imag1_ = 0.0L;
+  imag2_ = 0.0L;
+  rat1_.reset();
+  rat2_.reset();
 }
 
 /**
  * @brief Set the current operator.
  * @param op Operator to set.
  */
-void Engine::setOp(Op op) { op_ = op; }
+void Engine::setOp(Op op) { real_.setOp(op); }
 
 /**
  * @brief Get the current operator.
  * @return Current operator value.
  */
-Engine::Op Engine::op() const { return op_; }
+Engine::Op Engine::op() const { return real_.op(); }
 
 /**
  * @brief Set the first operand value.
  * @param v Value to set as first operand.
  */
 void Engine::setValue1(long double v) {
-  value1_ = v;
-  hasV1_ = true;
+  real_.setValue1(static_cast<Real>(v));
+  imag1_ = 0.0L;
+  rat1_.reset();
+  isInt1_ = BasicEngine<long double>::toInteger(v, int1_);
 }
 
 /**
@@ -52,76 +77,247 @@ void Engine::setValue1(long double v) {
  * @param v Value to set as second operand.
  */
 void Engine::setValue2(long double v) {
-  value2_ = v;
-  hasV2_ = true;
+  real_.setValue2(static_cast<Real>(v));
+  imag2_ = 0.0L;
+  rat2_.reset();
+  isInt2_ = BasicEngine<long double>::toInteger(v, int2_);
+}
+
+/**
+ * @brief Set the first operand from an exact integer.
+ * @param v Value to set; value1 receives it rounded to Real.
+ */
+void Engine::setInteger1(Integer v) {
+  int1_ = v;
+  isInt1_ = true;
+  real_.setValue1(static_cast<Real>(v));
+  imag1_ = 0.0L;
+  rat1_.reset();
+}
+
+/**
+ * @brief Set the second operand from an exact integer.
+ * @param v Value to set; value2 receives it rounded to Real.
+ */
+void Engine::setInteger2(Integer v) {
+  int2_ = v;
+  isInt2_ = true;
+  real_.setValue2(static_cast<Real>(v));
+  imag2_ = 0.0L;
+  rat2_.reset();
+}
+
+/**
+ * @brief Set the first operand to a complex value.
+ * @param v Value to set; the integer shadow only applies to real integers.
+ */
+void Engine::setComplex1(Complex v) {
+  real_.setValue1(static_cast<Real>(v.real()));
+  imag1_ = v.imag();
+  rat1_.reset();
+  isInt1_ =
+      imag1_ == 0.0L && BasicEngine<long double>::toInteger(v.real(), int1_);
+}
+
+/**
+ * @brief Set the second operand to a complex value.
+ * @param v Value to set; the integer shadow only applies to real integers.
+ */
+void Engine::setComplex2(Complex v) {
+  real_.setValue2(static_cast<Real>(v.real()));
+  imag2_ = v.imag();
+  rat2_.reset();
+  isInt2_ =
+      imag2_ == 0.0L && BasicEngine<long double>::toInteger(v.real(), int2_);
+}
+
+/**
+ * @brief Set the first operand to an exact fraction.
+ * @param v Value to set; integral values also fill the integer shadow.
+ */
+void Engine::setRational1(const Rational &v) {
+  real_.setValue1(static_cast<Real>(v.toLongDouble()));
+  imag1_ = 0.0L;
+  rat1_ = v;
+  isInt1_ = false;
+  if (v.isInteger())
+    if (const auto n = v.numerator().toInteger()) {
+      int1_ = *n;
+      isInt1_ = true;
+    }
+}
+
+/**
+ * @brief Set the second operand to an exact fraction.
+ * @param v Value to set; integral values also fill the integer shadow.
+ */
+void Engine::setRational2(const Rational &v) {
+  real_.setValue2(static_cast<Real>(v.toLongDouble()));
+  imag2_ = 0.0L;
+  rat2_ = v;
+  isInt2_ = false;
+  if (v.isInteger())
+    if (const auto n = v.numerator().toInteger()) {
+      int2_ = *n;
+      isInt2_ = true;
+    }
+}
+
+/**
+ * @brief Exact first operand as a fraction.
+ * @return rat1_ if set, else the integer shadow, else std::nullopt.
+ */
+std::optional<Rational> Engine::rational1() const {
+  if (!hasV1())
+    return std::nullopt;
+  if (rat1_)
+    return rat1_;
+  if (isInt1_)
+    return Rational::fromInteger(int1_);
+  return std::nullopt;
+}
+
+/**
+ * @brief Exact second operand as a fraction.
+ * @return rat2_ if set, else the integer shadow, else std::nullopt.
+ */
+std::optional<Rational> Engine::rational2() const {
+  if (!hasV2())
+    return std::nullopt;
+  if (rat2_)
+    return rat2_;
+  if (isInt2_)
+    return Rational::fromInteger(int2_);
+  return std::nullopt;
+}
+
+/**
+ * @brief First operand as a complex number.
+ * @return (value1, imag1_).
+ */
+Engine::Complex Engine::complex1() const { return {value1(), imag1_}; }
+
+/**
+ * @brief Second operand as a complex number.
+ * @return (value2, imag2_).
+ */
+Engine::Complex Engine::complex2() const { return {value2(), imag2_}; }
+
+/**
+ * @brief Check whether complex evaluation is required.
+ * @return True if a present operand has an imaginary part.
+ */
+bool Engine::isComplex() const {
+  return (hasV1() && imag1_ != 0.0L) || (hasV2() && imag2_ != 0.0L);
+}
+
+/**
+ * @brief Exact first operand.
+ * @return int1_ when value1 is set and integral, else std::nullopt.
+ */
+std::optional<Engine::Integer> Engine::integer1() const {
+  if (!hasV1() || !isInt1_)
+    return std::nullopt;
+  return int1_;
+}
+
+/**
+ * @brief Exact second operand.
+ * @return int2_ when value2 is set and integral, else std::nullopt.
+ */
+std::optional<Engine::Integer> Engine::integer2() const {
+  if (!hasV2() || !isInt2_)
+    return std::nullopt;
+  return int2_;
 }
 
 /**
  * @brief Get the first operand value.
  * @return The first operand.
  */
-long double Engine::value1() const { return value1_; }
+long double Engine::value1() const {
+  return static_cast<long double>(real_.value1());
+}
 
 /**
  * @brief Get the second operand value.
  * @return The second operand.
  */
-long double Engine::value2() const { return value2_; }
+long double Engine::value2() const {
+  return static_cast<long double>(real_.value2());
+}
 
 /**
  * @brief Check if first operand is set.
  * @return True if first operand is set, false otherwise.
  */
-bool Engine::hasV1() const { return hasV1_; }
+bool Engine::hasV1() const { return real_.hasV1(); }
 
 /**
  * @brief Check if second operand is set.
  * @return True if second operand is set, false otherwise.
  */
-bool Engine::hasV2() const { return hasV2_; }
+bool Engine::hasV2() const { return real_.hasV2(); }
 
 // --- Arithmetic ops ---
 /**
  * @brief Add value1 and value2.
- * @return Sum of operands, or std::nullopt if operands missing.
+ * @return Sum of operands, or std::nullopt if operands missing
+ * or complex (see evaluateComplex()).
  */
 std::optional<long double> Engine::add() const {
-  if (!hasV1_ || !hasV2_)
+  if (!hasV1() || !hasV2() || isComplex())
     return std::nullopt;
-  return value1_ + value2_;
+  if (isInt1_ && isInt2_) { // integer fast path, exact until it overflows
+    if (auto exact = applyInteger(Op::Add, int1_, int2_))
+      return static_cast<long double>(*exact);
+  }
+  return widen(real_.add());
 }
 
 /**
  * @brief Subtract value2 from value1.
- * @return Difference of operands, or std::nullopt if operands missing.
+ * @return Difference of operands, or std::nullopt if operands missing
+ * or complex (see evaluateComplex()).
  */
 std::optional<long double> Engine::sub() const {
-  if (!hasV1_ || !hasV2_)
+  if (!hasV1() || !hasV2() || isComplex())
     return std::nullopt;
-  return value1_ - value2_;
+  if (isInt1_ && isInt2_) { // integer fast path, exact until it overflows
+    if (auto exact = applyInteger(Op::Sub, int1_, int2_))
+      return static_cast<long double>(*exact);
+  }
+  return widen(real_.sub());
 }
 
 /**
  * @brief Multiply value1 by value2.
- * @return Product of operands, or std::nullopt if operands missing.
+ * @return Product of operands, or std::nullopt if operands missing
+ * or complex (see evaluateComplex()).
  */
 std::optional<long double> Engine::mul() const {
-  if (!hasV1_ || !hasV2_)
+  if (!hasV1() || !hasV2() || isComplex())
     return std::nullopt;
-  return value1_ * value2_;
+  if (isInt1_ && isInt2_) { // integer fast path, exact until it overflows
+    if (auto exact = applyInteger(Op::Mul, int1_, int2_))
+      return static_cast<long double>(*exact);
+  }
+  return widen(real_.mul());
 }
 
 /**
  * @brief Divide value1 by value2.
- * @return Quotient of operands, or std::nullopt if operands missing or division
- * by zero.
+ * @return Quotient of operands, or std::nullopt if operands missing, complex
+ * or division by zero.
  */
 std::optional<long double> Engine::div() const {
-  if (!hasV1_ || !hasV2_)
+  if (!hasV1() || !hasV2() || isComplex())
     return std::nullopt;
-  if (value2_ == 0.0L)
-    return std::nullopt;
-  return value1_ / value2_;
+  if (isInt1_ && isInt2_) { // exact when the quotient is whole
+    if (auto exact = applyInteger(Op::Div, int1_, int2_))
+      return static_cast<long double>(*exact);
+  }
+  return widen(real_.div());
 }
 
 // --- Base ops (value1-only passthrough; UI handles formatting) ---
@@ -131,9 +327,9 @@ std::optional<long double> Engine::div() const {
  * @return value1 if set, else std::nullopt.
  */
 std::optional<long double> Engine::toDec() const {
-  if (!hasV1_)
+  if (!hasV1())
     return std::nullopt;
-  return value1_;
+  return value1();
 }
 
 /**
@@ -142,9 +338,9 @@ std::optional<long double> Engine::toDec() const {
  * @return value1 if set, else std::nullopt.
  */
 std::optional<long double> Engine::toHex() const {
-  if (!hasV1_)
+  if (!hasV1())
     return std::nullopt;
-  return value1_;
+  return value1();
 }
 
 /**
@@ -153,9 +349,9 @@ std::optional<long double> Engine::toHex() const {
  * @return value1 if set, else std::nullopt.
  */
 std::optional<long double> Engine::toOct() const {
-  if (!hasV1_)
+  if (!hasV1())
     return std::nullopt;
-  return value1_;
+  return value1();
 }
 
 /**
@@ -164,9 +360,9 @@ std::optional<long double> Engine::toOct() const {
  * @return value1 if set, else std::nullopt.
  */
 std::optional<long double> Engine::toBin() const {
-  if (!hasV1_)
+  if (!hasV1())
     return std::nullopt;
-  return value1_;
+  return value1();
 }
 
 /**
@@ -192,7 +388,7 @@ std::optional<long double> Engine::random(long long int max) const {
  * operands.
  */
 std::optional<long double> Engine::evaluate() const {
-  switch (op_) {
+  switch (op()) {
   case Op::Add:
     return add();
   case Op::Sub:
@@ -211,8 +407,597 @@ std::optional<long double> Engine::evaluate() const {
     return toBin();
   case Op::Random:
     return random(999999); // default max if not specified
+  case Op::Gcd:
+  case Op::Lcm: {
+    auto r = op() == Op::Gcd ? gcd() : lcm();
+    if (!r)
+      return std::nullopt;
+    return static_cast<long double>(*r);
+  }
+  case Op::Pow:
+    if (!hasV1() || !hasV2() || isComplex())
+      return std::nullopt;
+    if (isInt1_ && isInt2_) {
+      if (auto exact = applyInteger(Op::Pow, int1_, int2_))
+        return static_cast<long double>(*exact);
+    }
+    return widen(real_.evaluate());
   case Op::None:
   default:
     return std::nullopt;
   }
 }
+
+/**
+ * @brief Apply a binary arithmetic operator to explicit operands.
+ * @param op Operator to apply (Add, Sub, Mul, Div, Gcd, Lcm, Pow).
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return Result, or std::nullopt for division by zero or non-arithmetic ops.
+ * @note Runs in the build-time tier (BasicEngine<Real>).
+ */
+std::optional<long double> Engine::apply(Op op, long double a, long double b) {
+  return widen(
+      BasicEngine<Real>::apply(op, static_cast<Real>(a), static_cast<Real>(b)));
+}
+
+/**
+ * @brief Exact integer evaluation of the current operator.
+ * @return Exact result or std::nullopt (non-integral operands, overflow,
+ * inexact division, missing operands or non-arithmetic op).
+ */
+std::optional<Engine::Integer> Engine::evaluateInteger() const {
+  if (!hasV1() || !hasV2() || !isInt1_ || !isInt2_)
+    return std::nullopt;
+  return applyInteger(op(), int1_, int2_);
+}
+
+/**
+ * @brief Checked integer arithmetic.
+ * @param op Operator to apply (Add, Sub, Mul, Div, Gcd, Lcm, Pow).
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return Exact result or std::nullopt on overflow / inexact division.
+ */
+std::optional<Engine::Integer> Engine::applyInteger(Op op, Integer a,
+                                                    Integer b) {
+  Integer r = 0;
+  bool ok = false;
+  switch (op) {
+  case Op::Add:
+    ok = checked::add(a, b, r);
+    break;
+  case Op::Sub:
+    ok = checked::sub(a, b, r);
+    break;
+  case Op::Mul:
+    ok = checked::mul(a, b, r);
+    break;
+  case Op::Div:
+    ok = checked::divExact(a, b, r);
+    break;
+  case Op::Gcd:
+    return numtheory::gcd(a, b);
+  case Op::Lcm:
+    return numtheory::lcm(a, b);
+  case Op::Pow: {
+    if (b < 0)
+      return std::nullopt; // not an integer (except for |a| == 1)
+    // Square-and-multiply; the base is only squared while bits remain, so
+    // its overflow implies the result's.
+    r = 1;
+    ok = true;
+    for (Integer base = a; ok; ) {
+      if (b & 1)
+        ok = checked::mul(r, base, r);
+      b >>= 1;
+      if (!b)
+        break;
+      ok = ok && checked::mul(base, base, base);
+    }
+    break;
+  }
+  default:
+    break;
+  }
+  if (!ok)
+    return std::nullopt;
+  return r;
+}
+
+/**
+ * @brief Exact integer evaluation of the current operator in BigInt.
+ * @return Exact result or std::nullopt (non-integral or missing operands,
+ * inexact division, unsupported exponent or non-arithmetic op).
+ */
+std::optional<BigInt> Engine::evaluateBigInteger() const {
+  if (!hasV1() || !hasV2() || !isInt1_ || !isInt2_)
+    return std::nullopt;
+  return applyBigInteger(op(), BigInt::fromInteger(int1_),
+                         BigInt::fromInteger(int2_));
+}
+
+/**
+ * @brief Unbounded integer arithmetic.
+ * @param op Operator to apply (Add, Sub, Mul, Div, Gcd, Lcm, Pow).
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return Exact result or std::nullopt on inexact division / bad exponent.
+ */
+std::optional<BigInt> Engine::applyBigInteger(Op op, const BigInt &a,
+                                              const BigInt &b) {
+  switch (op) {
+  case Op::Add:
+    return a + b;
+  case Op::Sub:
+    return a - b;
+  case Op::Mul:
+    return a * b;
+  case Op::Div: {
+    auto qr = BigInt::divMod(a, b);
+    if (!qr || !qr->second.isZero())
+      return std::nullopt;
+    return qr->first;
+  }
+  case Op::Gcd:
+    return BigInt::gcd(a, b);
+  case Op::Lcm: {
+    if (a.isZero() || b.isZero())
+      return BigInt();
+    BigInt r = BigInt::divMod(a, BigInt::gcd(a, b))->first * b;
+    return r.isNegative() ? -r : r;
+  }
+  case Op::Pow: {
+    const auto e = b.toInteger();
+    if (!e || *e < 0 || *e > kMaxRationalExponent)
+      return std::nullopt;
+    return a.pow(static_cast<std::uint64_t>(*e));
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
+/**
+ * @brief Complex evaluation of the current operator.
+ * @return Result or std::nullopt (missing operands, a / 0, undefined power or
+ * an operator without complex meaning).
+ */
+std::optional<Engine::Complex> Engine::evaluateComplex() const {
+  if (!isComplex()) {
+    if (auto r = evaluate())
+      return Complex(*r, 0.0L);
+    // Real powers of negative bases continue on the complex plane.
+    if (op() != Op::Pow || !hasV1() || !hasV2())
+      return std::nullopt;
+  }
+  if (!hasV1() || !hasV2())
+    return std::nullopt;
+  return applyComplex(op(), complex1(), complex2());
+}
+
+/**
+ * @brief Complex arithmetic on explicit operands.
+ * @param op Operator to apply (Add, Sub, Mul, Div, Pow).
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return Result or std::nullopt for a / 0, undefined powers or other ops.
+ */
+std::optional<Engine::Complex> Engine::applyComplex(Op op, Complex a,
+                                                    Complex b) {
+  switch (op) {
+  case Op::Add:
+    return a + b;
+  case Op::Sub:
+    return a - b;
+  case Op::Mul:
+    return a * b;
+  case Op::Div:
+    if (b == Complex(0.0L))
+      return std::nullopt;
+    return a / b;
+  case Op::Pow:
+    return complexPow(a, b);
+  default:
+    return std::nullopt;
+  }
+}
+
+/**
+ * @brief Element-wise complex arithmetic over interleaved arrays.
+ * @param op Operator to apply (Add, Sub, Mul, Div, Pow).
+ * @param a Left operands.
+ * @param b Right operands.
+ * @param out Output array.
+ * @param n Element count.
+ * @return false for non-arithmetic ops.
+ */
+bool Engine::applyComplexBatch(Op op, const std::complex<double> *a,
+                               const std::complex<double> *b,
+                               std::complex<double> *out, std::size_t n) {
+  switch (op) {
+  case Op::Mul:
+    complexbatch::multiply(a, b, out, n);
+    return true;
+  case Op::Div:
+    complexbatch::divide(a, b, out, n);
+    return true;
+  case Op::Add:
+  case Op::Sub:
+  case Op::Pow:
+    for (std::size_t i = 0; i < n; ++i) {
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      const auto r = applyComplex(op, Complex(a[i]), Complex(b[i]));
+      out[i] = r ? std::complex<double>(*r) : std::complex<double>(nan, nan);
+    }
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Element-wise complex arithmetic over split arrays.
+ * @return false for non-arithmetic ops.
+ */
+bool Engine::applyComplexBatch(Op op, const double *aRe, const double *aIm,
+                               const double *bRe, const double *bIm,
+                               double *outRe, double *outIm, std::size_t n) {
+  switch (op) {
+  case Op::Mul:
+    complexbatch::multiply(aRe, aIm, bRe, bIm, outRe, outIm, n);
+    return true;
+  case Op::Div:
+    complexbatch::divide(aRe, aIm, bRe, bIm, outRe, outIm, n);
+    return true;
+  case Op::Add:
+  case Op::Sub:
+  case Op::Pow:
+    for (std::size_t i = 0; i < n; ++i) {
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      const auto r = applyComplex(op, Complex(aRe[i], aIm[i]),
+                                  Complex(bRe[i], bIm[i]));
+      outRe[i] = r ? static_cast<double>(r->real()) : nan;
+      outIm[i] = r ? static_cast<double>(r->imag()) : nan;
+    }
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Exact fraction evaluation of the current operator.
+ * @return Reduced result or std::nullopt (operand without an exact form,
+ * a / 0, unsupported power or non-arithmetic op).
+ */
+std::optional<Rational> Engine::evaluateRational() const {
+  const auto a = rational1();
+  const auto b = rational2();
+  if (!a || !b)
+    return std::nullopt;
+  return applyRational(op(), *a, *b);
+}
+
+/**
+ * @brief Exact rational arithmetic on explicit operands.
+ * @param op Operator to apply (Add, Sub, Mul, Div, Pow).
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return Result or std::nullopt for a / 0, unsupported powers or other ops.
+ */
+std::optional<Rational> Engine::applyRational(Op op, const Rational &a,
+                                              const Rational &b) {
+  switch (op) {
+  case Op::Add:
+    return a + b;
+  case Op::Sub:
+    return a - b;
+  case Op::Mul:
+    return a * b;
+  case Op::Div:
+    return Rational::divide(a, b);
+  case Op::Pow: {
+    // Only integral exponents keep the result rational.
+    if (!b.isInteger())
+      return std::nullopt;
+    const auto e = b.numerator().toInteger();
+    if (!e || *e > kMaxRationalExponent || *e < -kMaxRationalExponent)
+      return std::nullopt;
+    return a.pow(static_cast<long long>(*e));
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
+// --- Complex functions ---
+/**
+ * @brief Principal square root.
+ * @param z Argument.
+ * @return sqrt(z), or std::nullopt if z is not finite.
+ */
+std::optional<Engine::Complex> Engine::complexSqrt(Complex z) {
+  const Complex r = std::sqrt(z);
+  if (!isFinite(r))
+    return std::nullopt;
+  return r;
+}
+
+/**
+ * @brief Complex exponential.
+ * @param z Argument.
+ * @return e^z, or std::nullopt on overflow.
+ */
+std::optional<Engine::Complex> Engine::complexExp(Complex z) {
+  const Complex r = std::exp(z);
+  if (!isFinite(r))
+    return std::nullopt;
+  return r;
+}
+
+/**
+ * @brief Principal natural logarithm.
+ * @param z Argument.
+ * @return ln|z| + i arg z, or std::nullopt for z == 0.
+ */
+std::optional<Engine::Complex> Engine::complexLog(Complex z) {
+  if (z == Complex(0.0L))
+    return std::nullopt;
+  const Complex r = std::log(z);
+  if (!isFinite(r))
+    return std::nullopt;
+  return r;
+}
+
+/**
+ * @brief Principal power.
+ * @param z Base.
+ * @param w Exponent.
+ * @return z^w, or std::nullopt when undefined or not finite.
+ */
+std::optional<Engine::Complex> Engine::complexPow(Complex z, Complex w) {
+  if (z == Complex(0.0L)) {
+    if (w == Complex(0.0L))
+      return Complex(1.0L);
+    if (w.real() > 0.0L)
+      return Complex(0.0L);
+    return std::nullopt;
+  }
+  Complex r;
+  const long double n = w.real();
+  if (w.imag() == 0.0L && std::trunc(n) == n && std::fabs(n) <= 64.0L) {
+    // Small integral exponents: repeated squaring keeps Gaussian integers
+    // exact, where e^(w ln z) would leave rounding noise in the zero part.
+    unsigned long e = static_cast<unsigned long>(std::fabs(n));
+    Complex base = z;
+    r = Complex(1.0L);
+    for (; e; e >>= 1) {
+      if (e & 1)
+        r *= base;
+      base *= base;
+    }
+    if (n < 0.0L)
+      r = Complex(1.0L) / r;
+  } else {
+    r = std::exp(w * std::log(z));
+  }
+  if (!isFinite(r))
+    return std::nullopt;
+  return r;
+}
+
+// --- Number theory ---
+/**
+ * @brief GCD of the stored operands.
+ * @return gcd or std::nullopt if an operand is missing or not integral.
+ */
+std::optional<Engine::Integer> Engine::gcd() const {
+  if (!hasV1() || !hasV2() || !isInt1_ || !isInt2_)
+    return std::nullopt;
+  return applyInteger(Op::Gcd, int1_, int2_);
+}
+
+/**
+ * @brief LCM of the stored operands.
+ * @return lcm or std::nullopt if missing, not integral or overflowing.
+ */
+std::optional<Engine::Integer> Engine::lcm() const {
+  if (!hasV1() || !hasV2() || !isInt1_ || !isInt2_)
+    return std::nullopt;
+  return applyInteger(Op::Lcm, int1_, int2_);
+}
+
+/**
+ * @brief Modular exponentiation.
+ * @param base Base.
+ * @param exp Exponent.
+ * @param m Modulus.
+ * @return base^exp mod m or std::nullopt when m == 0.
+ */
+std::optional<std::uint64_t> Engine::modPow(std::uint64_t base,
+                                            std::uint64_t exp,
+                                            std::uint64_t m) {
+  return numtheory::modPow(base, exp, m);
+}
+
+/**
+ * @brief Modular inverse.
+ * @param a Value to invert.
+ * @param m Modulus.
+ * @return Inverse or std::nullopt when gcd(a, m) != 1.
+ */
+std::optional<std::uint64_t> Engine::modInverse(std::uint64_t a,
+                                                std::uint64_t m) {
+  return numtheory::modInverse(a, m);
+}
+
+/**
+ * @brief Primality test.
+ * @param n Candidate.
+ * @return true if n is prime.
+ */
+bool Engine::isPrime(std::uint64_t n) { return numtheory::isPrime(n); }
+
+/**
+ * @brief Prime factorization.
+ * @param n Value to factor.
+ * @return Sorted (prime, exponent) pairs.
+ */
+std::vector<std::pair<std::uint64_t, unsigned>>
+Engine::factorize(std::uint64_t n) {
+  return numtheory::factorize(n);
+}
+
+/**
+ * @brief Factorial.
+ * @param n Argument.
+ * @return n! or std::nullopt when n is out of range.
+ */
+std::optional<BigInt> Engine::factorial(std::uint64_t n) {
+  return combinatorics::factorial(n);
+}
+
+/**
+ * @brief Binomial coefficient.
+ * @param n Set size.
+ * @param r Subset size.
+ * @return C(n, r) or std::nullopt when n is out of range.
+ */
+std::optional<BigInt> Engine::choose(std::uint64_t n, std::uint64_t r) {
+  return combinatorics::choose(n, r);
+}
+
+/**
+ * @brief Permutations.
+ * @param n Set size.
+ * @param r Number of picks.
+ * @return P(n, r) or std::nullopt when n is out of range.
+ */
+std::optional<BigInt> Engine::permutations(std::uint64_t n, std::uint64_t r) {
+  return combinatorics::permutations(n, r);
+}
+
+/**
+ * @brief Catalan number.
+ * @param n Index.
+ * @return Catalan(n) or std::nullopt when n is out of range.
+ */
+std::optional<BigInt> Engine::catalan(std::uint64_t n) {
+  return combinatorics::catalan(n);
+}
+
+/**
+ * @brief Multinomial coefficient.
+ * @param ks Group sizes.
+ * @return Multinomial coefficient or std::nullopt when the total is too large.
+ */
+std::optional<BigInt>
+Engine::multinomial(const std::vector<std::uint64_t> &ks) {
+  return combinatorics::multinomial(ks);
+}
+
+/**
+ * @brief Digits of a constant (computed or read from the disk cache).
+ * @return Digits, or std::nullopt for an unsupported digit count.
+ */
+std::optional<constants::Result>
+Engine::constant(constants::Constant c, std::size_t digits,
+                 const std::string &cacheDir,
+                 const std::atomic<bool> *cancel) {
+  constants::Options options;
+  options.cacheDir = cacheDir;
+  options.cancel = cancel;
+  return constants::compute(c, digits, options);
+}
+
+/**
+ * @brief Net present value.
+ * @param rate Rate per period.
+ * @param amounts Flow at the end of each period (the first undiscounted).
+ * @return NPV or std::nullopt for rate <= -1.
+ */
+std::optional<long double>
+Engine::npv(long double rate, const std::vector<long double> &amounts) {
+  return finance::npv(rate, amounts);
+}
+
+/**
+ * @brief Internal rate of return.
+ * @param amounts Periodic flows.
+ * @param guess Start point (selects the root when there are several).
+ * @return Rate or std::nullopt.
+ */
+std::optional<long double> Engine::irr(const std::vector<long double> &amounts,
+                                       long double guess) {
+  return finance::irr(amounts, guess);
+}
+
+/**
+ * @brief Net present value of dated flows.
+ * @param rate Annual rate.
+ * @param amounts Flows.
+ * @param days Day number of each flow.
+ * @return XNPV or std::nullopt.
+ */
+std::optional<long double>
+Engine::xnpv(long double rate, const std::vector<long double> &amounts,
+             const std::vector<std::int64_t> &days) {
+  return finance::xnpv(rate, amounts, days);
+}
+
+/**
+ * @brief Internal rate of return of dated flows.
+ * @param amounts Flows.
+ * @param days Day number of each flow.
+ * @param guess Start point.
+ * @return Annual rate or std::nullopt.
+ */
+std::optional<long double>
+Engine::xirr(const std::vector<long double> &amounts,
+             const std::vector<std::int64_t> &days, long double guess) {
+  return finance::xirr(amounts, days, guess);
+}
+
+/**
+ * @brief Level payment.
+ * @param rate Rate per period.
+ * @param periods Number of periods.
+ * @param presentValue Present value.
+ * @param futureValue Value after the last payment.
+ * @param atStart Payments due at the start of each period.
+ * @return Payment or std::nullopt.
+ */
+std::optional<long double> Engine::pmt(long double rate, long double periods,
+                                       long double presentValue,
+                                       long double futureValue, bool atStart) {
+  return finance::pmt(rate, periods, presentValue, futureValue, atStart);
+}
+
+/**
+ * @brief Amortization schedule rows.
+ * @param loan Loan terms.
+ * @param first First row (period first + 1).
+ * @param count Number of rows.
+ * @param out Column arrays of @p count values.
+ * @return false for an invalid loan or range.
+ */
+bool Engine::amortize(const finance::Loan &loan, std::uint64_t first,
+                      std::size_t count, const finance::Rows &out) {
+  return finance::schedule(loan, first, count, out);
+}
+
+/**
+ * @brief Unit conversion in long double (factors are resolved in double).
+ * @return Converted value, or std::nullopt for invalid/incompatible units.
+ */
+std::optional<long double> Engine::convertUnits(long double value,
+                                                std::string_view from,
+                                                std::string_view to) {
+  const auto c = units::conversion(from, to);
+  if (!c)
+    return std::nullopt;
+  return (value * static_cast<long double>(c->scale) +
+          static_cast<long double>(c->offset)) /
+         static_cast<long double>(c->divisor);
+}
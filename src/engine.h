@@ -1,5 +1,16 @@
 #pragma once
+#include "basicengine.h"
+#include "bigint.h"
+#include "checked_int.h"
+#include "constants.h"
+#include "finance.h"
+#include "rational.h"
+#include <complex>
+#include <cstdint>
 #include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 /**
  * @file engine.h
@@ -9,29 +20,40 @@
  * methods to evaluate results. It is intentionally UI-agnostic; formatting and
  * presentation are handled by the UI layer (e.g., UICalculator).
  *
+ * Alongside the long double operands the engine tracks an exact integer
+ * shadow (checked::Int, 128-bit where supported) while values stay integral.
+ * Add/Sub/Mul/Pow (and Div when exact) then run on native checked integer
+ * arithmetic. evaluateInteger() returns that exact result; on overflow
+ * evaluateBigInteger() carries it on in BigInt. The long double add()/sub()/
+ * mul()/div() round the exact result and fall back to Real on overflow.
+ *
+ * Operands may also carry an imaginary part. As soon as one does, results
+ * come from evaluateComplex() (std::complex<long double>); the real-valued
+ * add/sub/mul/div then decline with std::nullopt instead of dropping it.
+ *
+ * The operands, the operator and the real arithmetic live in a
+ * BasicEngine<Real> core, where Real is the tier chosen at build time
+ * (CALCULATOR_PRECISION, long double by default; see precision.h). The
+ * public interface stays in long double, so only the rounding of real
+ * results changes with the tier.
+ *
+ * In fraction mode operands are exact Rationals and evaluateRational()
+ * keeps results as reduced fractions (1/3 * 3 is exactly 1).
+ *
  * @author Giovanni Daniel Mendez Sanchez (B54354)
  * @date 2025-09-24
  */
 class Engine {
 public:
-  /**
-   * @brief Supported operations for the engine.
-   * - Arithmetic: Add, Sub, Mul, Div
-   * - Base conversions: ToDec, ToHex, ToOct (UI formats the string; engine
-   *   only passes through the numeric value1_ when present)
-   */
-  enum class Op {
-    None,
-    Add,
-    Sub,
-    Mul,
-    Div,
-    ToDec,
-    ToHex,
-    ToOct,
-    ToBin,
-    Random
-  };
+  /// Exact integer representation used by the integer fast path.
+  using Integer = checked::Int;
+  /// Complex operand/result type.
+  using Complex = std::complex<long double>;
+
+  /// Real type of the arithmetic core (the build-time precision tier).
+  using Real = precision::Real<kDefaultPrecision>;
+  /// Supported operations (see EngineOp).
+  using Op = EngineOp;
 
   // --- State management ---
   /** @brief Reset all internal state (operands and operator). */
@@ -46,9 +68,53 @@ public:
   void setValue1(long double v);
   /** @brief Set second operand and mark it present. @param v Operand value. */
   void setValue2(long double v);
-  /** @brief Get first operand. @return value1_. */
+  /**
+   * @brief Set first operand from an exact integer (keeps all its digits).
+   * @param v Operand value.
+   */
+  void setInteger1(Integer v);
+  /**
+   * @brief Set second operand from an exact integer (keeps all its digits).
+   * @param v Operand value.
+   */
+  void setInteger2(Integer v);
+  /** @brief Exact first operand, if it is integral and representable. */
+  std::optional<Integer> integer1() const;
+  /** @brief Exact second operand, if it is integral and representable. */
+  std::optional<Integer> integer2() const;
+  /**
+   * @brief Set first operand to a complex value.
+   * @param v Operand value (real part also becomes value1).
+   */
+  void setComplex1(Complex v);
+  /**
+   * @brief Set second operand to a complex value.
+   * @param v Operand value (real part also becomes value2).
+   */
+  void setComplex2(Complex v);
+  /** @brief First operand including its imaginary part. */
+  Complex complex1() const;
+  /** @brief Second operand including its imaginary part. */
+  Complex complex2() const;
+  /** @brief Whether a present operand has a non-zero imaginary part. */
+  bool isComplex() const;
+  /**
+   * @brief Set first operand to an exact fraction.
+   * @param v Operand value (value1 receives its long double approximation).
+   */
+  void setRational1(const Rational &v);
+  /**
+   * @brief Set second operand to an exact fraction.
+   * @param v Operand value (value2 receives its long double approximation).
+   */
+  void setRational2(const Rational &v);
+  /** @brief Exact first operand as a fraction, if it has one. */
+  std::optional<Rational> rational1() const;
+  /** @brief Exact second operand as a fraction, if it has one. */
+  std::optional<Rational> rational2() const;
+  /** @brief Get first operand. @return value1. */
   long double value1() const;
-  /** @brief Get second operand. @return value2_. */
+  /** @brief Get second operand. @return value2. */
   long double value2() const;
   /** @brief Whether first operand is present. */
   bool hasV1() const;
@@ -57,23 +123,23 @@ public:
 
   // --- Arithmetic operations (use stored operands) ---
   /**
-   * @brief Sum of value1_ and value2_.
+   * @brief Sum of value1 and value2.
    * @return Result if both operands are present; std::nullopt otherwise.
    */
   std::optional<long double> add() const;
   /**
-   * @brief Difference value1_ - value2_.
+   * @brief Difference value1 - value2.
    * @return Result if both operands are present; std::nullopt otherwise.
    */
   std::optional<long double> sub() const;
   /**
-   * @brief Product value1_ * value2_.
+   * @brief Product value1 * value2.
    * @return Result if both operands are present; std::nullopt otherwise.
    */
   std::optional<long double> mul() const;
   /**
-   * @brief Quotient value1_ / value2_.
-   * @return Result if both operands are present and value2_ != 0; std::nullopt
+   * @brief Quotient value1 / value2.
+   * @return Result if both operands are present and value2 != 0; std::nullopt
    *         on division by zero or missing inputs.
    */
   std::optional<long double>
@@ -81,26 +147,26 @@ public:
 
   // --- Base/display related operations (act on value1 only) ---
   /**
-   * @brief Identity over value1_ when present (UI formats as decimal).
-   * @return value1_ if present; std::nullopt otherwise.
+   * @brief Identity over value1 when present (UI formats as decimal).
+   * @return value1 if present; std::nullopt otherwise.
    */
   std::optional<long double> toDec() const; // returns value1 if present
   /**
-   * @brief Identity over value1_ when present (UI formats as hexadecimal).
-   * @return value1_ if present; std::nullopt otherwise.
+   * @brief Identity over value1 when present (UI formats as hexadecimal).
+   * @return value1 if present; std::nullopt otherwise.
    */
   std::optional<long double>
   toHex() const; // value1 passthrough; UI formats base
   /**
-   * @brief Identity over value1_ when present (UI formats as octal).
-   * @return value1_ if present; std::nullopt otherwise.
+   * @brief Identity over value1 when present (UI formats as octal).
+   * @return value1 if present; std::nullopt otherwise.
    */
   std::optional<long double>
   toOct() const; // value1 passthrough; UI formats base
 
   /**
-   * @brief Identity over value1_ when present (UI formats as binary).
-   * @return value1_ if present; std::nullopt otherwise.
+   * @brief Identity over value1 when present (UI formats as binary).
+   * @return value1 if present; std::nullopt otherwise.
    */
   std::optional<long double>
   toBin() const; // value1 passthrough; UI formats base
@@ -112,6 +178,148 @@ public:
    */
   std::optional<long double> random(long long int max) const;
 
+  // --- Number theory (exact integers, see numbertheory.h) ---
+  /**
+   * @brief Greatest common divisor of value1 and value2.
+   * @return gcd (non-negative) if both operands are integral; std::nullopt
+   *         otherwise.
+   */
+  std::optional<Integer> gcd() const;
+  /**
+   * @brief Least common multiple of value1 and value2.
+   * @return lcm (non-negative) if both operands are integral and it fits in
+   *         Integer; std::nullopt otherwise.
+   */
+  std::optional<Integer> lcm() const;
+  /**
+   * @brief Modular exponentiation base^exp mod m (Montgomery for odd m).
+   * @return Result, or std::nullopt when m == 0.
+   */
+  static std::optional<std::uint64_t> modPow(std::uint64_t base,
+                                             std::uint64_t exp,
+                                             std::uint64_t m);
+  /**
+   * @brief Modular inverse of a modulo m.
+   * @return Inverse, or std::nullopt when it does not exist.
+   */
+  static std::optional<std::uint64_t> modInverse(std::uint64_t a,
+                                                 std::uint64_t m);
+  /** @brief Deterministic 64-bit Miller-Rabin primality test. */
+  static bool isPrime(std::uint64_t n);
+  /**
+   * @brief Prime factorization (trial division + Pollard-rho/Brent).
+   * @return (prime, exponent) pairs in increasing order; empty for 0 and 1.
+   */
+  static std::vector<std::pair<std::uint64_t, unsigned>>
+  factorize(std::uint64_t n);
+
+  // --- Combinatorics (arbitrary precision, see combinatorics.h) ---
+  /**
+   * @brief n! (prime-swing factorial; small results are cached).
+   * @return n!, or std::nullopt when n exceeds combinatorics::kMaxN.
+   */
+  static std::optional<BigInt> factorial(std::uint64_t n);
+  /**
+   * @brief Binomial coefficient nCr.
+   * @return C(n, r) (0 when r > n), or std::nullopt when n is too large.
+   */
+  static std::optional<BigInt> choose(std::uint64_t n, std::uint64_t r);
+  /**
+   * @brief Permutations nPr = n! / (n - r)!.
+   * @return P(n, r) (0 when r > n), or std::nullopt when n is too large.
+   */
+  static std::optional<BigInt> permutations(std::uint64_t n, std::uint64_t r);
+  /**
+   * @brief n-th Catalan number.
+   * @return C(2n, n) / (n + 1), or std::nullopt when n is too large.
+   */
+  static std::optional<BigInt> catalan(std::uint64_t n);
+  /**
+   * @brief Multinomial coefficient (k1 + ... + km)! / (k1! ... km!).
+   * @return Result, or std::nullopt when the total is too large.
+   */
+  static std::optional<BigInt> multinomial(const std::vector<std::uint64_t> &ks);
+
+  // --- High-precision constants ---
+  /**
+   * @brief pi, e, sqrt(2) or ln(2) to @p digits decimals (see constants.h).
+   * @param cacheDir Disk cache directory; empty = the per-user default.
+   * @param cancel Once set, the computation stops (see constants::Options).
+   * @return Digits, or std::nullopt for an unsupported digit count or a
+   *         cancelled computation.
+   */
+  static std::optional<constants::Result>
+  constant(constants::Constant c, std::size_t digits,
+           const std::string &cacheDir = {},
+           const std::atomic<bool> *cancel = nullptr);
+
+  // --- Units ---
+  /**
+   * @brief Convert @p value between two units (see units.h for the syntax).
+   * @return Converted value, or std::nullopt if a unit is unknown or the
+   *         dimensions differ.
+   */
+  static std::optional<long double> convertUnits(long double value,
+                                                 std::string_view from,
+                                                 std::string_view to);
+
+  // --- Finance (see finance.h) ---
+  /**
+   * @brief Net present value; amounts[t] falls at the end of period t.
+   * @return NPV, or std::nullopt for rate <= -1.
+   */
+  static std::optional<long double>
+  npv(long double rate, const std::vector<long double> &amounts);
+  /**
+   * @brief Internal rate of return per period (bracketed Newton).
+   * @return Rate, or std::nullopt when the flows never change sign.
+   */
+  static std::optional<long double> irr(const std::vector<long double> &amounts,
+                                        long double guess = 0.1L);
+  /**
+   * @brief Net present value of dated flows (actual/365 from the first).
+   * @return XNPV, or std::nullopt for rate <= -1 or mismatched sizes.
+   */
+  static std::optional<long double>
+  xnpv(long double rate, const std::vector<long double> &amounts,
+       const std::vector<std::int64_t> &days);
+  /**
+   * @brief Annual internal rate of return of dated flows.
+   * @param days Day numbers (see finance::parseDate), one per amount.
+   * @return Rate, or std::nullopt when there is none.
+   */
+  static std::optional<long double>
+  xirr(const std::vector<long double> &amounts,
+       const std::vector<std::int64_t> &days, long double guess = 0.1L);
+  /**
+   * @brief Level payment per period (spreadsheet PMT sign convention).
+   * @return Payment, or std::nullopt for periods <= 0 or rate <= -1.
+   */
+  static std::optional<long double> pmt(long double rate, long double periods,
+                                        long double presentValue,
+                                        long double futureValue = 0.0L,
+                                        bool atStart = false);
+  /**
+   * @brief Rows [first, first + count) of a loan's amortization schedule.
+   * @return false for an invalid loan or rows past its last period.
+   */
+  static bool amortize(const finance::Loan &loan, std::uint64_t first,
+                       std::size_t count, const finance::Rows &out);
+
+  // --- Complex functions (principal branches) ---
+  /** @brief Square root. @return sqrt(z), or std::nullopt if not finite. */
+  static std::optional<Complex> complexSqrt(Complex z);
+  /** @brief Exponential. @return e^z, or std::nullopt on overflow. */
+  static std::optional<Complex> complexExp(Complex z);
+  /** @brief Natural logarithm. @return ln z, or std::nullopt for z == 0. */
+  static std::optional<Complex> complexLog(Complex z);
+  /**
+   * @brief Power z^w = e^(w ln z).
+   * @return Result (0^w = 0 for Re w > 0, 0^0 = 1), or std::nullopt when
+   *         undefined or not finite.
+   */
+  static std::optional<Complex> complexPow(Complex z, Complex w);
+
   // --- Dispatch helper using current op (implemented in engine.cpp) ---
   /**
    * @brief Evaluate according to the current operator and stored operands.
@@ -119,10 +327,151 @@ public:
    */
   std::optional<long double> evaluate() const;
 
+  /**
+   * @brief Apply a binary arithmetic operator to two explicit operands.
+   *
+   * Shares the semantics of add/sub/mul/div (division by zero yields
+   * std::nullopt) without touching any engine state, so other modules (e.g.
+   * Expression) can reuse the engine's arithmetic on their own values. The
+   * operation runs in Real, like the keypad's.
+   *
+   * @param op Arithmetic operator (Add, Sub, Mul, Div, Gcd, Lcm or Pow).
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return The result, or std::nullopt for non-arithmetic ops, a / 0, or
+   *         Gcd/Lcm of non-integral values.
+   */
+  static std::optional<long double> apply(Op op, long double a, long double b);
+
+  /**
+   * @brief Exact result of the current operator on integer operands.
+   *
+   * Uses checked native arithmetic (overflow builtins where available).
+   * Division only succeeds when it leaves no remainder.
+   *
+   * @return The exact result, or std::nullopt when an operand is not
+   *         integral, the operation overflows Integer, or the quotient is not
+   *         whole. Callers then fall back to evaluate().
+   */
+  std::optional<Integer> evaluateInteger() const;
+
+  /**
+   * @brief Checked integer counterpart of apply().
+   * @param op Arithmetic operator (Add, Sub, Mul, Div, Gcd, Lcm or Pow).
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return Exact result, or std::nullopt on overflow, inexact division or a
+   *         non-arithmetic op.
+   */
+  static std::optional<Integer> applyInteger(Op op, Integer a, Integer b);
+
+  /**
+   * @brief Exact result of the current operator on integer operands, without
+   *        a range limit.
+   *
+   * Picks up where evaluateInteger() overflows: the integer shadows are
+   * promoted to BigInt. Division still has to leave no remainder.
+   *
+   * @return The exact result, or std::nullopt when an operand is not
+   *         integral, the quotient is not whole, the exponent is negative or
+   *         above kMaxRationalExponent, or for non-arithmetic ops.
+   */
+  std::optional<BigInt> evaluateBigInteger() const;
+
+  /**
+   * @brief BigInt counterpart of applyInteger().
+   * @param op Arithmetic operator (Add, Sub, Mul, Div, Gcd, Lcm or Pow).
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return Exact result, or std::nullopt on inexact division, an exponent
+   *         outside [0, kMaxRationalExponent] or a non-arithmetic op.
+   */
+  static std::optional<BigInt> applyBigInteger(Op op, const BigInt &a,
+                                               const BigInt &b);
+
+  /**
+   * @brief Evaluate the current operator over complex operands.
+   *
+   * Real operands go through evaluate() unchanged (so integer and real
+   * semantics are kept), except Pow, which turns complex when the real power
+   * is undefined (e.g. (-8)^(1/3) gives the principal root 1+1.732i).
+   *
+   * @return The result, or std::nullopt on missing operands, division by
+   *         zero, or an operator that has no complex meaning (Gcd/Lcm).
+   */
+  std::optional<Complex> evaluateComplex() const;
+
+  /**
+   * @brief Complex counterpart of apply().
+   * @param op Arithmetic operator (Add, Sub, Mul, Div or Pow).
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return Result, or std::nullopt for a / 0, undefined powers or
+   *         non-arithmetic ops.
+   */
+  static std::optional<Complex> applyComplex(Op op, Complex a, Complex b);
+
+  /**
+   * @brief Element-wise out[i] = a[i] op b[i] over interleaved complex
+   *        arrays (signal-processing workloads, in double).
+   *
+   * Mul and Div run on the SIMD kernels of complexbatch.h (unscaled
+   * division, see there); Add, Sub and Pow go element by element, with NaN
+   * where applyComplex() declines. In-place use is allowed.
+   *
+   * @param op Arithmetic operator (Add, Sub, Mul, Div or Pow).
+   * @param a Left operands.
+   * @param b Right operands.
+   * @param out Output array of @p n values.
+   * @param n Element count.
+   * @return false (and @p out untouched) for a non-arithmetic op.
+   */
+  static bool applyComplexBatch(Op op, const std::complex<double> *a,
+                                const std::complex<double> *b,
+                                std::complex<double> *out, std::size_t n);
+
+  /**
+   * @brief applyComplexBatch() over split real/imaginary arrays.
+   * @return false (and the outputs untouched) for a non-arithmetic op.
+   */
+  static bool applyComplexBatch(Op op, const double *aRe, const double *aIm,
+                                const double *bRe, const double *bIm,
+                                double *outRe, double *outIm, std::size_t n);
+
+  /**
+   * @brief Exact fraction result of the current operator.
+   *
+   * Operands come from setRational*() or, failing that, the integer shadow.
+   *
+   * @return The reduced result, or std::nullopt when an operand has no exact
+   *         form (real or complex input), on division by zero, for a
+   *         non-integral or too large exponent, or for non-arithmetic ops.
+   */
+  std::optional<Rational> evaluateRational() const;
+
+  /**
+   * @brief Rational counterpart of apply().
+   * @param op Arithmetic operator (Add, Sub, Mul, Div or Pow).
+   * @param a Left operand.
+   * @param b Right operand.
+   * @return Exact result, or std::nullopt for a / 0, a power whose exponent
+   *         is not an integer of magnitude <= kMaxRationalExponent, or a
+   *         non-arithmetic op.
+   */
+  static std::optional<Rational> applyRational(Op op, const Rational &a,
+                                               const Rational &b);
+
+  /// Largest |exponent| accepted by applyRational(Op::Pow, ...).
+  static constexpr long long kMaxRationalExponent = 65536;
+
 private:
-  long double value1_ = 0.0L; ///< First operand.
-  long double value2_ = 0.0L; ///< Second operand.
-  Op op_ = Op::None;          ///< Current operator.
-  bool hasV1_ = false;        ///< Whether value1_ is set.
-  bool hasV2_ = false;        ///< Whether value2_ is set.
+  BasicEngine<Real> real_;    ///< Operands, operator and real arithmetic.
+  Integer int1_ = 0;          ///< Exact shadow of value1 (if isInt1_).
+  Integer int2_ = 0;          ///< Exact shadow of value2 (if isInt2_).
+  bool isInt1_ = false;       ///< Whether int1_ holds value1 exactly.
+  bool isInt2_ = false;       ///< Whether int2_ holds value2 exactly.
+  long double imag1_ = 0.0L;  ///< Imaginary part of the first operand.
+  long double imag2_ = 0.0L;  ///< Imaginary part of the second operand.
+  std::optional<Rational> rat1_; ///< Exact fraction of the first operand.
+  std::optional<Rational> rat2_; ///< Exact fraction of the second operand.
 };
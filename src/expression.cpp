@@ -0,0 +1,490 @@
+/**
+ * @file expression.cpp
+ * @brief Implementation of the Expression class (parser and evaluators).
+ *
+ * A small recursive-descent parser turns the source text into a postfix
+ * program. The scalar evaluator runs the program in long double through
+ * Engine::apply; the batch evaluator runs it block by block in double.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "expression.h"
+#include "decimal.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+
+namespace {
+/// Rows per block in evaluateBatch (stack buffers are depth x kBlock).
+constexpr std::size_t kBlock = 256;
+/// Deepest nesting of parentheses, signs and powers the parser accepts, so
+/// that pasted input cannot overflow the call stack.
+constexpr int kMaxNesting = 256;
+
+/// Name table for Expression::Func.
+struct FuncName {
+  const char *name;
+  Expression::Func func;
+};
+
+constexpr FuncName kFuncs[] = {
+    {"sqrt", Expression::Func::Sqrt},   {"abs", Expression::Func::Abs},
+    {"exp", Expression::Func::Exp},     {"ln", Expression::Func::Log},
+    {"log", Expression::Func::Log},     {"log10", Expression::Func::Log10},
+    {"sin", Expression::Func::Sin},     {"cos", Expression::Func::Cos},
+    {"tan", Expression::Func::Tan},     {"asin", Expression::Func::Asin},
+    {"acos", Expression::Func::Acos},   {"atan", Expression::Func::Atan},
+    {"floor", Expression::Func::Floor}, {"ceil", Expression::Func::Ceil}};
+
+/// Apply a unary function in any floating type.
+template <typename T> T callFunc(Expression::Func f, T v) {
+  switch (f) {
+  case Expression::Func::Sqrt:
+    return std::sqrt(v);
+  case Expression::Func::Abs:
+    return std::fabs(v);
+  case Expression::Func::Exp:
+    return std::exp(v);
+  case Expression::Func::Log:
+    return std::log(v);
+  case Expression::Func::Log10:
+    return std::log10(v);
+  case Expression::Func::Sin:
+    return std::sin(v);
+  case Expression::Func::Cos:
+    return std::cos(v);
+  case Expression::Func::Tan:
+    return std::tan(v);
+  case Expression::Func::Asin:
+    return std::asin(v);
+  case Expression::Func::Acos:
+    return std::acos(v);
+  case Expression::Func::Atan:
+    return std::atan(v);
+  case Expression::Func::Floor:
+    return std::floor(v);
+  case Expression::Func::Ceil:
+    return std::ceil(v);
+  }
+  return std::numeric_limits<T>::quiet_NaN();
+}
+} // namespace
+
+/**
+ * @brief Recursive-descent parser producing an Expression program.
+ *
+ * Grammar (lowest to highest precedence):
+ *   expr    := term (('+' | '-') term)*
+ *   term    := unary (('*' | '/') unary)*
+ *   unary   := ('+' | '-') unary | power
+ *   power   := primary ('^' unary)?
+ *   primary := number | name | name '(' expr (',' expr)? ')' | '(' expr ')'
+ */
+class ExpressionParser {
+public:
+  ExpressionParser(const std::string &src, const std::vector<std::string> &vars,
+                   Expression &out)
+      : src_(src), vars_(vars), out_(out) {}
+
+  /// Parse the whole input; on failure error() describes the problem.
+  bool run() {
+    if (!parseExpr())
+      return false;
+    skipSpace();
+    if (pos_ != src_.size())
+      return fail("unexpected character");
+    return true;
+  }
+
+  const std::string &error() const { return error_; }
+  std::size_t maxDepth() const { return maxDepth_; }
+
+private:
+  bool fail(const char *msg) {
+    if (error_.empty())
+      error_ = std::string(msg) + " at position " + std::to_string(pos_);
+    return false;
+  }
+
+  void skipSpace() {
+    while (pos_ < src_.size() &&
+           std::isspace(static_cast<unsigned char>(src_[pos_])))
+      ++pos_;
+  }
+
+  bool accept(char c) {
+    skipSpace();
+    if (pos_ < src_.size() && src_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  /// Append an instruction and keep the stack-depth bookkeeping current.
+  void emit(const Expression::Instr &in, int stackDelta) {
+    out_.program_.push_back(in);
+    depth_ += stackDelta;
+    maxDepth_ = std::max(maxDepth_, static_cast<std::size_t>(depth_));
+  }
+
+  void emitBinary(Engine::Op op) {
+    Expression::Instr in{Expression::Kind::Binary};
+    in.op = op;
+    emit(in, -1);
+  }
+
+  bool parseExpr() {
+    if (!parseTerm())
+      return false;
+    for (;;) {
+      if (accept('+')) {
+        if (!parseTerm())
+          return false;
+        emitBinary(Engine::Op::Add);
+      } else if (accept('-')) {
+        if (!parseTerm())
+          return false;
+        emitBinary(Engine::Op::Sub);
+      } else {
+        return true;
+      }
+    }
+  }
+
+  bool parseTerm() {
+    if (!parseUnary())
+      return false;
+    for (;;) {
+      if (accept('*')) {
+        if (!parseUnary())
+          return false;
+        emitBinary(Engine::Op::Mul);
+      } else if (accept('/')) {
+        if (!parseUnary())
+          return false;
+        emitBinary(Engine::Op::Div);
+      } else {
+        return true;
+      }
+    }
+  }
+
+  /// Every level of nesting passes through here.
+  bool parseUnary() {
+    if (nesting_ == kMaxNesting)
+      return fail("expression nested too deeply");
+    ++nesting_;
+    const bool ok = parseSigned();
+    --nesting_;
+    return ok;
+  }
+
+  bool parseSigned() {
+    if (accept('+'))
+      return parseUnary();
+    if (accept('-')) {
+      if (!parseUnary())
+        return false;
+      emit(Expression::Instr{Expression::Kind::Neg}, 0);
+      return true;
+    }
+    return parsePower();
+  }
+
+  bool parsePower() {
+    if (!parsePrimary())
+      return false;
+    if (accept('^')) {
+      if (!parseUnary())
+        return false;
+      emit(Expression::Instr{Expression::Kind::Pow}, -1);
+    }
+    return true;
+  }
+
+  bool parsePrimary() {
+    skipSpace();
+    if (pos_ >= src_.size())
+      return fail("unexpected end of input");
+    const char c = src_[pos_];
+    if (accept('(')) {
+      if (!parseExpr())
+        return false;
+      return accept(')') ? true : fail("expected ')'");
+    }
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+      // Locale-independent: strtold would follow the C locale's decimal
+      // point, which Qt sets from the environment.
+      const char *begin = src_.data() + pos_;
+      long double v = 0.0L;
+      const auto [end, ec] =
+          decimal::parse(begin, src_.data() + src_.size(), v);
+      if (ec == std::errc::invalid_argument)
+        return fail("invalid number");
+      pos_ += static_cast<std::size_t>(end - begin);
+      Expression::Instr in{Expression::Kind::Const};
+      in.value = v;
+      emit(in, 1);
+      return true;
+    }
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      std::size_t start = pos_;
+      while (pos_ < src_.size() &&
+             (std::isalnum(static_cast<unsigned char>(src_[pos_])) ||
+              src_[pos_] == '_'))
+        ++pos_;
+      return parseName(src_.substr(start, pos_ - start));
+    }
+    return fail("unexpected character");
+  }
+
+  bool parseName(const std::string &name) {
+    for (std::size_t i = 0; i < vars_.size(); ++i) {
+      if (vars_[i] == name) {
+        Expression::Instr in{Expression::Kind::Var};
+        in.index = i;
+        emit(in, 1);
+        return true;
+      }
+    }
+    if (name == "pi" || name == "e") {
+      Expression::Instr in{Expression::Kind::Const};
+      in.value = name == "pi" ? 3.141592653589793238462643383279502884L
+                              : 2.718281828459045235360287471352662498L;
+      emit(in, 1);
+      return true;
+    }
+    if (name == "pow") {
+      if (!accept('(') || !parseExpr() || !accept(',') || !parseExpr() ||
+          !accept(')'))
+        return fail("expected pow(a, b)");
+      emit(Expression::Instr{Expression::Kind::Pow}, -1);
+      return true;
+    }
+    for (const FuncName &f : kFuncs) {
+      if (name == f.name) {
+        if (!accept('(') || !parseExpr() || !accept(')'))
+          return fail("expected '(' argument ')'");
+        Expression::Instr in{Expression::Kind::Call};
+        in.func = f.func;
+        emit(in, 0);
+        return true;
+      }
+    }
+    return fail(("unknown name '" + name + "'").c_str());
+  }
+
+  const std::string &src_;
+  const std::vector<std::string> &vars_;
+  Expression &out_;
+  std::size_t pos_ = 0;
+  int depth_ = 0;
+  std::size_t maxDepth_ = 0;
+  int nesting_ = 0; ///< Active parseUnary() calls.
+  std::string error_;
+};
+
+/**
+ * @brief Parse and compile @p text over the given variable names.
+ * @param text Expression source.
+ * @param variables Input variable names (column order).
+ * @param error Receives a parse error message on failure (optional).
+ * @return Compiled expression or std::nullopt.
+ */
+std::optional<Expression>
+Expression::compile(const std::string &text,
+                    const std::vector<std::string> &variables,
+                    std::string *error) {
+  Expression e;
+  e.text_ = text;
+  e.variableCount_ = variables.size();
+  ExpressionParser parser(text, variables, e);
+  if (!parser.run()) {
+    if (error)
+      *error = parser.error();
+    return std::nullopt;
+  }
+  e.maxDepth_ = parser.maxDepth();
+  return e;
+}
+
+/**
+ * @brief Scalar long double evaluation; arithmetic goes through Engine::apply.
+ * @param vars Variable values (variableCount() entries).
+ * @return Result or NaN when an operation is undefined.
+ */
+long double Expression::evaluate(const long double *vars) const {
+  std::vector<long double> stack;
+  stack.reserve(maxDepth_);
+  for (const Instr &in : program_) {
+    switch (in.kind) {
+    case Kind::Const:
+      stack.push_back(in.value);
+      break;
+    case Kind::Var:
+      stack.push_back(vars[in.index]);
+      break;
+    case Kind::Binary: {
+      long double b = stack.back();
+      stack.pop_back();
+      auto r = Engine::apply(in.op, stack.back(), b);
+      stack.back() = r ? *r : std::numeric_limits<long double>::quiet_NaN();
+      break;
+    }
+    case Kind::Pow: {
+      long double b = stack.back();
+      stack.pop_back();
+      stack.back() = std::pow(stack.back(), b);
+      break;
+    }
+    case Kind::Neg:
+      stack.back() = -stack.back();
+      break;
+    case Kind::Call:
+      stack.back() = callFunc(in.func, stack.back());
+      break;
+    }
+  }
+  return stack.empty() ? std::numeric_limits<long double>::quiet_NaN()
+                       : stack.back();
+}
+
+/**
+ * @brief Single-variable scalar evaluation.
+ * @param x Value of the first variable.
+ * @return Result or NaN.
+ */
+long double Expression::evaluate(long double x) const { return evaluate(&x); }
+
+/**
+ * @brief Batch evaluation in double precision over @p n rows.
+ * @param columns Input columns, one per variable.
+ * @param out Output buffer of @p n values.
+ * @param n Row count.
+ */
+void Expression::evaluateBatch(const double *const *columns, double *out,
+                               std::size_t n) const {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  if (program_.empty()) {
+    std::fill(out, out + n, nan);
+    return;
+  }
+  std::vector<double> buffer(std::max<std::size_t>(maxDepth_, 1) * kBlock);
+  for (std::size_t base = 0; base < n; base += kBlock) {
+    const std::size_t len = std::min(kBlock, n - base);
+    std::size_t sp = 0; // number of live stack slots
+    for (const Instr &in : program_) {
+      double *top = buffer.data() + sp * kBlock; // next free slot
+      double *a = top - 2 * kBlock;              // left operand slot
+      double *b = top - kBlock;                  // right/only operand slot
+      switch (in.kind) {
+      case Kind::Const: {
+        const double v = static_cast<double>(in.value);
+        for (std::size_t i = 0; i < len; ++i)
+          top[i] = v;
+        ++sp;
+        break;
+      }
+      case Kind::Var: {
+        const double *src = columns[in.index] + base;
+        std::copy(src, src + len, top);
+        ++sp;
+        break;
+      }
+      case Kind::Binary:
+        switch (in.op) {
+        case Engine::Op::Add:
+          for (std::size_t i = 0; i < len; ++i)
+            a[i] += b[i];
+          break;
+        case Engine::Op::Sub:
+          for (std::size_t i = 0; i < len; ++i)
+            a[i] -= b[i];
+          break;
+        case Engine::Op::Mul:
+          for (std::size_t i = 0; i < len; ++i)
+            a[i] *= b[i];
+          break;
+        case Engine::Op::Div: // Engine::div rejects a zero divisor
+          for (std::size_t i = 0; i < len; ++i)
+            a[i] = b[i] == 0.0 ? nan : a[i] / b[i];
+          break;
+        default:
+          std::fill(a, a + len, nan);
+          break;
+        }
+        --sp;
+        break;
+      case Kind::Pow:
+        for (std::size_t i = 0; i < len; ++i)
+          a[i] = std::pow(a[i], b[i]);
+        --sp;
+        break;
+      case Kind::Neg:
+        for (std::size_t i = 0; i < len; ++i)
+          b[i] = -b[i];
+        break;
+      case Kind::Call:
+        for (std::size_t i = 0; i < len; ++i)
+          b[i] = callFunc(in.func, b[i]);
+        break;
+      }
+    }
+    std::copy(buffer.data(), buffer.data() + len, out + base);
+  }
+}
+
+/**
+ * @brief Single-variable batch evaluation.
+ * @param xs Input values.
+ * @param out Output values.
+ * @param n Row count.
+ */
+void Expression::evaluateBatch(const double *xs, double *out,
+                               std::size_t n) const {
+  evaluateBatch(&xs, out, n);
+}
+
+/**
+ * @brief Built-in function in long double.
+ * @param f Function.
+ * @param v Argument.
+ * @return f(v), NaN outside the domain.
+ */
+long double Expression::apply(Func f, long double v) { return callFunc(f, v); }
+
+/**
+ * @brief Function name (the first spelling in the parser's table).
+ * @param f Function.
+ * @return Name such as "sqrt" or "ln".
+ */
+const char *Expression::name(Func f) {
+  for (const FuncName &entry : kFuncs)
+    if (entry.func == f)
+      return entry.name;
+  return "?";
+}
+
+/**
+ * @brief Number of input variables.
+ * @return Variable count given to compile().
+ */
+std::size_t Expression::variableCount() const { return variableCount_; }
+
+/**
+ * @brief Source text.
+ * @return The text passed to compile().
+ */
+const std::string &Expression::text() const { return text_; }
+
+/**
+ * @brief Compiled program.
+ * @return Postfix instructions in evaluation order.
+ */
+const std::vector<Expression::Instr> &Expression::program() const {
+  return program_;
+}
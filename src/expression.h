@@ -0,0 +1,127 @@
+#pragma once
+#include "engine.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @file expression.h
+ * @brief Declaration of the Expression class (compiled user expressions).
+ *
+ * An Expression is parsed once from text such as "sqrt(1 - x^2) * 4" and
+ * compiled into a flat stack program. Arithmetic instructions reuse
+ * Engine::Op (and Engine::apply for scalar evaluation) so expressions follow
+ * the same rules as the keypad. A batch path evaluates the program over whole
+ * columns of inputs at once, which is what the simulation, plotting and
+ * calculus modes use.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+class Expression {
+public:
+  /**
+   * @brief Built-in unary functions available in expressions.
+   */
+  enum class Func {
+    Sqrt,
+    Abs,
+    Exp,
+    Log,
+    Log10,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Floor,
+    Ceil
+  };
+
+  /**
+   * @brief Parse and compile an expression.
+   *
+   * Grammar: numbers, the variables listed in @p variables, constants pi and
+   * e, binary + - * / ^ (right associative), unary minus, parentheses,
+   * pow(a, b) and the functions in Func (sqrt, abs, exp, ln/log, log10, sin,
+   * cos, tan, asin, acos, atan, floor, ceil).
+   *
+   * @param text Expression source.
+   * @param variables Names of the input variables, in column order.
+   * @param error Optional output for a human-readable parse error.
+   * @return Compiled expression, or std::nullopt on a syntax error.
+   */
+  static std::optional<Expression>
+  compile(const std::string &text,
+          const std::vector<std::string> &variables = {"x"},
+          std::string *error = nullptr);
+
+  /**
+   * @brief Evaluate once with long double precision.
+   * @param vars One value per variable (may be null if there are none).
+   * @return Result; NaN on division by zero or domain errors.
+   */
+  long double evaluate(const long double *vars) const;
+
+  /** @brief Convenience overload for single-variable expressions. */
+  long double evaluate(long double x) const;
+
+  /**
+   * @brief Evaluate over @p n rows in double precision.
+   *
+   * Rows are processed in fixed-size blocks; every instruction runs as a
+   * tight loop over a block so the compiler can vectorize the arithmetic.
+   *
+   * @param columns One input array per variable, each of length @p n.
+   * @param out Output array of length @p n (NaN for invalid rows).
+   * @param n Number of rows.
+   */
+  void evaluateBatch(const double *const *columns, double *out,
+                     std::size_t n) const;
+
+  /** @brief Single-variable batch overload. */
+  void evaluateBatch(const double *xs, double *out, std::size_t n) const;
+
+  /**
+   * @brief Apply a built-in function as the evaluators do.
+   * @return Result; NaN outside the function's domain.
+   */
+  static long double apply(Func f, long double v);
+
+  /** @brief Name of a built-in function as written in expressions. */
+  static const char *name(Func f);
+
+  /** @brief Number of input variables. */
+  std::size_t variableCount() const;
+  /** @brief Source text the expression was compiled from. */
+  const std::string &text() const;
+
+  /// Instruction kinds of the compiled stack program.
+  enum class Kind { Const, Var, Binary, Pow, Neg, Call };
+
+  /// One stack-machine instruction.
+  struct Instr {
+    Kind kind;
+    Engine::Op op = Engine::Op::None; ///< Operator for Kind::Binary.
+    Func func = Func::Sqrt;           ///< Function for Kind::Call.
+    long double value = 0.0L;         ///< Literal for Kind::Const.
+    std::size_t index = 0;            ///< Column for Kind::Var.
+  };
+
+  /**
+   * @brief The compiled postfix program, read-only (e.g. for building a
+   *        symbolic::Graph from it).
+   */
+  const std::vector<Instr> &program() const;
+
+private:
+  friend class ExpressionParser;
+
+  std::string text_;              ///< Original source.
+  std::vector<Instr> program_;    ///< Postfix program.
+  std::size_t variableCount_ = 0; ///< Number of input columns.
+  std::size_t maxDepth_ = 0;      ///< Peak stack depth of program_.
+};
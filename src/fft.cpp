@@ -0,0 +1,521 @@
+/**
+ * @file fft.cpp
+ * @brief Implementation of the radix-4 transforms, plan cache and
+ *        convolution.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "fft.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FFT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace fft {
+namespace {
+
+/// Points per block swept stage by stage (128 KiB of split data, L2-sized).
+constexpr std::size_t kBlock = std::size_t{1} << 13;
+/// Plans kept alive by the cache (callers may hold more).
+constexpr std::size_t kMaxCachedPlans = 8;
+
+/**
+ * @brief Twiddles w^j = exp(-2 pi i j / s), j < s/4, of one stage size s.
+ *        Exponents up to 3 (s/4 - 1) exceed the table, so w^2 and w^3 are
+ *        products.
+ */
+struct Twiddles {
+  const double *re, *im;
+};
+
+/**
+ * @brief One radix-4 decimation-in-frequency stage on x[0 .. s): for each j
+ *        in a quarter, the four inputs j, j+q, j+2q, j+3q go to
+ *        [sum, (t0 - t2) w^2j, (t1 - i t3) w^j, (t1 + i t3) w^3j].
+ */
+void difStage(double *re, double *im, std::size_t s, const Twiddles &tw) {
+  const std::size_t q = s / 4;
+  double *r0 = re, *r1 = re + q, *r2 = re + 2 * q, *r3 = re + 3 * q;
+  double *i0 = im, *i1 = im + q, *i2 = im + 2 * q, *i3 = im + 3 * q;
+  std::size_t j = 0;
+#ifdef FFT_SSE2
+  for (; j + 2 <= q; j += 2) {
+    const __m128d w1r = _mm_loadu_pd(tw.re + j);
+    const __m128d w1i = _mm_loadu_pd(tw.im + j);
+    const __m128d w2r =
+        _mm_sub_pd(_mm_mul_pd(w1r, w1r), _mm_mul_pd(w1i, w1i));
+    const __m128d w2i = _mm_add_pd(_mm_mul_pd(w1r, w1i), _mm_mul_pd(w1r, w1i));
+    const __m128d w3r =
+        _mm_sub_pd(_mm_mul_pd(w2r, w1r), _mm_mul_pd(w2i, w1i));
+    const __m128d w3i =
+        _mm_add_pd(_mm_mul_pd(w2r, w1i), _mm_mul_pd(w2i, w1r));
+
+    const __m128d ar = _mm_loadu_pd(r0 + j), ai = _mm_loadu_pd(i0 + j);
+    const __m128d br = _mm_loadu_pd(r1 + j), bi = _mm_loadu_pd(i1 + j);
+    const __m128d cr = _mm_loadu_pd(r2 + j), ci = _mm_loadu_pd(i2 + j);
+    const __m128d dr = _mm_loadu_pd(r3 + j), di = _mm_loadu_pd(i3 + j);
+    const __m128d t0r = _mm_add_pd(ar, cr), t0i = _mm_add_pd(ai, ci);
+    const __m128d t1r = _mm_sub_pd(ar, cr), t1i = _mm_sub_pd(ai, ci);
+    const __m128d t2r = _mm_add_pd(br, dr), t2i = _mm_add_pd(bi, di);
+    const __m128d t3r = _mm_sub_pd(br, dr), t3i = _mm_sub_pd(bi, di);
+
+    _mm_storeu_pd(r0 + j, _mm_add_pd(t0r, t2r));
+    _mm_storeu_pd(i0 + j, _mm_add_pd(t0i, t2i));
+    const __m128d xr = _mm_sub_pd(t0r, t2r), xi = _mm_sub_pd(t0i, t2i);
+    _mm_storeu_pd(r1 + j,
+                  _mm_sub_pd(_mm_mul_pd(xr, w2r), _mm_mul_pd(xi, w2i)));
+    _mm_storeu_pd(i1 + j,
+                  _mm_add_pd(_mm_mul_pd(xr, w2i), _mm_mul_pd(xi, w2r)));
+    const __m128d yr = _mm_add_pd(t1r, t3i), yi = _mm_sub_pd(t1i, t3r);
+    _mm_storeu_pd(r2 + j,
+                  _mm_sub_pd(_mm_mul_pd(yr, w1r), _mm_mul_pd(yi, w1i)));
+    _mm_storeu_pd(i2 + j,
+                  _mm_add_pd(_mm_mul_pd(yr, w1i), _mm_mul_pd(yi, w1r)));
+    const __m128d zr = _mm_sub_pd(t1r, t3i), zi = _mm_add_pd(t1i, t3r);
+    _mm_storeu_pd(r3 + j,
+                  _mm_sub_pd(_mm_mul_pd(zr, w3r), _mm_mul_pd(zi, w3i)));
+    _mm_storeu_pd(i3 + j,
+                  _mm_add_pd(_mm_mul_pd(zr, w3i), _mm_mul_pd(zi, w3r)));
+  }
+#endif
+  for (; j < q; ++j) {
+    const double w1r = tw.re[j], w1i = tw.im[j];
+    const double w2r = w1r * w1r - w1i * w1i, w2i = 2.0 * w1r * w1i;
+    const double w3r = w2r * w1r - w2i * w1i, w3i = w2r * w1i + w2i * w1r;
+    const double t0r = r0[j] + r2[j], t0i = i0[j] + i2[j];
+    const double t1r = r0[j] - r2[j], t1i = i0[j] - i2[j];
+    const double t2r = r1[j] + r3[j], t2i = i1[j] + i3[j];
+    const double t3r = r1[j] - r3[j], t3i = i1[j] - i3[j];
+    r0[j] = t0r + t2r;
+    i0[j] = t0i + t2i;
+    const double xr = t0r - t2r, xi = t0i - t2i;
+    r1[j] = xr * w2r - xi * w2i;
+    i1[j] = xr * w2i + xi * w2r;
+    const double yr = t1r + t3i, yi = t1i - t3r;
+    r2[j] = yr * w1r - yi * w1i;
+    i2[j] = yr * w1i + yi * w1r;
+    const double zr = t1r - t3i, zi = t1i + t3r;
+    r3[j] = zr * w3r - zi * w3i;
+    i3[j] = zr * w3i + zi * w3r;
+  }
+}
+
+/**
+ * @brief Inverse of difStage up to the factor 4: inputs are multiplied by
+ *        the conjugate twiddles, then recombined with +i in place of -i.
+ */
+void ditStage(double *re, double *im, std::size_t s, const Twiddles &tw) {
+  const std::size_t q = s / 4;
+  double *r0 = re, *r1 = re + q, *r2 = re + 2 * q, *r3 = re + 3 * q;
+  double *i0 = im, *i1 = im + q, *i2 = im + 2 * q, *i3 = im + 3 * q;
+  std::size_t j = 0;
+#ifdef FFT_SSE2
+  for (; j + 2 <= q; j += 2) {
+    const __m128d w1r = _mm_loadu_pd(tw.re + j);
+    const __m128d w1i = _mm_loadu_pd(tw.im + j);
+    const __m128d w2r =
+        _mm_sub_pd(_mm_mul_pd(w1r, w1r), _mm_mul_pd(w1i, w1i));
+    const __m128d w2i = _mm_add_pd(_mm_mul_pd(w1r, w1i), _mm_mul_pd(w1r, w1i));
+    const __m128d w3r =
+        _mm_sub_pd(_mm_mul_pd(w2r, w1r), _mm_mul_pd(w2i, w1i));
+    const __m128d w3i =
+        _mm_add_pd(_mm_mul_pd(w2r, w1i), _mm_mul_pd(w2i, w1r));
+
+    // y = x * conj(w): (xr wr + xi wi, xi wr - xr wi).
+    const __m128d y0r = _mm_loadu_pd(r0 + j), y0i = _mm_loadu_pd(i0 + j);
+    const __m128d br = _mm_loadu_pd(r1 + j), bi = _mm_loadu_pd(i1 + j);
+    const __m128d y2r = _mm_add_pd(_mm_mul_pd(br, w2r), _mm_mul_pd(bi, w2i));
+    const __m128d y2i = _mm_sub_pd(_mm_mul_pd(bi, w2r), _mm_mul_pd(br, w2i));
+    const __m128d cr = _mm_loadu_pd(r2 + j), ci = _mm_loadu_pd(i2 + j);
+    const __m128d y1r = _mm_add_pd(_mm_mul_pd(cr, w1r), _mm_mul_pd(ci, w1i));
+    const __m128d y1i = _mm_sub_pd(_mm_mul_pd(ci, w1r), _mm_mul_pd(cr, w1i));
+    const __m128d dr = _mm_loadu_pd(r3 + j), di = _mm_loadu_pd(i3 + j);
+    const __m128d y3r = _mm_add_pd(_mm_mul_pd(dr, w3r), _mm_mul_pd(di, w3i));
+    const __m128d y3i = _mm_sub_pd(_mm_mul_pd(di, w3r), _mm_mul_pd(dr, w3i));
+
+    const __m128d u0r = _mm_add_pd(y0r, y2r), u0i = _mm_add_pd(y0i, y2i);
+    const __m128d u1r = _mm_sub_pd(y0r, y2r), u1i = _mm_sub_pd(y0i, y2i);
+    const __m128d u2r = _mm_add_pd(y1r, y3r), u2i = _mm_add_pd(y1i, y3i);
+    const __m128d u3r = _mm_sub_pd(y1r, y3r), u3i = _mm_sub_pd(y1i, y3i);
+    _mm_storeu_pd(r0 + j, _mm_add_pd(u0r, u2r));
+    _mm_storeu_pd(i0 + j, _mm_add_pd(u0i, u2i));
+    _mm_storeu_pd(r2 + j, _mm_sub_pd(u0r, u2r));
+    _mm_storeu_pd(i2 + j, _mm_sub_pd(u0i, u2i));
+    _mm_storeu_pd(r1 + j, _mm_sub_pd(u1r, u3i));
+    _mm_storeu_pd(i1 + j, _mm_add_pd(u1i, u3r));
+    _mm_storeu_pd(r3 + j, _mm_add_pd(u1r, u3i));
+    _mm_storeu_pd(i3 + j, _mm_sub_pd(u1i, u3r));
+  }
+#endif
+  for (; j < q; ++j) {
+    const double w1r = tw.re[j], w1i = tw.im[j];
+    const double w2r = w1r * w1r - w1i * w1i, w2i = 2.0 * w1r * w1i;
+    const double w3r = w2r * w1r - w2i * w1i, w3i = w2r * w1i + w2i * w1r;
+    const double y0r = r0[j], y0i = i0[j];
+    const double y2r = r1[j] * w2r + i1[j] * w2i;
+    const double y2i = i1[j] * w2r - r1[j] * w2i;
+    const double y1r = r2[j] * w1r + i2[j] * w1i;
+    const double y1i = i2[j] * w1r - r2[j] * w1i;
+    const double y3r = r3[j] * w3r + i3[j] * w3i;
+    const double y3i = i3[j] * w3r - r3[j] * w3i;
+    const double u0r = y0r + y2r, u0i = y0i + y2i;
+    const double u1r = y0r - y2r, u1i = y0i - y2i;
+    const double u2r = y1r + y3r, u2i = y1i + y3i;
+    const double u3r = y1r - y3r, u3i = y1i - y3i;
+    r0[j] = u0r + u2r;
+    i0[j] = u0i + u2i;
+    r2[j] = u0r - u2r;
+    i2[j] = u0i - u2i;
+    r1[j] = u1r - u3i;
+    i1[j] = u1i + u3r;
+    r3[j] = u1r + u3i;
+    i3[j] = u1i - u3r;
+  }
+}
+
+/** @brief Length-2 butterflies (a + b, a - b) on consecutive pairs. */
+void radix2Stage(double *re, double *im, std::size_t s) {
+  for (std::size_t j = 0; j < s; j += 2) {
+    const double ar = re[j], ai = im[j], br = re[j + 1], bi = im[j + 1];
+    re[j] = ar + br;
+    im[j] = ai + bi;
+    re[j + 1] = ar - br;
+    im[j + 1] = ai - bi;
+  }
+}
+
+Twiddles twiddles(const Plan &plan, std::size_t s) {
+  return {plan.cosines(s), plan.sines(s)};
+}
+
+/**
+ * @brief Forward DIF on one block: whole-block stages while it is larger
+ *        than kBlock, then each quarter depth-first, so the small stages run
+ *        on cache-resident data. Output is in bit-reversed order.
+ */
+void dif(double *re, double *im, std::size_t s, const Plan &plan) {
+  if (s > kBlock) {
+    difStage(re, im, s, twiddles(plan, s));
+    for (std::size_t k = 0; k < 4; ++k)
+      dif(re + k * (s / 4), im + k * (s / 4), s / 4, plan);
+    return;
+  }
+  std::size_t m = s;
+  for (; m >= 4; m /= 4) {
+    const Twiddles tw = twiddles(plan, m);
+    for (std::size_t b = 0; b < s; b += m)
+      difStage(re + b, im + b, m, tw);
+  }
+  if (m == 2)
+    radix2Stage(re, im, s);
+}
+
+/** @brief Inverse of dif() up to the factor s (bit-reversed input). */
+void dit(double *re, double *im, std::size_t s, const Plan &plan) {
+  if (s > kBlock) {
+    for (std::size_t k = 0; k < 4; ++k)
+      dit(re + k * (s / 4), im + k * (s / 4), s / 4, plan);
+    ditStage(re, im, s, twiddles(plan, s));
+    return;
+  }
+  std::size_t m = 4;
+  // Blocks handed down by the recursion keep the parity of log2 n.
+  if ((s & 0x5555555555555555ull) == 0) {
+    radix2Stage(re, im, s);
+    m = 8;
+  }
+  for (; m <= s; m *= 4) {
+    const Twiddles tw = twiddles(plan, m);
+    for (std::size_t b = 0; b < s; b += m)
+      ditStage(re + b, im + b, m, tw);
+  }
+}
+
+/// Index bits per side of a bit-reversal tile (32 x 32 doubles, 8 KiB).
+constexpr int kTileBits = 5;
+
+std::size_t reverseBits(std::size_t x, int bits) {
+  std::size_t r = 0;
+  for (int i = 0; i < bits; ++i, x >>= 1)
+    r = (r << 1) | (x & 1);
+  return r;
+}
+
+/**
+ * @brief x[j] <-> x[rev(j)] for n = 2^bits. Large arrays go tile by tile:
+ *        an index is split into high, middle and low parts (a, b, c), and
+ *        rev(a b c) = rev(c) rev(b) rev(a), so the tiles of middle values b
+ *        and rev(b) are loaded into buffers and written back transposed,
+ *        turning scattered swaps into runs of whole cache lines.
+ */
+void bitReverse(double *x, std::size_t n, int bits) {
+  if (bits < 2 * kTileBits + 1) {
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+      std::size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+        j ^= bit;
+      j ^= bit;
+      if (i < j)
+        std::swap(x[i], x[j]);
+    }
+    return;
+  }
+  constexpr std::size_t kTile = std::size_t{1} << kTileBits;
+  std::size_t rev[kTile];
+  for (std::size_t i = 0; i < kTile; ++i)
+    rev[i] = reverseBits(i, kTileBits);
+  const int middle = bits - 2 * kTileBits;
+  const int high = bits - kTileBits;
+  double tileB[kTile * kTile], tileR[kTile * kTile];
+  for (std::size_t b = 0; b < (std::size_t{1} << middle); ++b) {
+    const std::size_t rb = reverseBits(b, middle);
+    if (rb < b)
+      continue;
+    for (std::size_t a = 0; a < kTile; ++a) {
+      const double *srcB = x + ((a << high) | (b << kTileBits));
+      const double *srcR = x + ((a << high) | (rb << kTileBits));
+      std::copy(srcB, srcB + kTile, tileB + a * kTile);
+      std::copy(srcR, srcR + kTile, tileR + a * kTile);
+    }
+    for (std::size_t c = 0; c < kTile; ++c) {
+      double *dstR = x + ((rev[c] << high) | (rb << kTileBits));
+      double *dstB = x + ((rev[c] << high) | (b << kTileBits));
+      for (std::size_t a = 0; a < kTile; ++a)
+        dstR[rev[a]] = tileB[a * kTile + c];
+      if (rb != b)
+        for (std::size_t a = 0; a < kTile; ++a)
+          dstB[rev[a]] = tileR[a * kTile + c];
+    }
+  }
+}
+
+void bitReverse(double *re, double *im, std::size_t n) {
+  int bits = 0;
+  while ((std::size_t{1} << bits) < n)
+    ++bits;
+  bitReverse(re, n, bits);
+  bitReverse(im, n, bits);
+}
+
+void scale(double *re, double *im, std::size_t n, double factor) {
+  for (std::size_t i = 0; i < n; ++i) {
+    re[i] *= factor;
+    im[i] *= factor;
+  }
+}
+
+/**
+ * @brief Spectrum of z = a + i b (bit-reversed, from dif) -> spectrum of the
+ *        convolution a * b times @p factor.
+ *
+ * With W_k = conj(Z_{-k}), A_k = (Z_k + W_k) / 2 and B_k = (Z_k - W_k) / 2i,
+ * so A_k B_k = -i (Z_k^2 - W_k^2) / 4. In bit-reversed order the partner of
+ * position p in [2^m, 2^(m+1)) is 3 * 2^m - 1 - p (positions 0 and 1, i.e.
+ * k = 0 and n/2, are their own partners).
+ */
+void realProduct(double *re, double *im, std::size_t n, double factor) {
+  const double f = 0.25 * factor;
+  auto product = [f](double zr, double zi, double wr, double wi, double &outR,
+                     double &outI) {
+    const double pr = (zr * zr - zi * zi) - (wr * wr - wi * wi);
+    const double pi = 2.0 * (zr * zi - wr * wi);
+    outR = f * pi;
+    outI = -f * pr;
+  };
+  for (std::size_t p = 0; p < std::min<std::size_t>(n, 2); ++p)
+    product(re[p], im[p], re[p], -im[p], re[p], im[p]);
+  for (std::size_t lo = 2; lo < n; lo *= 2) {
+    for (std::size_t p = lo, q = 2 * lo - 1; p < q; ++p, --q) {
+      const double zpr = re[p], zpi = im[p], zqr = re[q], zqi = im[q];
+      product(zpr, zpi, zqr, -zqi, re[p], im[p]);
+      product(zqr, zqi, zpr, -zpi, re[q], im[q]);
+    }
+  }
+}
+
+} // namespace
+
+Plan::Plan(std::size_t n) : n_(n) {
+  const std::size_t count = std::max<std::size_t>(n / 4, 1);
+  re_.resize(count + count / 3);
+  im_.resize(count + count / 3);
+  // Only the first octant of the top table is evaluated; the rest of the
+  // quarter circle is its reflection (cos and sin swap about pi/4).
+  const long double step = 2.0L * 3.141592653589793238462643383279502884L / n;
+  const std::size_t eighth = n / 8;
+  for (std::size_t k = 0; k < count && k <= eighth; ++k) {
+    const long double angle = step * static_cast<long double>(k);
+    re_[k] = static_cast<double>(std::cos(angle));
+    im_[k] = -static_cast<double>(std::sin(angle));
+  }
+  for (std::size_t k = eighth + 1; k < count; ++k) {
+    re_[k] = -im_[n / 4 - k];
+    im_[k] = -re_[n / 4 - k];
+  }
+  // Smaller stages take every 4^l-th entry, copied out so that the inner
+  // stages read their twiddles contiguously.
+  for (std::size_t m = n / 4, stride = 4; m >= 4; m /= 4, stride *= 4) {
+    double *re = re_.data() + (n - m) / 3;
+    double *im = im_.data() + (n - m) / 3;
+    for (std::size_t j = 0; j < m / 4; ++j) {
+      re[j] = re_[j * stride];
+      im[j] = im_[j * stride];
+    }
+  }
+}
+
+std::shared_ptr<const Plan> Plan::get(std::size_t n) {
+  if (!isPowerOfTwo(n))
+    return nullptr;
+  static std::mutex mutex;
+  static std::map<std::size_t, std::shared_ptr<const Plan>> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = cache.find(n);
+  if (it != cache.end())
+    return it->second;
+  if (cache.size() >= kMaxCachedPlans)
+    cache.erase(cache.begin()); // smallest size: cheapest to rebuild
+  std::shared_ptr<const Plan> plan(new Plan(n));
+  cache.emplace(n, plan);
+  return plan;
+}
+
+bool isPowerOfTwo(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+std::size_t nextPowerOfTwo(std::size_t n) {
+  std::size_t p = 1;
+  while (p < n)
+    p <<= 1;
+  return p;
+}
+
+bool forward(double *re, double *im, std::size_t n) {
+  const auto plan = Plan::get(n);
+  if (!plan)
+    return false;
+  dif(re, im, n, *plan);
+  bitReverse(re, im, n);
+  return true;
+}
+
+bool inverse(double *re, double *im, std::size_t n) {
+  const auto plan = Plan::get(n);
+  if (!plan)
+    return false;
+  bitReverse(re, im, n);
+  dit(re, im, n, *plan);
+  scale(re, im, n, 1.0 / static_cast<double>(n));
+  return true;
+}
+
+std::optional<std::vector<double>> powerSpectrum(const std::vector<double> &x) {
+  if (x.empty())
+    return std::nullopt;
+  const std::size_t n = nextPowerOfTwo(x.size());
+  std::vector<double> re(n, 0.0), im(n, 0.0);
+  std::copy(x.begin(), x.end(), re.begin());
+  forward(re.data(), im.data(), n);
+  std::vector<double> power(n / 2 + 1);
+  const double inv = 1.0 / static_cast<double>(n);
+  for (std::size_t k = 0; k < power.size(); ++k)
+    power[k] = (re[k] * re[k] + im[k] * im[k]) * inv;
+  return power;
+}
+
+std::optional<std::vector<double>> convolve(const std::vector<double> &a,
+                                            const std::vector<double> &b) {
+  if (a.empty() || b.empty())
+    return std::nullopt;
+  const std::size_t size = a.size() + b.size() - 1;
+  const std::size_t n = nextPowerOfTwo(size);
+  const auto plan = Plan::get(n);
+  // Both real series share one complex transform; the spectrum stays in
+  // bit-reversed order between dif and dit.
+  std::vector<double> re(n, 0.0), im(n, 0.0);
+  std::copy(a.begin(), a.end(), re.begin());
+  std::copy(b.begin(), b.end(), im.begin());
+  dif(re.data(), im.data(), n, *plan);
+  realProduct(re.data(), im.data(), n, 1.0 / static_cast<double>(n));
+  dit(re.data(), im.data(), n, *plan);
+  re.resize(size);
+  return re;
+}
+
+std::optional<std::vector<double>> correlate(const std::vector<double> &a,
+                                             const std::vector<double> &b) {
+  return convolve(a, std::vector<double>(b.rbegin(), b.rend()));
+}
+
+std::optional<std::vector<double>> parseSeries(std::string_view text) {
+  std::vector<double> values;
+  const char *p = text.data();
+  const char *end = p + text.size();
+  auto separator = [](char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' ||
+           c == ';';
+  };
+  while (true) {
+    while (p != end && separator(*p))
+      ++p;
+    if (p == end)
+      break;
+    if (*p == '+')
+      ++p;
+    double value = 0.0;
+    const auto [next, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc() || (next != end && !separator(*next)))
+      return std::nullopt;
+    values.push_back(value);
+    p = next;
+  }
+  return values;
+}
+
+std::optional<ComplexSeries> parseComplexSeries(std::string_view text) {
+  ComplexSeries values;
+  const char *p = text.data();
+  const char *end = p + text.size();
+  auto separator = [](char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == ';';
+  };
+  while (p != end) {
+    double parts[2] = {0.0, 0.0};
+    int count = 0;
+    while (true) {
+      while (p != end && separator(*p))
+        ++p;
+      if (p == end || *p == '\n')
+        break;
+      if (count == 2)
+        return std::nullopt;
+      if (*p == '+')
+        ++p;
+      const auto [next, ec] = std::from_chars(p, end, parts[count]);
+      if (ec != std::errc() ||
+          (next != end && !separator(*next) && *next != '\n'))
+        return std::nullopt;
+      ++count;
+      p = next;
+    }
+    if (p != end)
+      ++p; // the newline
+    if (count > 0) {
+      values.re.push_back(parts[0]);
+      values.im.push_back(parts[1]);
+    }
+  }
+  return values;
+}
+
+} // namespace fft
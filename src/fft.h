@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file fft.h
+ * @brief Fast Fourier transforms, power spectrum and convolution of series.
+ *
+ * Transforms are radix-4 (with one radix-2 stage when log2 n is odd) on
+ * split real/imaginary arrays, so SSE2 butterflies handle two points per
+ * instruction. The forward transform is decimation in frequency and the
+ * inverse decimation in time, each recursing depth-first until a block fits
+ * in cache and then sweeping it stage by stage; convolution pairs them so
+ * the spectrum is multiplied in bit-reversed order and never permuted.
+ *
+ * Twiddle factors live in a Plan per size (one contiguous table per stage
+ * size, n/3 values in all), built once and reused by later calls of the same
+ * size.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace fft {
+
+/** @brief Precomputed twiddle factors for one transform size. */
+class Plan {
+public:
+  /**
+   * @brief Shared plan for size @p n (built on first use, then cached).
+   * @param n Power of two.
+   * @return The plan, or nullptr if @p n is not a power of two.
+   */
+  static std::shared_ptr<const Plan> get(std::size_t n);
+
+  /** @brief Transform size. */
+  std::size_t size() const { return n_; }
+  /**
+   * @brief Real parts of exp(-2 pi i k / m), k < m / 4, for a stage size
+   *        m = n / 4^l >= 4.
+   */
+  const double *cosines(std::size_t m) const {
+    return re_.data() + (n_ - m) / 3;
+  }
+  /** @brief Imaginary parts matching cosines(m). */
+  const double *sines(std::size_t m) const { return im_.data() + (n_ - m) / 3; }
+
+private:
+  explicit Plan(std::size_t n);
+
+  std::size_t n_;
+  std::vector<double> re_, im_;
+};
+
+/** @brief Whether @p n is a power of two (1 included). */
+bool isPowerOfTwo(std::size_t n);
+/** @brief Smallest power of two >= @p n. */
+std::size_t nextPowerOfTwo(std::size_t n);
+
+/**
+ * @brief In-place forward DFT X_k = sum x_j exp(-2 pi i jk / n).
+ * @return false (data untouched) if @p n is not a power of two.
+ */
+bool forward(double *re, double *im, std::size_t n);
+
+/**
+ * @brief In-place inverse DFT, including the 1/n factor.
+ * @return false (data untouched) if @p n is not a power of two.
+ */
+bool inverse(double *re, double *im, std::size_t n);
+
+/**
+ * @brief Periodogram |X_k|^2 / n of a real series for k = 0 .. n/2, after
+ *        zero-padding to a power of two.
+ * @return Values, or std::nullopt for an empty series.
+ */
+std::optional<std::vector<double>> powerSpectrum(const std::vector<double> &x);
+
+/**
+ * @brief Linear convolution (a * b)[k] = sum a[i] b[k - i], length
+ *        |a| + |b| - 1.
+ * @return Values, or std::nullopt if either series is empty.
+ */
+std::optional<std::vector<double>> convolve(const std::vector<double> &a,
+                                            const std::vector<double> &b);
+
+/**
+ * @brief Cross-correlation r[k] = sum a[i + k] b[i] for lags
+ *        k = -(|b| - 1) .. |a| - 1 (element 0 is the most negative lag).
+ * @return Values, or std::nullopt if either series is empty.
+ */
+std::optional<std::vector<double>> correlate(const std::vector<double> &a,
+                                             const std::vector<double> &b);
+
+/**
+ * @brief Numbers separated by whitespace, commas or semicolons.
+ * @param text Series text (e.g. a pasted column or a loaded file).
+ * @return Values, or std::nullopt at the first token that is not a number.
+ */
+std::optional<std::vector<double>> parseSeries(std::string_view text);
+
+/** @brief Complex series in split form, as forward() and inverse() take. */
+struct ComplexSeries {
+  std::vector<double> re; ///< Real parts.
+  std::vector<double> im; ///< Imaginary parts.
+};
+
+/**
+ * @brief One complex value per line: "re im", or just "re" for a real one
+ *        (the layout of a forward transform's output). Blank lines are
+ *        skipped; within a line, numbers are separated by spaces, tabs,
+ *        commas or semicolons.
+ * @return Values, or std::nullopt at the first token that is not a number
+ *         or on a line with more than two numbers.
+ */
+std::optional<ComplexSeries> parseComplexSeries(std::string_view text);
+
+} // namespace fft
@@ -0,0 +1,469 @@
+/**
+ * @file finance.cpp
+ * @brief Implementation of the time-value-of-money functions.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "finance.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FINANCE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace finance {
+namespace {
+
+/// Value and derivative with respect to the rate.
+struct Sample {
+  long double value;
+  long double slope;
+};
+
+/// Rates scanned for a sign change of the NPV.
+constexpr long double kRateGrid[] = {
+    -0.9999L, -0.999L, -0.99L, -0.95L, -0.9L, -0.75L, -0.5L, -0.25L,
+    -0.1L,    -0.05L,  -0.01L, 0.0L,   0.01L, 0.05L,  0.1L,  0.15L,
+    0.25L,    0.5L,    0.75L,  1.0L,   1.5L,  2.0L,   3.0L,  5.0L,
+    10.0L,    25.0L,   100.0L, 1e3L,   1e4L,  1e6L};
+
+/**
+ * @brief Root of f in (-1, 1e6] by bracketed Newton (Numerical Recipes'
+ *        rtsafe): Newton while it stays inside the bracket and at least
+ *        halves the step, bisection otherwise.
+ * @param f Returns the Sample at a rate; non-finite values are skipped
+ *        while bracketing.
+ */
+template <typename F>
+std::optional<long double> solveRate(F f, long double guess) {
+  if (!std::isfinite(guess) || guess <= -1.0L)
+    guess = 0.1L;
+  // Scan the grid (plus the guess) and keep the sign change nearest it.
+  std::vector<long double> rates(std::begin(kRateGrid), std::end(kRateGrid));
+  rates.push_back(guess);
+  std::sort(rates.begin(), rates.end());
+  long double lo = 0, hi = 0, flo = 0, fhi = 0, best = 0;
+  bool found = false;
+  std::optional<long double> exact; // a grid rate that is a root
+  bool havePrev = false;
+  long double prevRate = 0, prevValue = 0;
+  for (const long double r : rates) {
+    const long double v = f(r).value;
+    if (!std::isfinite(v))
+      continue;
+    if (v == 0.0L) {
+      if (!found || std::fabs(r - guess) < best) {
+        found = true;
+        best = std::fabs(r - guess);
+        exact = r;
+      }
+      continue; // brackets continue from the last non-zero value
+    }
+    if (havePrev && (v < 0) != (prevValue < 0)) {
+      const long double distance =
+          guess < prevRate ? prevRate - guess
+                           : (guess > r ? guess - r : 0.0L);
+      if (!found || distance < best) {
+        found = true;
+        best = distance;
+        exact.reset();
+        lo = prevRate, flo = prevValue, hi = r, fhi = v;
+      }
+    }
+    havePrev = true;
+    prevRate = r, prevValue = v;
+  }
+  if (!found || exact)
+    return exact;
+  if (flo > 0) { // orient so that f(lo) < 0 < f(hi)
+    std::swap(lo, hi);
+    std::swap(flo, fhi);
+  }
+
+  long double r = guess > std::min(lo, hi) && guess < std::max(lo, hi)
+                      ? guess
+                      : (lo + hi) / 2;
+  long double step = std::fabs(hi - lo), lastStep = step;
+  const long double tolerance = 8 * std::numeric_limits<long double>::epsilon();
+  for (int iteration = 0; iteration < 200; ++iteration) {
+    const Sample s = f(r);
+    if (s.value == 0.0L)
+      return r;
+    if (s.value < 0)
+      lo = r;
+    else
+      hi = r;
+    const long double newton = r - s.value / s.slope;
+    const bool inside = std::isfinite(newton) &&
+                        newton > std::min(lo, hi) && newton < std::max(lo, hi);
+    lastStep = step;
+    if (inside && std::fabs(2 * s.value) < std::fabs(lastStep * s.slope)) {
+      step = std::fabs(newton - r);
+      r = newton;
+    } else {
+      const long double mid = (lo + hi) / 2;
+      step = std::fabs(mid - r);
+      r = mid;
+    }
+    if (step <= tolerance * std::max(1.0L, std::fabs(r)) ||
+        std::fabs(hi - lo) <= tolerance * std::max(1.0L, std::fabs(r)))
+      return r;
+  }
+  return r;
+}
+
+/// NPV of periodic flows and its derivative, by Horner in x = 1/(1+r).
+Sample periodic(const std::vector<long double> &amounts, long double rate) {
+  const long double x = 1.0L / (1.0L + rate);
+  long double p = 0.0L, dp = 0.0L;
+  for (std::size_t t = amounts.size(); t-- > 0;) {
+    dp = dp * x + p;
+    p = p * x + amounts[t];
+  }
+  return {p, -dp * x * x}; // dx/dr = -x^2
+}
+
+/// XNPV and its derivative.
+Sample dated(const std::vector<long double> &amounts,
+             const std::vector<std::int64_t> &days, long double rate) {
+  const long double logGrowth = std::log1p(rate);
+  long double value = 0.0L, slope = 0.0L;
+  for (std::size_t i = 0; i < amounts.size(); ++i) {
+    const long double years =
+        static_cast<long double>(days[i] - days.front()) / 365.0L;
+    const long double discounted = amounts[i] * std::exp(-years * logGrowth);
+    value += discounted;
+    slope -= years * discounted / (1.0L + rate);
+  }
+  return {value, slope};
+}
+
+bool changesSign(const std::vector<long double> &amounts) {
+  bool positive = false, negative = false;
+  for (const long double a : amounts) {
+    positive |= a > 0;
+    negative |= a < 0;
+  }
+  return positive && negative;
+}
+
+/// (1 + r)^k - 1, accurate for small r.
+long double growthMinusOne(long double rate, long double k) {
+  return std::expm1(k * std::log1p(rate));
+}
+
+/// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant).
+std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+bool parseAmount(std::string_view text, long double &value) {
+  const char *first = text.data();
+  const char *last = first + text.size();
+  if (first != last && *first == '+')
+    ++first;
+  const auto [end, ec] = std::from_chars(first, last, value);
+  return ec == std::errc() && end == last && std::isfinite(value);
+}
+
+/**
+ * @brief Rows j < m of a block whose balance before row j is
+ *        @p due - @p decay * annuity[j], with annuity[j] = (g^j - 1) / r
+ *        (see schedule()). Both terms are at most a block's worth of
+ *        payments apart, so the difference loses no more than that many
+ *        ulps; rows are independent (two per SSE2 step).
+ */
+void blockRows(double due, double decay, double a, double r,
+               const double *annuity, std::size_t m, const Rows &out) {
+  std::size_t j = 0;
+#ifdef FINANCE_SSE2
+  const __m128d vDue = _mm_set1_pd(due), vDecay = _mm_set1_pd(decay),
+                vA = _mm_set1_pd(a), vR = _mm_set1_pd(r);
+  for (; j + 2 <= m; j += 2) {
+    const __m128d before =
+        _mm_sub_pd(vDue, _mm_mul_pd(vDecay, _mm_loadu_pd(annuity + j)));
+    const __m128d after =
+        _mm_sub_pd(vDue, _mm_mul_pd(vDecay, _mm_loadu_pd(annuity + j + 1)));
+    const __m128d interest = _mm_mul_pd(before, vR);
+    _mm_storeu_pd(out.payment + j, vA);
+    _mm_storeu_pd(out.interest + j, interest);
+    _mm_storeu_pd(out.principal + j, _mm_sub_pd(vA, interest));
+    _mm_storeu_pd(out.balance + j, after);
+  }
+#endif
+  for (; j < m; ++j) {
+    const double before = due - decay * annuity[j];
+    out.payment[j] = a;
+    out.interest[j] = before * r;
+    out.principal[j] = a - out.interest[j];
+    out.balance[j] = due - decay * annuity[j + 1];
+  }
+}
+
+/// Appends "v" with two decimals; @p p must have room for the digits.
+char *putFixed(char *p, char *end, double v) {
+  if (v > -0.005 && v < 0.005)
+    v = 0.0; // no "-0.00"
+  return std::to_chars(p, end, v, std::chars_format::fixed, 2).ptr;
+}
+
+} // namespace
+
+std::optional<long double> npv(long double rate,
+                               const std::vector<long double> &amounts) {
+  if (!(rate > -1.0L))
+    return std::nullopt;
+  const long double value = periodic(amounts, rate).value;
+  if (!std::isfinite(value))
+    return std::nullopt;
+  return value;
+}
+
+std::optional<long double> irr(const std::vector<long double> &amounts,
+                               long double guess) {
+  if (!changesSign(amounts))
+    return std::nullopt;
+  return solveRate([&](long double r) { return periodic(amounts, r); },
+                   guess);
+}
+
+std::optional<long double> xnpv(long double rate,
+                                const std::vector<long double> &amounts,
+                                const std::vector<std::int64_t> &days) {
+  if (!(rate > -1.0L) || amounts.size() != days.size() || amounts.empty())
+    return std::nullopt;
+  const long double value = dated(amounts, days, rate).value;
+  if (!std::isfinite(value))
+    return std::nullopt;
+  return value;
+}
+
+std::optional<long double> xirr(const std::vector<long double> &amounts,
+                                const std::vector<std::int64_t> &days,
+                                long double guess) {
+  if (amounts.size() != days.size() || !changesSign(amounts))
+    return std::nullopt;
+  return solveRate([&](long double r) { return dated(amounts, days, r); },
+                   guess);
+}
+
+std::optional<long double> pmt(long double rate, long double periods,
+                               long double presentValue,
+                               long double futureValue, bool atStart) {
+  if (!(periods > 0) || !(rate > -1.0L))
+    return std::nullopt;
+  long double result;
+  if (rate == 0.0L) {
+    result = -(presentValue + futureValue) / periods;
+  } else {
+    const long double gm1 = growthMinusOne(rate, periods);
+    result = -rate * (presentValue * (gm1 + 1.0L) + futureValue) /
+             ((atStart ? 1.0L + rate : 1.0L) * gm1);
+  }
+  if (!std::isfinite(result))
+    return std::nullopt;
+  return result;
+}
+
+std::optional<double> payment(const Loan &loan) {
+  if (loan.periods == 0 || !std::isfinite(loan.principal) ||
+      !std::isfinite(loan.rate))
+    return std::nullopt;
+  const auto p = pmt(loan.rate, static_cast<long double>(loan.periods),
+                     loan.principal);
+  if (!p || !std::isfinite(static_cast<double>(*p)))
+    return std::nullopt;
+  return -static_cast<double>(*p);
+}
+
+bool schedule(const Loan &loan, std::uint64_t first, std::size_t count,
+              const Rows &out) {
+  const auto level = payment(loan);
+  if (!level || first > loan.periods || count > loan.periods - first)
+    return false;
+  if (count == 0)
+    return true;
+  const double a = *level, r = loan.rate;
+  const long double logG = std::log1p(static_cast<long double>(r));
+
+  // annuity[j] = (g^j - 1) / r = 1 + g + ... + g^(j-1), j <= block.
+  double annuity[kScheduleBlock + 1];
+  const std::size_t block = std::min<std::size_t>(count, kScheduleBlock);
+  for (std::size_t j = 0; j <= block; ++j) {
+    const long double k = static_cast<long double>(j);
+    annuity[j] = static_cast<double>(r == 0.0 ? k : std::expm1(k * logG) / r);
+  }
+
+  // With m payments left before the block, the balance before its row j is
+  // A (1 - g^-(m-j)) / r = A (1 - g^-m) / r - A g^-m annuity[j].
+  for (std::size_t done = 0; done < count;) {
+    const std::size_t m = std::min(block, count - done);
+    const long double left =
+        static_cast<long double>(loan.periods - first - done);
+    double due, decay;
+    if (r == 0.0) {
+      due = static_cast<double>(a * left);
+      decay = a;
+    } else {
+      due = static_cast<double>(-a * std::expm1(-left * logG) / r);
+      decay = static_cast<double>(a * std::exp(-left * logG));
+    }
+    blockRows(due, decay, a, r, annuity, m,
+              {out.payment + done, out.interest + done, out.principal + done,
+               out.balance + done});
+    done += m;
+  }
+
+  if (first + count == loan.periods) { // settle the rounding residue
+    const std::size_t j = count - 1;
+    const double before = out.balance[j] + out.principal[j];
+    out.principal[j] = before;
+    out.payment[j] = before + out.interest[j];
+    out.balance[j] = 0.0;
+  }
+  return true;
+}
+
+bool writeSchedules(const std::vector<Loan> &loans, std::FILE *file,
+                    const std::atomic<bool> *cancel,
+                    std::atomic<std::uint64_t> *progress) {
+  for (const Loan &loan : loans)
+    if (!payment(loan))
+      return false;
+
+  // Rows are formatted into a small scratch line and appended to a 64 KiB
+  // buffer that is written with one fwrite when full. Each field gets a
+  // fixed budget of kField characters (sign, 18 digits and ".dd", or
+  // exponent form beyond 1e18).
+  constexpr std::size_t kBuffer = std::size_t{1} << 16, kField = 32;
+  std::vector<char> storage(kBuffer);
+  char *const buffer = storage.data();
+  std::size_t used = 0;
+  auto append = [&](const char *text, std::size_t n) {
+    if (kBuffer - used < n) {
+      if (std::fwrite(buffer, 1, used, file) != used)
+        return false;
+      used = 0;
+    }
+    std::memcpy(buffer + used, text, n);
+    used += n;
+    return true;
+  };
+  static constexpr char kHeader[] =
+      "loan,period,payment,interest,principal,balance\n";
+  append(kHeader, sizeof kHeader - 1);
+
+  double pay[kScheduleBlock], interest[kScheduleBlock],
+      principal[kScheduleBlock], balance[kScheduleBlock];
+  const Rows rows{pay, interest, principal, balance};
+  char line[6 * (kField + 1)];
+  for (std::size_t l = 0; l < loans.size(); ++l) {
+    for (std::uint64_t first = 0; first < loans[l].periods;
+         first += kScheduleBlock) {
+      if (cancel && cancel->load(std::memory_order_relaxed))
+        return false;
+      const std::size_t m = static_cast<std::size_t>(
+          std::min<std::uint64_t>(kScheduleBlock, loans[l].periods - first));
+      schedule(loans[l], first, m, rows);
+      for (std::size_t j = 0; j < m; ++j) {
+        char *p = std::to_chars(line, line + kField, l + 1).ptr;
+        *p++ = ',';
+        p = std::to_chars(p, p + kField, first + j + 1).ptr;
+        for (const double v : {pay[j], interest[j], principal[j], balance[j]}) {
+          *p++ = ',';
+          p = std::fabs(v) < 1e18 ? putFixed(p, p + kField, v)
+                                  : std::to_chars(p, p + kField, v).ptr;
+        }
+        *p++ = '\n';
+        if (!append(line, static_cast<std::size_t>(p - line)))
+          return false;
+      }
+      if (progress)
+        progress->fetch_add(m, std::memory_order_relaxed);
+    }
+  }
+  return std::fwrite(buffer, 1, used, file) == used;
+}
+
+std::optional<std::int64_t> parseDate(std::string_view text) {
+  if (text.size() != 10 || text[4] != '-' || text[7] != '-')
+    return std::nullopt;
+  auto field = [&](std::size_t at, std::size_t n, unsigned &value) {
+    const auto [end, ec] =
+        std::from_chars(text.data() + at, text.data() + at + n, value);
+    return ec == std::errc() && end == text.data() + at + n;
+  };
+  unsigned y = 0, m = 0, d = 0;
+  if (!field(0, 4, y) || !field(5, 2, m) || !field(8, 2, d) || m < 1 ||
+      m > 12 || d < 1)
+    return std::nullopt;
+  static constexpr unsigned kDays[] = {31, 28, 31, 30, 31, 30,
+                                       31, 31, 30, 31, 30, 31};
+  const bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+  if (d > kDays[m - 1] + (m == 2 && leap))
+    return std::nullopt;
+  return daysFromCivil(y, m, d);
+}
+
+std::optional<CashFlows> parseCashFlows(std::string_view text) {
+  CashFlows flows;
+  bool dated = false;
+  auto isSeparator = [](char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == ';';
+  };
+  auto nextToken = [&](std::string_view &line) {
+    while (!line.empty() && isSeparator(line.front()))
+      line.remove_prefix(1);
+    std::size_t n = 0;
+    while (n < line.size() && !isSeparator(line[n]))
+      ++n;
+    const std::string_view token = line.substr(0, n);
+    line.remove_prefix(n);
+    return token;
+  };
+  while (!text.empty()) {
+    const std::size_t eol = std::min(text.find('\n'), text.size());
+    std::string_view line = text.substr(0, eol);
+    text.remove_prefix(std::min(eol + 1, text.size()));
+    std::string_view token = nextToken(line);
+    if (token.empty())
+      continue;
+    const auto day = parseDate(token);
+    if (flows.amounts.empty())
+      dated = day.has_value();
+    if (day.has_value() != dated)
+      return std::nullopt;
+    if (dated) { // exactly "date amount"
+      flows.days.push_back(*day);
+      token = nextToken(line);
+      if (!nextToken(line).empty())
+        return std::nullopt;
+    }
+    for (; !token.empty(); token = nextToken(line)) {
+      long double value = 0.0L;
+      if (!parseAmount(token, value))
+        return std::nullopt;
+      flows.amounts.push_back(value);
+      if (dated)
+        break;
+    }
+    if (dated && flows.amounts.size() != flows.days.size())
+      return std::nullopt; // date without an amount
+  }
+  return flows;
+}
+
+} // namespace finance
@@ -0,0 +1,156 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file finance.h
+ * @brief Time value of money: NPV, IRR, XIRR, PMT and amortization schedules.
+ *
+ * Cash flows follow the usual sign convention (money received positive,
+ * money paid negative). NPV/IRR/XIRR/PMT work in long double like the rest
+ * of the engine. Rates are solved by bracketed Newton: the rate axis is
+ * scanned for sign changes of the NPV, the bracket nearest the guess is
+ * kept, and each Newton step that would leave the bracket or converges too
+ * slowly is replaced by bisection, so the solver cannot diverge or cycle.
+ *
+ * Schedules are computed in double, in blocks of kScheduleBlock rows. A
+ * balance is the present value of the payments still due,
+ * A (1 - g^-k) / r for k payments left, never a grown-up opening balance
+ * minus grown-up payments (that difference cancels catastrophically over
+ * long horizons). A block with m payments left at its start writes this as
+ * A (1 - g^-m) / r - A g^-m (g^j - 1) / r; with (g^j - 1) / r tabulated
+ * once per call every row of a block is independent and rows are computed
+ * two per SSE2 step. No block depends on another, so any row can be
+ * computed without the ones before it (a table view only asks for what it
+ * shows) and comes out the same as in a full run. writeSchedules()
+ * formats rows with std::to_chars into one 64 KiB buffer, with no per-row
+ * allocation.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace finance {
+
+/// Rows computed per vectorized block.
+constexpr std::size_t kScheduleBlock = 256;
+
+/** @brief Cash flows, optionally dated. */
+struct CashFlows {
+  std::vector<long double> amounts;
+  std::vector<std::int64_t> days; ///< Days since 1970-01-01; empty if undated.
+};
+
+/** @brief Fully amortizing loan with a level payment per period. */
+struct Loan {
+  double principal = 0.0;    ///< Amount borrowed.
+  double rate = 0.0;         ///< Interest rate per period (0.005 = 0.5%).
+  std::uint64_t periods = 0; ///< Number of payments.
+};
+
+/** @brief Output columns of schedule(), @c count values each. */
+struct Rows {
+  double *payment;
+  double *interest;
+  double *principal;
+  double *balance; ///< Balance after the payment.
+};
+
+/**
+ * @brief Net present value; amounts[t] falls at the end of period t
+ *        (amounts[0] is not discounted).
+ * @return NPV, or std::nullopt for rate <= -1 or a non-finite result.
+ */
+std::optional<long double> npv(long double rate,
+                               const std::vector<long double> &amounts);
+
+/**
+ * @brief Internal rate of return of periodic flows (NPV = 0).
+ * @param guess Start point; with several roots, the one bracketed nearest
+ *        the guess is returned.
+ * @return Rate per period, or std::nullopt when the flows do not change
+ *         sign or no root is found in (-1, 1e6].
+ */
+std::optional<long double> irr(const std::vector<long double> &amounts,
+                               long double guess = 0.1L);
+
+/**
+ * @brief Net present value of dated flows, discounted to the first date
+ *        on an actual/365 basis.
+ * @return XNPV, or std::nullopt for rate <= -1, mismatched sizes or a
+ *         non-finite result.
+ */
+std::optional<long double> xnpv(long double rate,
+                                const std::vector<long double> &amounts,
+                                const std::vector<std::int64_t> &days);
+
+/**
+ * @brief Annual internal rate of return of dated flows (XNPV = 0).
+ * @return Rate, or std::nullopt as for irr().
+ */
+std::optional<long double> xirr(const std::vector<long double> &amounts,
+                                const std::vector<std::int64_t> &days,
+                                long double guess = 0.1L);
+
+/**
+ * @brief Level payment per period (spreadsheet PMT).
+ * @param rate Rate per period.
+ * @param periods Number of periods.
+ * @param presentValue Present value (a loan received is positive).
+ * @param futureValue Value left after the last payment.
+ * @param atStart Payments at the start of each period.
+ * @return Payment (negative for a loan received), or std::nullopt for
+ *         periods <= 0, rate <= -1 or a non-finite result.
+ */
+std::optional<long double> pmt(long double rate, long double periods,
+                               long double presentValue,
+                               long double futureValue = 0.0L,
+                               bool atStart = false);
+
+/**
+ * @brief Level payment of a loan (positive).
+ * @return Payment, or std::nullopt for an invalid loan (no periods,
+ *         rate <= -1, non-finite values).
+ */
+std::optional<double> payment(const Loan &loan);
+
+/**
+ * @brief Rows [first, first + count) of the loan's schedule (row i is
+ *        period i + 1). The last row pays off the remaining balance
+ *        exactly, so its payment can differ by rounding.
+ * @return false for an invalid loan or rows past the last period.
+ */
+bool schedule(const Loan &loan, std::uint64_t first, std::size_t count,
+              const Rows &out);
+
+/**
+ * @brief Write the schedules of @p loans as CSV
+ *        (loan,period,payment,interest,principal,balance), two decimals.
+ * @param cancel Polled before each block of rows; once set, writing stops.
+ * @param progress Rows written so far, for a progress bar.
+ * @return false if a loan is invalid (nothing is written), on a write
+ *         error, or when @p cancel was set (the file is left partial).
+ */
+bool writeSchedules(const std::vector<Loan> &loans, std::FILE *file,
+                    const std::atomic<bool> *cancel = nullptr,
+                    std::atomic<std::uint64_t> *progress = nullptr);
+
+/**
+ * @brief Days since 1970-01-01 of an ISO date (YYYY-MM-DD).
+ * @return Day number, or std::nullopt for a malformed or invalid date.
+ */
+std::optional<std::int64_t> parseDate(std::string_view text);
+
+/**
+ * @brief Undated amounts separated by spaces, commas, semicolons or lines,
+ *        or one "YYYY-MM-DD amount" per line; either every flow is dated
+ *        or none is.
+ * @return Flows, or std::nullopt at the first malformed line.
+ */
+std::optional<CashFlows> parseCashFlows(std::string_view text);
+
+} // namespace finance
@@ -0,0 +1,144 @@
+/**
+ * @file ingest.cpp
+ * @brief Implementation of the incremental input ingestion.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "ingest.h"
+#include "basicengine.h"
+#include "decimal.h"
+#include "expression.h"
+#include <algorithm>
+
+namespace ingest {
+namespace {
+
+bool isSeparator(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' ||
+         c == ';';
+}
+
+/// Whether the whole of @p text is a decimal number (see decimal::parse).
+bool parseNumber(std::string_view text, long double &value) {
+  const char *end = text.data() + text.size();
+  const auto [last, ec] = decimal::parse(text.data(), end, value);
+  return ec == std::errc() && last == end;
+}
+
+} // namespace
+
+void Ingestor::feed(std::string_view chunk) {
+  bytes_ += chunk.size();
+  if (keepText_) {
+    if (text_.size() + chunk.size() <= kMaxExpressionBytes)
+      text_.append(chunk);
+    else { // too long for an expression; numbers only from here on
+      keepText_ = false;
+      std::string().swap(text_);
+    }
+  }
+  if (!numbers_)
+    return;
+
+  std::size_t i = 0;
+  if (!carry_.empty()) { // finish the token cut by the previous chunk
+    while (i < chunk.size() && !isSeparator(chunk[i]))
+      ++i;
+    carry_.append(chunk.substr(0, i));
+    if (i == chunk.size())
+      return;
+    const std::string carried = std::move(carry_);
+    carry_.clear();
+    if (!token(carried))
+      return;
+  }
+  while (i < chunk.size()) {
+    while (i < chunk.size() && isSeparator(chunk[i]))
+      ++i;
+    const std::size_t start = i;
+    while (i < chunk.size() && !isSeparator(chunk[i]))
+      ++i;
+    if (start == i)
+      break;
+    if (i == chunk.size()) { // may continue in the next chunk
+      carry_.assign(chunk.substr(start));
+      break;
+    }
+    if (!token(chunk.substr(start, i - start)))
+      return;
+  }
+}
+
+bool Ingestor::token(std::string_view text) {
+  long double value = 0.0L;
+  if (!parseNumber(text, value)) {
+    numbers_ = false;
+    bad_.assign(text.substr(0, 40));
+    decltype(batch_)().swap(batch_);
+    return false;
+  }
+  if (summary_.count++ == 0)
+    summary_.first.assign(text);
+  summary_.min = std::min(summary_.min, value);
+  summary_.max = std::max(summary_.max, value);
+  batch_.push_back(static_cast<Engine::Real>(value));
+  if (batch_.size() == kBatch)
+    flush();
+  return true;
+}
+
+/**
+ * @brief Pairwise reduction: add the upper half onto the lower half until
+ *        one value is left, so rounding grows with log(kBatch), not kBatch.
+ */
+void Ingestor::flush() {
+  std::size_t n = batch_.size();
+  if (n == 0)
+    return;
+  Engine::Real *data = batch_.data();
+  while (n > 1) {
+    const std::size_t half = n / 2;
+    BasicEngine<Engine::Real>::applyBatch(Engine::Op::Add, data,
+                                          data + n - half, data, half);
+    n -= half;
+  }
+  summary_.sum = *Engine::apply(Engine::Op::Add, summary_.sum,
+                                static_cast<long double>(data[0]));
+  batch_.clear();
+}
+
+Result Ingestor::finish() {
+  if (numbers_ && !carry_.empty()) {
+    const std::string carried = std::move(carry_);
+    carry_.clear();
+    token(carried);
+  }
+  Result result;
+  result.bytes = bytes_;
+  if (numbers_) {
+    flush();
+    result.numbers = summary_;
+    result.value = summary_.sum;
+    result.kind = summary_.count == 0   ? Result::Kind::Empty
+                  : summary_.count == 1 ? Result::Kind::Number
+                                        : Result::Kind::List;
+    return result;
+  }
+  if (!keepText_) {
+    result.kind = Result::Kind::Invalid;
+    result.error = "'" + bad_ + "' is not a number";
+    return result;
+  }
+  const auto expr = Expression::compile(text_, {}, &result.error);
+  if (!expr) {
+    result.kind = Result::Kind::Invalid;
+    return result;
+  }
+  result.kind = Result::Kind::Expression;
+  result.value = expr->evaluate(nullptr);
+  return result;
+}
+
+} // namespace ingest
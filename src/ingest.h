@@ -0,0 +1,91 @@
+#pragma once
+#include "precision.h"
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file ingest.h
+ * @brief Incremental ingestion of pasted or dropped input (numbers or an
+ *        expression), fed chunk by chunk from a worker thread.
+ *
+ * An Ingestor receives the input in arbitrary chunks (a token may straddle
+ * two of them). While every token is a number, tokens are validated as they
+ * arrive (no locale, no allocation per token) and
+ * collected into batches that the engine reduces in its precision tier with
+ * BasicEngine<Engine::Real>::applyBatch, halving each batch pairwise, so a
+ * list of millions of values is summed in one pass with pairwise rounding.
+ * When a token is not a number the whole input is read as one expression
+ * instead (Expression grammar, no variables), as long as it is short enough
+ * to keep in memory.
+ *
+ * Nothing here touches Qt: the UI runs an Ingestor on a QThread and only
+ * polls bytes() for its progress bar.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace ingest {
+
+/// Values per engine batch.
+constexpr std::size_t kBatch = 4096;
+/// Longest input still kept for evaluation as an expression.
+constexpr std::size_t kMaxExpressionBytes = std::size_t{1} << 20;
+
+/** @brief Aggregate of a list of numbers. */
+struct Summary {
+  std::size_t count = 0; ///< Numbers read.
+  long double sum = 0.0L;
+  long double min = std::numeric_limits<long double>::infinity();
+  long double max = -std::numeric_limits<long double>::infinity();
+  std::string first; ///< Text of the first number, as written.
+};
+
+/** @brief Outcome of an ingestion. */
+struct Result {
+  enum class Kind {
+    Empty,      ///< Only separators.
+    Number,     ///< One number; Summary::first keeps its digits.
+    List,       ///< Several numbers; see numbers.
+    Expression, ///< Evaluated expression; see value.
+    Invalid     ///< Neither; see error.
+  };
+  Kind kind = Kind::Empty;
+  Summary numbers;
+  long double value = 0.0L; ///< Expression value, or the list's sum.
+  std::string error;        ///< Parse error for Kind::Invalid.
+  std::size_t bytes = 0;    ///< Input size.
+};
+
+/** @brief Chunk-by-chunk tokenizer, validator and reducer. */
+class Ingestor {
+public:
+  /** @brief Consume the next chunk of input. */
+  void feed(std::string_view chunk);
+
+  /** @brief Flush the last token and classify the input. */
+  Result finish();
+
+  /** @brief Bytes fed so far. */
+  std::size_t bytes() const { return bytes_; }
+
+private:
+  /// Validate one complete token; false once the input is not a list.
+  bool token(std::string_view text);
+  /// Reduce the pending batch through the engine into summary_.sum.
+  void flush();
+
+  std::size_t bytes_ = 0;
+  bool numbers_ = true;          ///< Every token so far was a number.
+  bool keepText_ = true;         ///< text_ still holds the whole input.
+  std::string text_;             ///< Raw input, for the expression path.
+  std::string carry_;            ///< Token cut at the end of a chunk.
+  std::string bad_;              ///< First token that is not a number.
+  /// Pending values, in the engine's tier (Engine::Real).
+  std::vector<precision::Real<kDefaultPrecision>> batch_;
+  Summary summary_;
+};
+
+} // namespace ingest
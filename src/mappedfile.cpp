@@ -0,0 +1,105 @@
+/**
+ * @file mappedfile.cpp
+ * @brief Implementation of MappedFile (mmap with a read() fallback).
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "mappedfile.h"
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CALCULATOR_HAVE_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Map (or read) a file.
+ * @param path File to open.
+ * @param error Receives a message on failure.
+ * @return The file contents, or std::nullopt on failure.
+ */
+std::optional<MappedFile> MappedFile::open(const std::string &path,
+                                           std::string *error) {
+  MappedFile file;
+#ifdef CALCULATOR_HAVE_MMAP
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (error)
+      *error = path + ": " + std::strerror(errno);
+    return std::nullopt;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    if (error)
+      *error = path + ": " + std::strerror(errno);
+    ::close(fd);
+    return std::nullopt;
+  }
+  file.size_ = static_cast<std::size_t>(st.st_size);
+  if (file.size_ > 0) {
+    void *p = ::mmap(nullptr, file.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      if (error)
+        *error = path + ": mmap: " + std::strerror(errno);
+      ::close(fd);
+      return std::nullopt;
+    }
+    // The converter reads front to back; let the kernel read ahead.
+    ::madvise(p, file.size_, MADV_SEQUENTIAL);
+    file.data_ = static_cast<const char *>(p);
+    file.mapped_ = true;
+  }
+  ::close(fd); // the mapping keeps its own reference
+#else
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    if (error)
+      *error = path + ": cannot open";
+    return std::nullopt;
+  }
+  file.size_ = static_cast<std::size_t>(in.tellg());
+  file.buffer_.resize(file.size_);
+  in.seekg(0);
+  if (file.size_ > 0 && !in.read(file.buffer_.data(), file.size_)) {
+    if (error)
+      *error = path + ": read failed";
+    return std::nullopt;
+  }
+  file.data_ = file.buffer_.empty() ? nullptr : file.buffer_.data();
+#endif
+  return file;
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    reset();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapped_ = std::exchange(other.mapped_, false);
+    buffer_ = std::move(other.buffer_); // moving keeps data_ valid
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { reset(); }
+
+void MappedFile::reset() {
+#ifdef CALCULATOR_HAVE_MMAP
+  if (mapped_)
+    ::munmap(const_cast<char *>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+}
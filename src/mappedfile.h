@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @file mappedfile.h
+ * @brief Declaration of MappedFile (read-only memory-mapped input file).
+ *
+ * On POSIX systems the file is mapped with mmap and advised for sequential
+ * access, so multi-gigabyte inputs are paged in on demand instead of being
+ * copied. Other platforms fall back to reading the whole file into memory.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Map a file for reading.
+   * @param path File to open.
+   * @param error Receives a message on failure (optional).
+   * @return The mapping, or std::nullopt if the file cannot be read.
+   */
+  static std::optional<MappedFile> open(const std::string &path,
+                                        std::string *error = nullptr);
+
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  /** @brief First byte of the file (nullptr when empty). */
+  const char *data() const { return data_; }
+  /** @brief File size in bytes. */
+  std::size_t size() const { return size_; }
+
+private:
+  MappedFile() = default;
+  /// Release the mapping (if any) and reset to empty.
+  void reset();
+
+  const char *data_ = nullptr; ///< Mapped (or buffered) contents.
+  std::size_t size_ = 0;       ///< Size in bytes.
+  bool mapped_ = false;        ///< Whether data_ must be munmap'ed.
+  std::vector<char> buffer_;   ///< Fallback storage when mmap is unavailable.
+};
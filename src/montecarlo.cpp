@@ -0,0 +1,321 @@
+/**
+ * @file montecarlo.cpp
+ * @brief Implementation of the parallel Monte Carlo simulator.
+ *
+ * Work is divided into fixed chunks handed out through an atomic counter.
+ * Each chunk draws from its own xoshiro256** stream (seeded with splitmix64
+ * from the base seed and chunk index), evaluates the expression in batches and
+ * records count/mean/M2, which are merged in chunk order with Chan's formula.
+ * Histogram counts are integers and are simply summed across workers.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "montecarlo.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace montecarlo {
+namespace {
+
+constexpr std::uint64_t kChunk = 1u << 18; ///< Rows per independent stream.
+constexpr std::size_t kBlock = 4096;       ///< Rows per batch evaluation.
+constexpr std::size_t kPilot = 4096;       ///< Rows used to size histogram.
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+/// splitmix64 step, used to expand a seed into generator state.
+std::uint64_t splitmix64(std::uint64_t &x) {
+  std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/// xoshiro256** generator (Blackman & Vigna).
+class Xoshiro256 {
+public:
+  Xoshiro256(std::uint64_t seed, std::uint64_t stream) {
+    std::uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull);
+    for (auto &w : s_)
+      w = splitmix64(x);
+  }
+
+  std::uint64_t next() {
+    const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+    const std::uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = rotl(s_[3], 45);
+    return result;
+  }
+
+  /// Uniform double in [0, 1).
+  double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+  /// Uniform double in (0, 1] (safe for log).
+  double uniformOpen() {
+    return static_cast<double>((next() >> 11) + 1) * 0x1.0p-53;
+  }
+
+private:
+  static std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+  std::uint64_t s_[4];
+};
+
+/// Fill @p out with @p n draws from @p d.
+void draw(Xoshiro256 &rng, const DistributionSpec &d, double *out,
+          std::size_t n) {
+  switch (d.kind) {
+  case Distribution::Uniform: {
+    const double width = d.b - d.a;
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = d.a + width * rng.uniform();
+    break;
+  }
+  case Distribution::Exponential:
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = -std::log(rng.uniformOpen()) / d.a;
+    break;
+  case Distribution::Normal:
+  case Distribution::LogNormal: {
+    // Box-Muller, two normals per pair of uniforms.
+    for (std::size_t i = 0; i < n; i += 2) {
+      const double r = std::sqrt(-2.0 * std::log(rng.uniformOpen()));
+      const double t = kTwoPi * rng.uniform();
+      out[i] = d.a + d.b * r * std::cos(t);
+      if (i + 1 < n)
+        out[i + 1] = d.a + d.b * r * std::sin(t);
+    }
+    if (d.kind == Distribution::LogNormal)
+      for (std::size_t i = 0; i < n; ++i)
+        out[i] = std::exp(out[i]);
+    break;
+  }
+  }
+}
+
+/// Running count/mean/M2 of one chunk.
+struct Moments {
+  std::uint64_t n = 0;
+  double mean = 0.0;
+  double m2 = 0.0;
+
+  /// Chan et al. parallel merge.
+  void merge(const Moments &o) {
+    if (o.n == 0)
+      return;
+    if (n == 0) {
+      *this = o;
+      return;
+    }
+    const double total = static_cast<double>(n + o.n);
+    const double delta = o.mean - mean;
+    mean += delta * static_cast<double>(o.n) / total;
+    m2 += o.m2 + delta * delta * static_cast<double>(n) *
+                     static_cast<double>(o.n) / total;
+    n += o.n;
+  }
+};
+
+/// Acklam's rational approximation of the inverse standard normal CDF.
+double inverseNormal(double p) {
+  static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                             -2.759285104469687e+02, 1.383577518672690e+02,
+                             -3.066479806614716e+01, 2.506628277459239e+00};
+  static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                             -1.556989798598866e+02, 6.680131188771972e+01,
+                             -1.328068155288572e+01};
+  static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                             -2.400758277161838e+00, -2.549732539343734e+00,
+                             4.374664141464968e+00,  2.938163982698783e+00};
+  static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                             2.445134137142996e+00, 3.754408661907416e+00};
+  const double lo = 0.02425;
+  if (p < lo) {
+    const double q = std::sqrt(-2.0 * std::log(p));
+    return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q +
+            c[5]) /
+           ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+  }
+  if (p > 1.0 - lo)
+    return -inverseNormal(1.0 - p);
+  const double q = p - 0.5;
+  const double r = q * q;
+  return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) *
+         q /
+         (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+bool validSpec(const DistributionSpec &d) {
+  switch (d.kind) {
+  case Distribution::Uniform:
+    return std::isfinite(d.a) && std::isfinite(d.b) && d.b >= d.a;
+  case Distribution::Exponential:
+    return d.a > 0.0 && std::isfinite(d.a);
+  case Distribution::Normal:
+  case Distribution::LogNormal:
+    return std::isfinite(d.a) && d.b >= 0.0 && std::isfinite(d.b);
+  }
+  return false;
+}
+
+} // namespace
+
+/**
+ * @brief Run the simulation across all requested threads.
+ * @param expr Expression to evaluate per row.
+ * @param dist Distribution of every variable.
+ * @param options Run options.
+ * @return Statistics, or std::nullopt on invalid parameters or when
+ *         cancelled.
+ */
+std::optional<Result> simulate(const Expression &expr,
+                               const DistributionSpec &dist,
+                               const Options &options) {
+  if (options.samples == 0 || options.bins == 0 || !validSpec(dist) ||
+      !(options.confidence > 0.0 && options.confidence < 1.0))
+    return std::nullopt;
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t vars = std::max<std::size_t>(expr.variableCount(), 1);
+
+  // Pilot: the first rows of chunk 0 decide the histogram range.
+  double lo = std::numeric_limits<double>::infinity();
+  double hi = -lo;
+  {
+    Xoshiro256 rng(options.seed, 0);
+    const std::size_t n =
+        static_cast<std::size_t>(std::min<std::uint64_t>(kPilot, options.samples));
+    std::vector<double> cols(vars * n), out(n);
+    std::vector<const double *> ptrs(vars);
+    for (std::size_t v = 0; v < vars; ++v) {
+      draw(rng, dist, cols.data() + v * n, n);
+      ptrs[v] = cols.data() + v * n;
+    }
+    expr.evaluateBatch(ptrs.data(), out.data(), n);
+    for (double y : out)
+      if (std::isfinite(y)) {
+        lo = std::min(lo, y);
+        hi = std::max(hi, y);
+      }
+  }
+  if (!(lo <= hi)) {
+    lo = 0.0;
+    hi = 1.0;
+  } else if (lo == hi) {
+    lo -= 0.5;
+    hi += 0.5;
+  }
+  const double binScale = static_cast<double>(options.bins) / (hi - lo);
+
+  const std::uint64_t chunks = (options.samples + kChunk - 1) / kChunk;
+  std::vector<Moments> perChunk(static_cast<std::size_t>(chunks));
+  std::atomic<std::uint64_t> nextChunk{0};
+
+  unsigned threads = options.threads ? options.threads
+                                     : std::thread::hardware_concurrency();
+  threads = static_cast<unsigned>(
+      std::max<std::uint64_t>(1, std::min<std::uint64_t>(threads, chunks)));
+  std::vector<std::vector<std::uint64_t>> histograms(
+      threads, std::vector<std::uint64_t>(options.bins, 0));
+
+  auto worker = [&](unsigned id) {
+    std::vector<double> cols(vars * kBlock), out(kBlock);
+    std::vector<const double *> ptrs(vars);
+    for (std::size_t v = 0; v < vars; ++v)
+      ptrs[v] = cols.data() + v * kBlock;
+    std::vector<std::uint64_t> &hist = histograms[id];
+    const std::size_t lastBin = options.bins - 1;
+
+    for (std::uint64_t c; (c = nextChunk.fetch_add(1)) < chunks;) {
+      if (options.cancel && options.cancel->load(std::memory_order_relaxed))
+        break;
+      Xoshiro256 rng(options.seed, c);
+      const std::uint64_t begin = c * kChunk;
+      const std::uint64_t rows =
+          std::min<std::uint64_t>(kChunk, options.samples - begin);
+      Moments acc;
+      for (std::uint64_t done = 0; done < rows; done += kBlock) {
+        const std::size_t n =
+            static_cast<std::size_t>(std::min<std::uint64_t>(kBlock, rows - done));
+        for (std::size_t v = 0; v < vars; ++v)
+          draw(rng, dist, cols.data() + v * kBlock, n);
+        expr.evaluateBatch(ptrs.data(), out.data(), n);
+
+        // Two-pass moments over the block, then merge into the chunk.
+        Moments blk;
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+          if (std::isfinite(out[i])) {
+            sum += out[i];
+            ++blk.n;
+          }
+        if (blk.n == 0)
+          continue;
+        blk.mean = sum / static_cast<double>(blk.n);
+        for (std::size_t i = 0; i < n; ++i)
+          if (std::isfinite(out[i])) {
+            const double dv = out[i] - blk.mean;
+            blk.m2 += dv * dv;
+            const double pos = (out[i] - lo) * binScale;
+            const std::size_t bin =
+                pos <= 0.0 ? 0
+                           : std::min(static_cast<std::size_t>(pos), lastBin);
+            ++hist[bin];
+          }
+        acc.merge(blk);
+      }
+      perChunk[static_cast<std::size_t>(c)] = acc;
+      if (options.progress)
+        options.progress->fetch_add(rows, std::memory_order_relaxed);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(worker, t);
+  worker(0);
+  for (auto &th : pool)
+    th.join();
+  if (options.cancel && options.cancel->load())
+    return std::nullopt;
+
+  Moments total;
+  for (const Moments &m : perChunk)
+    total.merge(m);
+
+  Result r;
+  r.samples = options.samples;
+  r.valid = total.n;
+  r.histMin = lo;
+  r.histMax = hi;
+  r.histogram.assign(options.bins, 0);
+  for (const auto &h : histograms)
+    for (std::size_t i = 0; i < options.bins; ++i)
+      r.histogram[i] += h[i];
+  if (total.n > 0) {
+    r.mean = total.mean;
+    r.stddev = total.n > 1
+                   ? std::sqrt(total.m2 / static_cast<double>(total.n - 1))
+                   : 0.0;
+    const double z = inverseNormal(0.5 + options.confidence / 2.0);
+    const double half = z * r.stddev / std::sqrt(static_cast<double>(total.n));
+    r.ciLow = r.mean - half;
+    r.ciHigh = r.mean + half;
+  }
+  r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start)
+                  .count();
+  return r;
+}
+
+} // namespace montecarlo
@@ -0,0 +1,80 @@
+#pragma once
+#include "expression.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @file montecarlo.h
+ * @brief Parallel Monte Carlo simulation over a compiled Expression.
+ *
+ * Every variable of the expression receives an independent draw from the
+ * selected distribution. Samples are split into fixed-size chunks, each with
+ * its own xoshiro256** stream derived from the seed, and per-chunk statistics
+ * are merged in chunk order. The result is therefore reproducible for a given
+ * seed regardless of how many threads ran the simulation.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace montecarlo {
+
+/**
+ * @brief Supported sampling distributions.
+ * - Uniform(a, b): a = lower bound, b = upper bound.
+ * - Normal(a, b): a = mean, b = standard deviation.
+ * - Exponential(a): a = rate (lambda); b is ignored.
+ * - LogNormal(a, b): exp of Normal(a, b).
+ */
+enum class Distribution { Uniform, Normal, Exponential, LogNormal };
+
+/** @brief Distribution kind plus its two parameters. */
+struct DistributionSpec {
+  Distribution kind = Distribution::Uniform; ///< Distribution family.
+  double a = 0.0;                            ///< First parameter.
+  double b = 1.0;                            ///< Second parameter.
+};
+
+/** @brief Knobs for a simulation run. */
+struct Options {
+  std::uint64_t samples = 1000000; ///< Number of draws (rows).
+  std::uint64_t seed = 0x5EC0DE;   ///< Base seed for all streams.
+  unsigned threads = 0;            ///< Worker count; 0 = all cores.
+  std::size_t bins = 20;           ///< Histogram bin count.
+  double confidence = 0.95;        ///< Two-sided confidence level.
+  /// Polled before each chunk; once set, the run stops early.
+  const std::atomic<bool> *cancel = nullptr;
+  /// Rows finished so far, for a progress bar.
+  std::atomic<std::uint64_t> *progress = nullptr;
+};
+
+/** @brief Summary statistics of a run. */
+struct Result {
+  std::uint64_t samples = 0;  ///< Rows drawn.
+  std::uint64_t valid = 0;    ///< Rows whose result was finite.
+  double mean = 0.0;          ///< Sample mean over valid rows.
+  double stddev = 0.0;        ///< Sample standard deviation.
+  double ciLow = 0.0;         ///< Lower confidence bound of the mean.
+  double ciHigh = 0.0;        ///< Upper confidence bound of the mean.
+  double histMin = 0.0;       ///< Left edge of the first bin.
+  double histMax = 0.0;       ///< Right edge of the last bin.
+  std::vector<std::uint64_t> histogram; ///< Counts (edge bins absorb outliers).
+  double seconds = 0.0;       ///< Wall-clock duration of the run.
+};
+
+/**
+ * @brief Run a simulation.
+ * @param expr Compiled expression; each variable gets its own draw.
+ * @param dist Distribution for all variables.
+ * @param options Sample count, seed, threads, histogram and CI settings.
+ * @return Statistics, or std::nullopt on invalid parameters (no samples,
+ *         no bins, bad distribution parameters or confidence outside (0,1))
+ *         or when options.cancel was set.
+ */
+std::optional<Result> simulate(const Expression &expr,
+                               const DistributionSpec &dist,
+                               const Options &options);
+
+} // namespace montecarlo
@@ -0,0 +1,407 @@
+/**
+ * @file numbertheory.cpp
+ * @brief Implementation of the 64-bit number-theory helpers.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "numbertheory.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace numtheory {
+namespace {
+
+using u64 = std::uint64_t;
+
+/// Full 64x64 -> 128-bit product; returns the low half, stores the high.
+inline u64 mulFull(u64 a, u64 b, u64 &hi) {
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+  hi = static_cast<u64>(p >> 64);
+  return static_cast<u64>(p);
+#else
+  const u64 aL = a & 0xFFFFFFFFu, aH = a >> 32;
+  const u64 bL = b & 0xFFFFFFFFu, bH = b >> 32;
+  const u64 ll = aL * bL, lh = aL * bH, hl = aH * bL, hh = aH * bH;
+  const u64 mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+  hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  return (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+}
+
+/// a * b mod m for any m (used for even moduli only).
+inline u64 mulMod(u64 a, u64 b, u64 m) {
+#if defined(__SIZEOF_INT128__)
+  return static_cast<u64>(static_cast<unsigned __int128>(a) * b % m);
+#else
+  u64 r = 0;
+  a %= m;
+  while (b) {
+    if (b & 1)
+      r = (r >= m - a) ? r - (m - a) : r + a;
+    a = (a >= m - a) ? a - (m - a) : a + a;
+    b >>= 1;
+  }
+  return r;
+#endif
+}
+
+/**
+ * @brief Montgomery arithmetic modulo an odd 64-bit n (R = 2^64).
+ *
+ * REDC is written as hi(T) - hi(q * n) so it never overflows, even for n
+ * close to 2^64.
+ */
+class Montgomery {
+public:
+  explicit Montgomery(u64 n) : n_(n) {
+    inv_ = n; // Newton iteration: each step doubles the correct low bits
+    for (int i = 0; i < 5; ++i)
+      inv_ *= 2 - n * inv_;
+    const u64 r1 = (0 - n) % n; // 2^64 mod n
+    r2_ = mulMod(r1, r1, n);
+    one_ = r1;
+  }
+
+  u64 reduce(u64 lo, u64 hi) const {
+    const u64 q = lo * inv_;
+    u64 mHi;
+    mulFull(q, n_, mHi);
+    return hi >= mHi ? hi - mHi : hi - mHi + n_;
+  }
+  u64 mul(u64 a, u64 b) const {
+    u64 hi;
+    const u64 lo = mulFull(a, b, hi);
+    return reduce(lo, hi);
+  }
+  u64 to(u64 a) const { return mul(a % n_, r2_); }
+  u64 from(u64 a) const { return reduce(a, 0); }
+  u64 one() const { return one_; }
+  u64 add(u64 a, u64 b) const { return a >= n_ - b ? a - (n_ - b) : a + b; }
+  u64 sub(u64 a, u64 b) const { return a >= b ? a - b : a + (n_ - b); }
+
+  u64 pow(u64 base, u64 exp) const { // base and result in Montgomery form
+    u64 r = one_;
+    while (exp) {
+      if (exp & 1)
+        r = mul(r, base);
+      base = mul(base, base);
+      exp >>= 1;
+    }
+    return r;
+  }
+
+private:
+  u64 n_, inv_, r2_, one_;
+};
+
+/// Miller-Rabin round for witness a (n odd, n - 1 = d * 2^s).
+bool strongProbablePrime(const Montgomery &mg, u64 n, u64 a, u64 d, int s) {
+  a %= n;
+  if (a == 0)
+    return true;
+  const u64 one = mg.one();
+  const u64 minusOne = mg.sub(0, one);
+  u64 x = mg.pow(mg.to(a), d);
+  if (x == one || x == minusOne)
+    return true;
+  for (int i = 1; i < s; ++i) {
+    x = mg.mul(x, x);
+    if (x == minusOne)
+      return true;
+  }
+  return false;
+}
+
+/// Pollard-rho (Brent) on an odd composite n; returns a non-trivial factor.
+u64 pollardBrent(u64 n) {
+  const Montgomery mg(n);
+  constexpr u64 kBatch = 128;
+  for (u64 c0 = 1;; ++c0) {
+    const u64 c = mg.to(c0);
+    auto f = [&](u64 x) { return mg.add(mg.mul(x, x), c); };
+    u64 y = mg.to(2), x = y, ys = y, q = mg.one(), g = 1;
+    for (u64 r = 1; g == 1; r <<= 1) {
+      x = y;
+      for (u64 i = 0; i < r; ++i)
+        y = f(y);
+      for (u64 k = 0; k < r && g == 1; k += kBatch) {
+        ys = y;
+        const u64 lim = std::min(kBatch, r - k);
+        for (u64 i = 0; i < lim; ++i) {
+          y = f(y);
+          q = mg.mul(q, mg.sub(x, y));
+        }
+        g = gcd<u64>(mg.from(q), n);
+      }
+    }
+    if (g == n) { // batch overshot: redo the last stretch one step at a time
+      do {
+        ys = f(ys);
+        g = gcd<u64>(mg.from(mg.sub(x, ys)), n);
+      } while (g == 1);
+    }
+    if (g != n)
+      return g;
+  }
+}
+
+/// Recursive splitting of an odd cofactor with no small prime factors.
+void splitLarge(u64 n, std::vector<u64> &out) {
+  if (n == 1)
+    return;
+  if (isPrime(n)) {
+    out.push_back(n);
+    return;
+  }
+  const u64 r = static_cast<u64>(std::sqrt(static_cast<double>(n)));
+  for (u64 s = r > 0 ? r - 1 : 0; s <= r + 1; ++s) // perfect squares defeat rho
+    if (s * s == n) {
+      splitLarge(s, out);
+      splitLarge(s, out);
+      return;
+    }
+  const u64 d = pollardBrent(n);
+  splitLarge(d, out);
+  splitLarge(n / d, out);
+}
+
+/// Trial-division bound for factorize().
+constexpr std::uint32_t kTrialLimit = 1u << 16;
+/// Bytes per sieve segment (fits in L1).
+constexpr std::uint32_t kSegment = 1u << 15;
+
+std::mutex sieveMutex;
+std::shared_ptr<const std::vector<std::uint32_t>> sievePrimes =
+    std::make_shared<const std::vector<std::uint32_t>>();
+std::uint32_t sieveLimit = 0; ///< All primes < sieveLimit are cached.
+
+} // namespace
+
+/**
+ * @brief Least common multiple with overflow check.
+ * @param a First value.
+ * @param b Second value.
+ * @return lcm or std::nullopt on overflow.
+ */
+std::optional<std::uint64_t> lcm(std::uint64_t a, std::uint64_t b) {
+  if (a == 0 || b == 0)
+    return 0;
+  const u64 q = a / gcd(a, b);
+  u64 hi;
+  const u64 lo = mulFull(q, b, hi);
+  if (hi != 0)
+    return std::nullopt;
+  return lo;
+}
+
+/**
+ * @brief Signed GCD on the exact integer type.
+ * @return Non-negative gcd, or std::nullopt when it is 2^(bits - 1).
+ */
+std::optional<checked::Int> gcd(checked::Int a, checked::Int b) {
+  const checked::UInt g =
+      gcd(checked::magnitude(a), checked::magnitude(b));
+  if (g > static_cast<checked::UInt>(checked::kMax))
+    return std::nullopt; // only gcd(kMin, 0) or gcd(kMin, kMin)
+  return static_cast<checked::Int>(g);
+}
+
+/**
+ * @brief Signed LCM on the exact integer type.
+ * @return Non-negative lcm, or std::nullopt on overflow.
+ */
+std::optional<checked::Int> lcm(checked::Int a, checked::Int b) {
+  const auto g = gcd(a, b);
+  if (!g)
+    return std::nullopt;
+  if (*g == 0)
+    return checked::Int{0};
+  checked::Int r = 0;
+  if (!checked::mul(a / *g, b, r) || (r < 0 && !checked::mul(r, -1, r)))
+    return std::nullopt;
+  return r;
+}
+
+/**
+ * @brief Modular exponentiation.
+ * @param base Base.
+ * @param exp Exponent.
+ * @param m Modulus.
+ * @return base^exp mod m or std::nullopt for m == 0.
+ */
+std::optional<std::uint64_t> modPow(std::uint64_t base, std::uint64_t exp,
+                                    std::uint64_t m) {
+  if (m == 0)
+    return std::nullopt;
+  if (m == 1)
+    return 0;
+  if (m & 1) {
+    const Montgomery mg(m);
+    return mg.from(mg.pow(mg.to(base), exp));
+  }
+  u64 r = 1;
+  base %= m;
+  while (exp) {
+    if (exp & 1)
+      r = mulMod(r, base, m);
+    base = mulMod(base, base, m);
+    exp >>= 1;
+  }
+  return r;
+}
+
+/**
+ * @brief Modular inverse via the extended Euclidean algorithm.
+ * @param a Value to invert.
+ * @param m Modulus.
+ * @return Inverse in [0, m) or std::nullopt.
+ */
+std::optional<std::uint64_t> modInverse(std::uint64_t a, std::uint64_t m) {
+  if (m == 0)
+    return std::nullopt;
+  if (m == 1)
+    return 0;
+  // Track Bezout coefficients of a modulo m as unsigned values in [0, m).
+  u64 oldR = a % m, r = m;
+  u64 oldS = 1, s = 0;
+  while (r != 0) {
+    const u64 q = oldR / r;
+    const u64 nextR = oldR - q * r;
+    oldR = r;
+    r = nextR;
+    const u64 qs = mulMod(q % m, s, m); // nextS = oldS - q * s (mod m)
+    const u64 nextS = oldS >= qs ? oldS - qs : oldS + (m - qs);
+    oldS = s;
+    s = nextS;
+  }
+  // After the loop the roles are swapped: oldR holds the last non-zero rem.
+  if (oldR != 1)
+    return std::nullopt;
+  return oldS;
+}
+
+/**
+ * @brief Deterministic primality test for 64-bit integers.
+ * @param n Candidate.
+ * @return true if n is prime.
+ */
+bool isPrime(std::uint64_t n) {
+  if (n < 2)
+    return false;
+  static const u64 kSmall[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+  for (u64 p : kSmall) {
+    if (n == p)
+      return true;
+    if (n % p == 0)
+      return false;
+  }
+  if (n < 41 * 41)
+    return true;
+  u64 d = n - 1;
+  int s = 0;
+  while ((d & 1) == 0) {
+    d >>= 1;
+    ++s;
+  }
+  const Montgomery mg(n);
+  // Jim Sinclair's bases: deterministic for every n < 2^64.
+  static const u64 kBases[] = {2,      325,     9375,      28178,
+                               450775, 9780504, 1795265022};
+  for (u64 a : kBases)
+    if (!strongProbablePrime(mg, n, a, d, s))
+      return false;
+  return true;
+}
+
+/**
+ * @brief Factor n into primes.
+ * @param n Value to factor.
+ * @return Sorted (prime, exponent) pairs.
+ */
+std::vector<std::pair<std::uint64_t, unsigned>> factorize(std::uint64_t n) {
+  std::vector<u64> found;
+  if (n < 2)
+    return {};
+  const auto primes = smallPrimes(kTrialLimit);
+  for (std::uint32_t p : *primes) {
+    if (p >= kTrialLimit || static_cast<u64>(p) * p > n)
+      break;
+    while (n % p == 0) {
+      found.push_back(p);
+      n /= p;
+    }
+  }
+  if (n > 1)
+    splitLarge(n, found);
+
+  std::sort(found.begin(), found.end());
+  std::vector<std::pair<std::uint64_t, unsigned>> out;
+  for (u64 p : found) {
+    if (!out.empty() && out.back().first == p)
+      ++out.back().second;
+    else
+      out.emplace_back(p, 1u);
+  }
+  return out;
+}
+
+/**
+ * @brief Cached segmented sieve.
+ * @param limit Exclusive bound.
+ * @return Snapshot of the cached primes (covers at least [2, limit)).
+ */
+std::shared_ptr<const std::vector<std::uint32_t>>
+smallPrimes(std::uint32_t limit) {
+  std::lock_guard<std::mutex> lock(sieveMutex);
+  if (limit <= sieveLimit)
+    return sievePrimes;
+
+  auto primes = std::make_shared<std::vector<std::uint32_t>>(*sievePrimes);
+  // Base primes up to sqrt(limit) via a plain sieve if not yet cached.
+  const std::uint32_t root =
+      static_cast<std::uint32_t>(std::sqrt(static_cast<double>(limit))) + 1;
+  std::uint32_t from = sieveLimit;
+  if (from < root + 1) {
+    std::vector<char> composite(root + 1, 0);
+    primes->clear();
+    for (std::uint32_t i = 2; i <= root; ++i) {
+      if (composite[i])
+        continue;
+      primes->push_back(i);
+      for (std::uint64_t j = static_cast<std::uint64_t>(i) * i; j <= root;
+           j += i)
+        composite[j] = 1;
+    }
+    from = root + 1;
+  }
+  const std::size_t baseCount = static_cast<std::size_t>(
+      std::upper_bound(primes->begin(), primes->end(), root) -
+      primes->begin());
+
+  // Sieve [from, limit) one L1-sized segment at a time.
+  std::vector<char> segment(kSegment);
+  for (std::uint64_t lo = from; lo < limit; lo += kSegment) {
+    const std::uint64_t hi = std::min<std::uint64_t>(lo + kSegment, limit);
+    std::fill(segment.begin(), segment.end(), 0);
+    for (std::size_t k = 0; k < baseCount; ++k) {
+      const std::uint64_t p = (*primes)[k];
+      if (p * p >= hi)
+        break;
+      std::uint64_t start = std::max(p * p, (lo + p - 1) / p * p);
+      for (std::uint64_t j = start; j < hi; j += p)
+        segment[j - lo] = 1;
+    }
+    for (std::uint64_t v = lo; v < hi; ++v)
+      if (!segment[v - lo] && v >= 2)
+        primes->push_back(static_cast<std::uint32_t>(v));
+  }
+  sievePrimes = primes;
+  sieveLimit = limit;
+  return sievePrimes;
+}
+
+} // namespace numtheory
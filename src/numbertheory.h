@@ -0,0 +1,111 @@
+#pragma once
+#include "checked_int.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @file numbertheory.h
+ * @brief 64-bit number theory: GCD/LCM, modular arithmetic, primality and
+ *        factorization.
+ *
+ * Modular products use Montgomery multiplication for odd moduli. Primality is
+ * a deterministic Miller-Rabin test (seven fixed bases cover all 64-bit
+ * integers) and factorization combines trial division by cached small primes
+ * with Pollard-rho in Brent's variant. Small primes come from a segmented
+ * sieve that is cached process-wide and only ever extended, never rebuilt.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace numtheory {
+
+/**
+ * @brief Binary (Stein) GCD for any unsigned integer type.
+ * @param a First value.
+ * @param b Second value.
+ * @return gcd(a, b); gcd(0, 0) = 0.
+ */
+template <typename U> U gcd(U a, U b) {
+  if (a == 0)
+    return b;
+  if (b == 0)
+    return a;
+  int shift = 0;
+  while (((a | b) & 1) == 0) {
+    a >>= 1;
+    b >>= 1;
+    ++shift;
+  }
+  while ((a & 1) == 0)
+    a >>= 1;
+  do {
+    while ((b & 1) == 0)
+      b >>= 1;
+    if (a > b)
+      std::swap(a, b);
+    b -= a;
+  } while (b != 0);
+  return a << shift;
+}
+
+/**
+ * @brief Least common multiple.
+ * @return lcm(a, b), or std::nullopt if it does not fit in 64 bits.
+ */
+std::optional<std::uint64_t> lcm(std::uint64_t a, std::uint64_t b);
+
+/**
+ * @brief Greatest common divisor of signed exact integers.
+ * @return gcd(|a|, |b|), or std::nullopt when it does not fit checked::Int
+ *         (only gcd(kMin, 0) and gcd(kMin, kMin)).
+ */
+std::optional<checked::Int> gcd(checked::Int a, checked::Int b);
+
+/**
+ * @brief Least common multiple of signed exact integers.
+ * @return lcm(|a|, |b|) (0 if either is 0), or std::nullopt on overflow.
+ */
+std::optional<checked::Int> lcm(checked::Int a, checked::Int b);
+
+/**
+ * @brief base^exp mod m (Montgomery ladder for odd m).
+ * @return The power, or std::nullopt when m == 0.
+ */
+std::optional<std::uint64_t> modPow(std::uint64_t base, std::uint64_t exp,
+                                    std::uint64_t m);
+
+/**
+ * @brief Multiplicative inverse of a modulo m.
+ * @return x with a*x = 1 (mod m), or std::nullopt when gcd(a, m) != 1 or
+ *         m == 0.
+ */
+std::optional<std::uint64_t> modInverse(std::uint64_t a, std::uint64_t m);
+
+/** @brief Deterministic Miller-Rabin primality test for 64-bit n. */
+bool isPrime(std::uint64_t n);
+
+/**
+ * @brief Prime factorization.
+ * @param n Value to factor (0 and 1 yield an empty list).
+ * @return (prime, exponent) pairs in increasing prime order.
+ */
+std::vector<std::pair<std::uint64_t, unsigned>> factorize(std::uint64_t n);
+
+/**
+ * @brief Primes below @p limit from the shared segmented sieve.
+ *
+ * The cache grows by whole segments when a larger limit is requested; the
+ * returned snapshot is immutable and stays valid even if another thread
+ * extends the cache afterwards.
+ *
+ * @param limit Exclusive upper bound (at least all primes < limit).
+ * @return Sorted primes; may contain primes >= limit from a previous,
+ *         larger request.
+ */
+std::shared_ptr<const std::vector<std::uint32_t>>
+smallPrimes(std::uint32_t limit);
+
+} // namespace numtheory
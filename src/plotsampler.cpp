@@ -0,0 +1,229 @@
+/**
+ * @file plotsampler.cpp
+ * @brief Implementation of PlotSampler (adaptive sampling + min/max pyramid).
+ *
+ * Refinement works in rounds: every round scans the current samples for
+ * large second differences (relative to the overall y range) or finite/NaN
+ * transitions, collects the midpoints of the affected intervals, evaluates
+ * them all in one batch and merges them back in order.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "plotsampler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr std::size_t kFanout = 8; ///< Children per pyramid node.
+
+/// Fold one y value into a column.
+inline void fold(PlotSampler::Column &c, double y) {
+  if (!std::isfinite(y))
+    return;
+  if (!c.valid) {
+    c.yMin = c.yMax = y;
+    c.valid = true;
+    return;
+  }
+  c.yMin = std::min(c.yMin, y);
+  c.yMax = std::max(c.yMax, y);
+}
+
+/// Fold a column into another.
+inline void fold(PlotSampler::Column &c, const PlotSampler::Column &o) {
+  if (!o.valid)
+    return;
+  fold(c, o.yMin);
+  fold(c, o.yMax);
+}
+} // namespace
+
+/**
+ * @brief Sample the expression uniformly, then refine adaptively.
+ * @param expr Expression in one variable.
+ * @param x0 Domain start.
+ * @param x1 Domain end.
+ * @param options Sampling options.
+ * @return true on success.
+ */
+bool PlotSampler::sample(const Expression &expr, double x0, double x1,
+                         const Options &options) {
+  if (!(x1 > x0) || !std::isfinite(x0) || !std::isfinite(x1))
+    return false;
+
+  const std::size_t n = std::max<std::size_t>(options.baseSamples, 2);
+  xs_.resize(n);
+  ys_.resize(n);
+  const double step = (x1 - x0) / static_cast<double>(n - 1);
+  for (std::size_t i = 0; i < n; ++i)
+    xs_[i] = x0 + step * static_cast<double>(i);
+  xs_.back() = x1;
+  expr.evaluateBatch(xs_.data(), ys_.data(), n);
+
+  std::vector<double> midX, midY, mergedX, mergedY;
+  std::vector<char> split;
+  for (int round = 0; round < options.refineRounds; ++round) {
+    buildPyramid();
+    const Column yr = range();
+    const double scale = yr.valid && yr.yMax > yr.yMin ? yr.yMax - yr.yMin : 1.0;
+    const double limit = options.tolerance * scale;
+    const double minGap = (x1 - x0) * 1e-12;
+
+    // Mark intervals around samples that bend too sharply.
+    const std::size_t count = xs_.size();
+    split.assign(count - 1, 0);
+    for (std::size_t i = 1; i + 1 < count; ++i) {
+      const double a = ys_[i - 1], b = ys_[i], c = ys_[i + 1];
+      const bool fa = std::isfinite(a), fb = std::isfinite(b),
+                 fc = std::isfinite(c);
+      bool bend;
+      if (fa && fb && fc) {
+        // Second difference normalised to the local spacing.
+        const double h1 = xs_[i] - xs_[i - 1], h2 = xs_[i + 1] - xs_[i];
+        const double chord = a + (c - a) * h1 / (h1 + h2);
+        bend = std::fabs(b - chord) > limit;
+      } else {
+        bend = fa != fb || fb != fc;
+      }
+      if (bend) {
+        split[i - 1] = 1;
+        split[i] = 1;
+      }
+    }
+
+    midX.clear();
+    for (std::size_t i = 0; i + 1 < count; ++i)
+      if (split[i] && xs_[i + 1] - xs_[i] > minGap)
+        midX.push_back(0.5 * (xs_[i] + xs_[i + 1]));
+    if (midX.empty())
+      break;
+    if (count + midX.size() > options.maxSamples) {
+      if (count >= options.maxSamples)
+        break;
+      midX.resize(options.maxSamples - count);
+    }
+    midY.resize(midX.size());
+    expr.evaluateBatch(midX.data(), midY.data(), midX.size());
+
+    // Merge the sorted midpoints back into the samples.
+    mergedX.resize(count + midX.size());
+    mergedY.resize(mergedX.size());
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < count || j < midX.size()) {
+      if (j == midX.size() || (i < count && xs_[i] <= midX[j])) {
+        mergedX[k] = xs_[i];
+        mergedY[k++] = ys_[i++];
+      } else {
+        mergedX[k] = midX[j];
+        mergedY[k++] = midY[j++];
+      }
+    }
+    xs_.swap(mergedX);
+    ys_.swap(mergedY);
+  }
+  buildPyramid();
+  return true;
+}
+
+/**
+ * @brief Rebuild the min/max pyramid over ys_.
+ */
+void PlotSampler::buildPyramid() {
+  levels_.clear();
+  std::vector<Column> level((ys_.size() + kFanout - 1) / kFanout);
+  for (std::size_t i = 0; i < ys_.size(); ++i)
+    fold(level[i / kFanout], ys_[i]);
+  while (level.size() > 1) {
+    std::vector<Column> next((level.size() + kFanout - 1) / kFanout);
+    for (std::size_t i = 0; i < level.size(); ++i)
+      fold(next[i / kFanout], level[i]);
+    levels_.push_back(std::move(level));
+    level = std::move(next);
+  }
+  levels_.push_back(std::move(level));
+}
+
+/**
+ * @brief Min/max over samples [begin, end).
+ *
+ * Partial blocks at each end are scanned at the current level; the aligned
+ * middle moves up one level, so at most 2 * kFanout entries are touched per
+ * level.
+ */
+PlotSampler::Column PlotSampler::query(std::size_t begin,
+                                       std::size_t end) const {
+  Column acc;
+  std::size_t b = begin, e = end;
+  int lvl = -1; // -1 = raw samples
+  auto scan = [&](std::size_t from, std::size_t to) {
+    for (std::size_t i = from; i < to; ++i) {
+      if (lvl < 0)
+        fold(acc, ys_[i]);
+      else
+        fold(acc, levels_[static_cast<std::size_t>(lvl)][i]);
+    }
+  };
+  while (b < e) {
+    const std::size_t bUp = (b + kFanout - 1) / kFanout * kFanout;
+    const std::size_t eDown = e / kFanout * kFanout;
+    if (static_cast<std::size_t>(lvl + 1) >= levels_.size() || bUp >= eDown) {
+      scan(b, e);
+      break;
+    }
+    scan(b, bUp);
+    scan(eDown, e);
+    b = bUp / kFanout;
+    e = eDown / kFanout;
+    ++lvl;
+  }
+  return acc;
+}
+
+/**
+ * @brief Reduce [xa, xb] to one min/max pair per pixel column.
+ * @param xa View start.
+ * @param xb View end.
+ * @param pixels Column count.
+ * @return Columns (invalid where no sample falls).
+ */
+std::vector<PlotSampler::Column>
+PlotSampler::decimate(double xa, double xb, std::size_t pixels) const {
+  std::vector<Column> cols(pixels);
+  if (xs_.empty() || pixels == 0 || !(xb > xa))
+    return cols;
+  const double width = (xb - xa) / static_cast<double>(pixels);
+  auto lo = std::lower_bound(xs_.begin(), xs_.end(), xa);
+  for (std::size_t p = 0; p < pixels; ++p) {
+    const double right = xa + width * static_cast<double>(p + 1);
+    auto hi = std::lower_bound(lo, xs_.end(), right);
+    cols[p] = query(static_cast<std::size_t>(lo - xs_.begin()),
+                    static_cast<std::size_t>(hi - xs_.begin()));
+    lo = hi;
+  }
+  return cols;
+}
+
+/** @brief Number of samples. @return xs_.size(). */
+std::size_t PlotSampler::size() const { return xs_.size(); }
+
+/** @brief Domain start. @return First abscissa or 0. */
+double PlotSampler::domainMin() const { return xs_.empty() ? 0.0 : xs_.front(); }
+
+/** @brief Domain end. @return Last abscissa or 0. */
+double PlotSampler::domainMax() const { return xs_.empty() ? 0.0 : xs_.back(); }
+
+/** @brief Mean spacing. @return (max - min) / (n - 1) or 0. */
+double PlotSampler::spacing() const {
+  return xs_.size() < 2 ? 0.0
+                        : (xs_.back() - xs_.front()) /
+                              static_cast<double>(xs_.size() - 1);
+}
+
+/** @brief Overall finite y range. @return Top pyramid node. */
+PlotSampler::Column PlotSampler::range() const {
+  return levels_.empty() || levels_.back().empty() ? Column{}
+                                                   : levels_.back().front();
+}
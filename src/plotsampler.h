@@ -0,0 +1,78 @@
+#pragma once
+#include "expression.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file plotsampler.h
+ * @brief Function sampling and level-of-detail reduction for plotting.
+ *
+ * PlotSampler evaluates y = f(x) over an interval with Expression's batch
+ * path, then refines adaptively where the curve bends sharply. The samples
+ * are indexed by a min/max pyramid so that any view can be reduced to one
+ * min/max pair per pixel column in O(pixels * log n), independent of how
+ * many points were sampled. This keeps pan and zoom cheap even for tens of
+ * millions of points.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+class PlotSampler {
+public:
+  /** @brief Min/max of y over one pixel column. */
+  struct Column {
+    double yMin = 0.0;  ///< Lowest finite sample in the column.
+    double yMax = 0.0;  ///< Highest finite sample in the column.
+    bool valid = false; ///< Whether any finite sample fell in the column.
+  };
+
+  /** @brief Sampling knobs. */
+  struct Options {
+    std::size_t baseSamples = 1 << 16; ///< Uniform samples before refinement.
+    int refineRounds = 6;              ///< Maximum refinement passes.
+    double tolerance = 1e-3; ///< Bend threshold relative to the y range.
+    std::size_t maxSamples = 1u << 26; ///< Hard cap on the total.
+  };
+
+  /**
+   * @brief Sample @p expr over [x0, x1] and rebuild the pyramid.
+   * @param expr Single-variable expression.
+   * @param x0 Left end of the domain.
+   * @param x1 Right end of the domain (must be > x0).
+   * @param options Sampling options.
+   * @return false if the interval is empty or not finite.
+   */
+  bool sample(const Expression &expr, double x0, double x1,
+              const Options &options);
+
+  /**
+   * @brief Reduce the samples inside [xa, xb] to @p pixels columns.
+   * @param xa Left edge of the view.
+   * @param xb Right edge of the view.
+   * @param pixels Number of pixel columns.
+   * @return One Column per pixel.
+   */
+  std::vector<Column> decimate(double xa, double xb, std::size_t pixels) const;
+
+  /** @brief Number of stored samples. */
+  std::size_t size() const;
+  /** @brief Left end of the sampled domain. */
+  double domainMin() const;
+  /** @brief Right end of the sampled domain. */
+  double domainMax() const;
+  /** @brief Average sample spacing over the domain (0 if empty). */
+  double spacing() const;
+  /** @brief Finite y range of all samples (yMin > yMax if none). */
+  Column range() const;
+
+private:
+  /// Min/max of samples [begin, end) using the pyramid.
+  Column query(std::size_t begin, std::size_t end) const;
+  /// Rebuild levels_ from ys_.
+  void buildPyramid();
+
+  std::vector<double> xs_; ///< Sorted sample abscissas.
+  std::vector<double> ys_; ///< Samples (NaN where undefined).
+  /// levels_[k] holds min/max for blocks of kFanout^(k+1) samples.
+  std::vector<std::vector<Column>> levels_;
+};
@@ -0,0 +1,171 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+/**
+ * @file precision.h
+ * @brief Floating-point precision tiers for BasicEngine.
+ *
+ * The keypad engine works in long double by default, which on x86-64 means
+ * scalar x87 code. Workloads can pick a cheaper tier instead: float and
+ * double vectorize, long double keeps a 64-bit mantissa, and
+ * __float128 (GCC/Clang with libquadmath, enabled by the CMake option
+ * CALCULATOR_FLOAT128) gives 113 bits in software.
+ *
+ * A tier is chosen at build time through CALCULATOR_DEFAULT_PRECISION
+ * (kDefaultPrecision, the tier of Engine's real arithmetic) or at run time
+ * with precision::parse() and precision::withPrecision(), which calls a
+ * generic callable with a value of the matching type.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#if defined(CALCULATOR_ENABLE_FLOAT128) && defined(__SIZEOF_FLOAT128__)
+#define CALCULATOR_HAS_FLOAT128 1
+#include <quadmath.h>
+#endif
+
+/** @brief Selectable precision tiers, cheapest first. */
+enum class Precision { Float, Double, LongDouble, Float128 };
+
+#ifndef CALCULATOR_DEFAULT_PRECISION
+#define CALCULATOR_DEFAULT_PRECISION LongDouble
+#endif
+
+/// Build-time default tier (CMake cache variable CALCULATOR_PRECISION).
+constexpr Precision kDefaultPrecision = Precision::CALCULATOR_DEFAULT_PRECISION;
+
+namespace precision {
+
+/** @brief Whether @p p was compiled into this build. */
+constexpr bool isAvailable(Precision p) {
+#ifdef CALCULATOR_HAS_FLOAT128
+  (void)p;
+  return true;
+#else
+  return p != Precision::Float128;
+#endif
+}
+
+static_assert(isAvailable(kDefaultPrecision),
+              "CALCULATOR_DEFAULT_PRECISION=Float128 needs CALCULATOR_FLOAT128");
+
+/** @brief Short name ("float", "double", "long double", "float128"). */
+inline const char *name(Precision p) {
+  switch (p) {
+  case Precision::Float:
+    return "float";
+  case Precision::Double:
+    return "double";
+  case Precision::LongDouble:
+    return "long double";
+  case Precision::Float128:
+  default:
+    return "float128";
+  }
+}
+
+/**
+ * @brief Parse a tier name ("float", "double", "long", "long double",
+ *        "quad" or "float128").
+ * @return The tier, or std::nullopt for unknown or unavailable names.
+ */
+inline std::optional<Precision> parse(const std::string &text) {
+  std::optional<Precision> p;
+  if (text == "float" || text == "f32")
+    p = Precision::Float;
+  else if (text == "double" || text == "f64")
+    p = Precision::Double;
+  else if (text == "long" || text == "long double" || text == "ld")
+    p = Precision::LongDouble;
+  else if (text == "quad" || text == "float128" || text == "f128")
+    p = Precision::Float128;
+  if (p && !isAvailable(*p))
+    return std::nullopt;
+  return p;
+}
+
+/**
+ * @brief Call @p f with a value-initialized object of the type for @p p.
+ *
+ * An unavailable Float128 falls back to long double.
+ *
+ * @param p Tier selected at run time.
+ * @param f Generic callable, e.g. [](auto zero) { using T = decltype(zero); }.
+ * @return Whatever @p f returns (all instantiations must agree).
+ */
+template <typename F> decltype(auto) withPrecision(Precision p, F &&f) {
+  switch (p) {
+  case Precision::Float:
+    return f(0.0f);
+  case Precision::Double:
+    return f(0.0);
+#ifdef CALCULATOR_HAS_FLOAT128
+  case Precision::Float128:
+    return f(static_cast<__float128>(0));
+#endif
+  case Precision::LongDouble:
+  default:
+    return f(0.0L);
+  }
+}
+
+/** @brief Floating-point type of tier @p P (see Real). */
+template <Precision P> struct TierType {
+  using type = long double;
+};
+template <> struct TierType<Precision::Float> {
+  using type = float;
+};
+template <> struct TierType<Precision::Double> {
+  using type = double;
+};
+#ifdef CALCULATOR_HAS_FLOAT128
+template <> struct TierType<Precision::Float128> {
+  using type = __float128;
+};
+#endif
+/// Type of tier @p P, e.g. Real<kDefaultPrecision> for the build's tier.
+template <Precision P> using Real = typename TierType<P>::type;
+
+// --- Math helpers that also cover __float128 (libquadmath) ---
+template <typename T> T trunc(T v) { return std::trunc(v); }
+template <typename T> T fabs(T v) { return std::fabs(v); }
+template <typename T> T pow(T a, T b) { return std::pow(a, b); }
+template <typename T> bool isfinite(T v) { return std::isfinite(v); }
+template <typename T> T nan() { return std::numeric_limits<T>::quiet_NaN(); }
+#ifdef CALCULATOR_HAS_FLOAT128
+template <> inline __float128 trunc(__float128 v) { return truncq(v); }
+template <> inline __float128 fabs(__float128 v) { return fabsq(v); }
+template <> inline __float128 pow(__float128 a, __float128 b) {
+  return powq(a, b);
+}
+template <> inline bool isfinite(__float128 v) { return finiteq(v); }
+template <> inline __float128 nan() { return nanq(""); }
+#endif
+
+/** @brief Significant decimal digits of @p T (for printing). */
+template <typename T> constexpr int digits10() {
+#ifdef CALCULATOR_HAS_FLOAT128
+  if constexpr (std::is_same_v<T, __float128>)
+    return FLT128_DIG;
+  else
+#endif
+    return std::numeric_limits<T>::digits10;
+}
+
+/** @brief Mantissa bits of @p T. */
+template <typename T> constexpr int mantissaBits() {
+#ifdef CALCULATOR_HAS_FLOAT128
+  if constexpr (std::is_same_v<T, __float128>)
+    return FLT128_MANT_DIG;
+  else
+#endif
+    return std::numeric_limits<T>::digits;
+}
+
+} // namespace precision
@@ -0,0 +1,318 @@
+/**
+ * @file precision_bench.cpp
+ * @brief Throughput/accuracy benchmark of the BasicEngine precision tiers
+ *        (calculator_bench).
+ *
+ * For each tier, times BasicEngine<T>::applyBatch for +, *, / and ^ over
+ * N-element arrays and a scalar chain through BasicEngine<T>::evaluate, then
+ * reports the relative error of that chain (the harmonic sum 1 + 1/2 + ... +
+ * 1/M) against a compensated sum in the widest tier. A last table times
+ * decimal::format/formatBatch and decimal::parse over the same N values and
+ * counts values that do not read back exactly, and another times the
+ * complex multiply/divide of Engine::applyComplexBatch in both layouts
+ * against a plain std::complex loop, with their largest relative deviation
+ * from it.
+ *
+ * Usage:
+ *   calculator_bench [--precision NAME] [--n N] [--reps R] [--terms M]
+ *
+ * NAME is float, double, long, or quad (when built with CALCULATOR_FLOAT128);
+ * without it every available tier is measured.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#include "basicengine.h"
+#include "complexbatch.h"
+#include "decimal.h"
+#include "engine.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Widest type built in; used for the reference sum.
+#ifdef CALCULATOR_HAS_FLOAT128
+using Widest = __float128;
+#else
+using Widest = long double;
+#endif
+
+struct Config {
+  std::size_t n = std::size_t(1) << 20; ///< Batch length.
+  int reps = 20;                        ///< Timed repetitions per operator.
+  long terms = 1000000;                 ///< Harmonic chain length.
+};
+
+void usage() {
+  std::fprintf(stderr, "usage: calculator_bench [--precision NAME] [--n N]\n"
+                       "                        [--reps R] [--terms M]\n"
+                       "NAME: float | double | long | quad\n");
+}
+
+double seconds(std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - since)
+      .count();
+}
+
+/// Kahan-compensated harmonic sum in the widest tier.
+Widest referenceHarmonic(long terms) {
+  Widest sum = 0, carry = 0;
+  for (long k = terms; k >= 1; --k) {
+    const Widest y = Widest(1) / Widest(k) - carry;
+    const Widest t = sum + y;
+    carry = (t - sum) - y;
+    sum = t;
+  }
+  return sum;
+}
+
+/**
+ * @brief Measure one tier and print its row.
+ * @param tier Tier being measured.
+ * @param config Sizes.
+ * @param reference Reference harmonic sum.
+ */
+template <typename T>
+void run(Precision tier, const Config &config, Widest reference) {
+  using Tier = BasicEngine<T>;
+  std::mt19937_64 gen(42);
+  std::uniform_real_distribution<double> dist(0.5, 2.0);
+  std::vector<T> a(config.n), b(config.n), out(config.n);
+  for (std::size_t i = 0; i < config.n; ++i) {
+    a[i] = static_cast<T>(dist(gen));
+    b[i] = static_cast<T>(dist(gen));
+  }
+
+  std::printf("%-12s %4d", precision::name(tier), precision::mantissaBits<T>());
+  const typename Tier::Op ops[] = {Tier::Op::Add, Tier::Op::Mul,
+                                   Tier::Op::Div, Tier::Op::Pow};
+  double checksum = 0.0;
+  for (const auto op : ops) {
+    // Pow is two orders of magnitude slower; keep its wall time comparable.
+    const int reps =
+        op == Tier::Op::Pow ? std::max(1, config.reps / 10) : config.reps;
+    Tier::applyBatch(op, a.data(), b.data(), out.data(), config.n); // warm
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r)
+      Tier::applyBatch(op, a.data(), b.data(), out.data(), config.n);
+    const double s = seconds(start);
+    checksum += static_cast<double>(out[config.n / 2]);
+    std::printf(" %10.1f", double(config.n) * reps / s / 1e6);
+  }
+
+  // Scalar chain through the stateful engine, like repeated keypad presses.
+  Tier engine;
+  const auto start = std::chrono::steady_clock::now();
+  T sum = T(0);
+  for (long k = config.terms; k >= 1; --k) {
+    engine.clear();
+    engine.setOp(Tier::Op::Div);
+    engine.setValue1(T(1));
+    engine.setValue2(static_cast<T>(k));
+    const T term = *engine.evaluate();
+    engine.clear();
+    engine.setOp(Tier::Op::Add);
+    engine.setValue1(sum);
+    engine.setValue2(term);
+    sum = *engine.evaluate();
+  }
+  const double s = seconds(start);
+  const Widest err = (static_cast<Widest>(sum) - reference) / reference;
+  std::printf(" %10.1f %12.3e   (checksum %.6g)\n", 2.0 * config.terms / s / 1e6,
+              static_cast<double>(precision::fabs(err)), checksum);
+}
+
+/// Shortest round-trip text: format and parse throughput of double and
+/// long double, and how many values fail to read back bit for bit.
+void runText(const Config &config) {
+  std::mt19937_64 rng(7);
+  std::vector<double> values(config.n);
+  for (double &v : values) { // random bit patterns: every exponent
+    do {
+      const std::uint64_t bits = rng();
+      std::memcpy(&v, &bits, sizeof v);
+    } while (!std::isfinite(v));
+  }
+  std::vector<char> text(config.n * (decimal::kMaxChars + 1));
+  std::size_t size = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < config.reps; ++r)
+    size = decimal::formatBatch(values.data(), config.n, '\n', text.data());
+  const double formatDouble = double(config.n) * config.reps / seconds(start);
+
+  std::size_t doubleMisses = 0, longMisses = 0;
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < config.reps; ++r) {
+    const char *p = text.data(), *end = p + size;
+    for (std::size_t i = 0; p < end; ++i) {
+      double v = 0.0;
+      p = decimal::parse(p, end, v).ptr + 1;
+      doubleMisses += r == 0 && std::memcmp(&v, &values[i], sizeof v) != 0;
+    }
+  }
+  const double parseDouble = double(config.n) * config.reps / seconds(start);
+
+  std::vector<long double> wide(config.n); // cents, as typed into the UI
+  for (long double &v : wide)
+    v = static_cast<long double>(rng() % 100000000) / 100.0L;
+  start = std::chrono::steady_clock::now();
+  char *q = text.data();
+  for (const long double v : wide) {
+    q = decimal::format(q, v);
+    *q++ = '\n';
+  }
+  const double formatLong = double(config.n) / seconds(start);
+  start = std::chrono::steady_clock::now();
+  const char *p = text.data();
+  for (std::size_t i = 0; p < q; ++i) {
+    long double v = 0.0L;
+    p = decimal::parse(p, q, v).ptr + 1;
+    longMisses += v != wide[i];
+  }
+  const double parseLong = double(config.n) / seconds(start);
+
+  std::printf("\n%-12s %10s %10s   %s\n", "text", "format M/s", "parse M/s",
+              "not round-tripped");
+  std::printf("%-12s %10.1f %10.1f   %zu\n", "double", formatDouble / 1e6,
+              parseDouble / 1e6, doubleMisses);
+  std::printf("%-12s %10.1f %10.1f   %zu\n", "long", formatLong / 1e6,
+              parseLong / 1e6, longMisses);
+}
+
+/// Engine::applyComplexBatch (the complexbatch kernels) multiply/divide in
+/// both layouts, the layout conversions, and std::complex loops for
+/// comparison.
+void runComplex(const Config &config) {
+  using complexbatch::Complex;
+  using Op = Engine::Op;
+  std::mt19937_64 gen(11);
+  std::uniform_real_distribution<double> dist(-2.0, 2.0);
+  const std::size_t n = config.n;
+  std::vector<Complex> a(n), b(n), out(n), expected(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = Complex(dist(gen), dist(gen));
+    b[i] = Complex(dist(gen), dist(gen));
+  }
+  std::vector<double> aRe(n), aIm(n), bRe(n), bIm(n), outRe(n), outIm(n);
+  complexbatch::deinterleave(a.data(), aRe.data(), aIm.data(), n);
+  complexbatch::deinterleave(b.data(), bRe.data(), bIm.data(), n);
+
+  auto rate = [&](auto &&body) {
+    body(); // warm
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < config.reps; ++r)
+      body();
+    return double(n) * config.reps / seconds(start) / 1e6;
+  };
+  // Largest |out - expected| / |expected| of the last kernel run.
+  auto deviation = [&](bool split) {
+    double worst = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      const Complex got = split ? Complex(outRe[i], outIm[i]) : out[i];
+      worst = std::max(worst, std::abs(got - expected[i]) /
+                                  std::abs(expected[i]));
+    }
+    return worst;
+  };
+
+  std::printf("\n%-12s %10s %10s %12s %12s\n", "complex", "mul M/s",
+              "div M/s", "mul err", "div err");
+  const double mulLoop = rate([&] {
+    for (std::size_t i = 0; i < n; ++i)
+      expected[i] = a[i] * b[i];
+  });
+  double mul[2], div[2], mulErr[2], divErr[2];
+  mul[0] = rate([&] {
+    Engine::applyComplexBatch(Op::Mul, a.data(), b.data(), out.data(), n);
+  });
+  mulErr[0] = deviation(false);
+  mul[1] = rate([&] {
+    Engine::applyComplexBatch(Op::Mul, aRe.data(), aIm.data(), bRe.data(),
+                              bIm.data(), outRe.data(), outIm.data(), n);
+  });
+  mulErr[1] = deviation(true);
+  const double divLoop = rate([&] {
+    for (std::size_t i = 0; i < n; ++i)
+      expected[i] = a[i] / b[i];
+  });
+  div[0] = rate([&] {
+    Engine::applyComplexBatch(Op::Div, a.data(), b.data(), out.data(), n);
+  });
+  divErr[0] = deviation(false);
+  div[1] = rate([&] {
+    Engine::applyComplexBatch(Op::Div, aRe.data(), aIm.data(), bRe.data(),
+                              bIm.data(), outRe.data(), outIm.data(), n);
+  });
+  divErr[1] = deviation(true);
+  std::printf("%-12s %10.1f %10.1f\n", "std::complex", mulLoop, divLoop);
+  std::printf("%-12s %10.1f %10.1f %12.3e %12.3e\n", "interleaved", mul[0],
+              div[0], mulErr[0], divErr[0]);
+  std::printf("%-12s %10.1f %10.1f %12.3e %12.3e\n", "split", mul[1], div[1],
+              mulErr[1], divErr[1]);
+
+  const double toSplit = rate([&] {
+    complexbatch::deinterleave(a.data(), outRe.data(), outIm.data(), n);
+  });
+  const double toInterleaved = rate([&] {
+    complexbatch::interleave(aRe.data(), aIm.data(), out.data(), n);
+  });
+  std::printf("%-12s %10.1f M/s to split, %.1f M/s to interleaved\n",
+              "layout", toSplit, toInterleaved);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Config config;
+  std::optional<Precision> only;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--precision" && hasValue) {
+      only = precision::parse(argv[++i]);
+      if (!only) {
+        std::fprintf(stderr, "calculator_bench: unknown or unavailable "
+                             "precision '%s'\n", argv[i]);
+        return 1;
+      }
+    } else if (arg == "--n" && hasValue) {
+      config.n = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+    } else if (arg == "--reps" && hasValue) {
+      config.reps = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--terms" && hasValue) {
+      config.terms = std::max(1L, std::atol(argv[++i]));
+    } else {
+      usage();
+      return 1;
+    }
+  }
+
+  const Widest reference = referenceHarmonic(config.terms);
+  std::printf("n = %zu, reps = %d, harmonic terms = %ld, engine tier: %s\n",
+              config.n, config.reps, config.terms,
+              precision::name(kDefaultPrecision));
+  std::printf("%-12s %4s %10s %10s %10s %10s %10s %12s\n", "tier", "bits",
+              "add M/s", "mul M/s", "div M/s", "pow M/s", "chain M/s",
+              "chain err");
+  const Precision tiers[] = {Precision::Float, Precision::Double,
+                             Precision::LongDouble, Precision::Float128};
+  for (const Precision tier : tiers) {
+    if ((only && *only != tier) || !precision::isAvailable(tier))
+      continue;
+    precision::withPrecision(tier, [&](auto zero) {
+      run<decltype(zero)>(tier, config, reference);
+    });
+  }
+  runText(config);
+  runComplex(config);
+  return 0;
+}
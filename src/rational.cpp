@@ -0,0 +1,358 @@
+/**
+ * @file rational.cpp
+ * @brief Implementation of Rational (int64 fast path, BigInt promotion).
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "rational.h"
+#include "numbertheory.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+using checked::Int;
+using checked::UInt;
+
+constexpr std::int64_t kMin64 = std::numeric_limits<std::int64_t>::min();
+constexpr std::int64_t kMax64 = std::numeric_limits<std::int64_t>::max();
+
+bool fits64(Int v) { return v >= kMin64 && v <= kMax64; }
+
+/// BigInt from a magnitude that may exceed checked::kMax (only |kMin|).
+BigInt fromMagnitude(UInt m) {
+  if (m <= static_cast<UInt>(checked::kMax))
+    return BigInt::fromInteger(static_cast<Int>(m));
+  return BigInt::fromInteger(static_cast<Int>(m / 2)) * BigInt(2) +
+         BigInt(static_cast<long long>(m % 2));
+}
+
+/// 10^e as BigInt.
+BigInt powerOfTen(std::uint64_t e) { return BigInt(10).pow(e); }
+
+/// Largest decimal exponent accepted by fromString.
+constexpr long long kMaxExponent = 100000;
+
+} // namespace
+
+Rational Rational::small(std::int64_t num, std::int64_t den) {
+  Rational r;
+  r.num_ = num;
+  r.den_ = den;
+  return r;
+}
+
+/**
+ * @brief Reduce with the binary GCD and choose int64 or BigInt storage.
+ * @param num Numerator.
+ * @param den Denominator (non-zero, any sign).
+ * @return Canonical value.
+ */
+Rational Rational::reduce(Int num, Int den) {
+  UInt mn = checked::magnitude(num);
+  UInt md = checked::magnitude(den);
+  const UInt g = numtheory::gcd(mn, md);
+  mn /= g;
+  md /= g;
+  const bool neg = (num < 0) != (den < 0) && mn != 0;
+  const UInt limit = static_cast<UInt>(kMax64) + (neg ? 1 : 0); // -2^63 fits
+  if (mn <= limit && md <= static_cast<UInt>(kMax64)) {
+    const std::int64_t n =
+        mn > static_cast<UInt>(kMax64) ? kMin64 : static_cast<std::int64_t>(mn);
+    return small(neg && n != kMin64 ? -n : n, static_cast<std::int64_t>(md));
+  }
+  Rational r;
+  r.big_ = true;
+  r.bnum_ = neg ? -fromMagnitude(mn) : fromMagnitude(mn);
+  r.bden_ = fromMagnitude(md);
+  return r;
+}
+
+/**
+ * @brief Reduce a BigInt fraction and demote it when both parts fit.
+ * @param num Numerator.
+ * @param den Denominator (non-zero, any sign).
+ * @return Canonical value.
+ */
+Rational Rational::reduceBig(BigInt num, BigInt den) {
+  if (den.isNegative()) {
+    num = -num;
+    den = -den;
+  }
+  const BigInt g = BigInt::gcd(num, den);
+  if (g != BigInt(1)) {
+    num = BigInt::divMod(num, g)->first;
+    den = BigInt::divMod(den, g)->first;
+  }
+  const auto n = num.toInteger();
+  const auto d = den.toInteger();
+  if (n && d && fits64(*n) && fits64(*d))
+    return small(static_cast<std::int64_t>(*n), static_cast<std::int64_t>(*d));
+  Rational r;
+  r.big_ = true;
+  r.bnum_ = std::move(num);
+  r.bden_ = std::move(den);
+  return r;
+}
+
+/**
+ * @brief Integer as a rational.
+ * @param v Value.
+ * @return v / 1.
+ */
+Rational Rational::fromInteger(checked::Int v) { return reduce(v, 1); }
+
+/**
+ * @brief Build a reduced fraction.
+ * @param num Numerator.
+ * @param den Denominator.
+ * @return num / den, or std::nullopt when den == 0.
+ */
+std::optional<Rational> Rational::make(const BigInt &num, const BigInt &den) {
+  if (den.isZero())
+    return std::nullopt;
+  return reduceBig(num, den);
+}
+
+/**
+ * @brief Parse integer, fraction or decimal text exactly.
+ * @param text Text such as "7", "-22/7", "0.125" or "1.5e-3".
+ * @return Value or std::nullopt (also for more than one '/').
+ */
+std::optional<Rational> Rational::fromString(const std::string &text) {
+  const auto slash = text.find('/');
+  if (slash == std::string::npos)
+    return fromDecimal(text);
+  if (text.find('/', slash + 1) != std::string::npos)
+    return std::nullopt;
+  const auto n = fromDecimal(text.substr(0, slash));
+  const auto d = fromDecimal(text.substr(slash + 1));
+  if (!n || !d)
+    return std::nullopt;
+  return divide(*n, *d);
+}
+
+/**
+ * @brief Parse integer or decimal text exactly.
+ * @param text Text such as "7", "-0.125" or "1.5e-3", without '/'.
+ * @return Value or std::nullopt.
+ */
+std::optional<Rational> Rational::fromDecimal(const std::string &text) {
+  std::size_t i = 0;
+  while (i < text.size() && text[i] == ' ')
+    ++i;
+  std::string digits;
+  if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+    digits += text[i++];
+  long long fraction = 0;
+  bool seenDot = false, seenDigit = false;
+  for (; i < text.size(); ++i) {
+    const char c = text[i];
+    if (c >= '0' && c <= '9') {
+      digits += c;
+      seenDigit = true;
+      fraction += seenDot;
+    } else if (c == '.' && !seenDot) {
+      seenDot = true;
+    } else {
+      break;
+    }
+  }
+  if (!seenDigit)
+    return std::nullopt;
+  long long exponent = 0;
+  if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+    ++i;
+    bool negExp = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+      negExp = text[i++] == '-';
+    if (i == text.size())
+      return std::nullopt;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+      exponent = exponent * 10 + (text[i] - '0');
+      if (exponent > kMaxExponent)
+        return std::nullopt;
+    }
+    if (negExp)
+      exponent = -exponent;
+  }
+  while (i < text.size() && text[i] == ' ')
+    ++i;
+  if (i != text.size())
+    return std::nullopt;
+
+  auto mantissa = BigInt::fromString(digits);
+  if (!mantissa)
+    return std::nullopt;
+  const long long shift = exponent - fraction;
+  if (shift >= 0)
+    return reduceBig(*mantissa * powerOfTen(static_cast<std::uint64_t>(shift)),
+                     BigInt(1));
+  return reduceBig(*mantissa, powerOfTen(static_cast<std::uint64_t>(-shift)));
+}
+
+/**
+ * @brief Text form.
+ * @return "n" or "n/d".
+ */
+std::string Rational::toString() const {
+  if (!big_)
+    return den_ == 1 ? std::to_string(num_)
+                     : std::to_string(num_) + "/" + std::to_string(den_);
+  if (bden_ == BigInt(1))
+    return bnum_.toString();
+  return bnum_.toString() + "/" + bden_.toString();
+}
+
+/**
+ * @brief Approximate value.
+ * @return num / den rounded to long double.
+ */
+long double Rational::toLongDouble() const {
+  if (!big_)
+    return static_cast<long double>(num_) / static_cast<long double>(den_);
+  // Scale so the integer quotient carries ~21 significant digits, which
+  // avoids inf/inf when both parts exceed the long double range.
+  const std::size_t nd = bnum_.digitCount(), dd = bden_.digitCount();
+  const std::uint64_t k = dd + 21 > nd ? dd + 21 - nd : 0;
+  const BigInt q = BigInt::divMod(bnum_ * powerOfTen(k), bden_)->first;
+  return q.toLongDouble() * std::pow(10.0L, -static_cast<long double>(k));
+}
+
+/** @brief Numerator. @return Signed numerator. */
+BigInt Rational::numerator() const { return big_ ? bnum_ : BigInt(num_); }
+
+/** @brief Denominator. @return Positive denominator. */
+BigInt Rational::denominator() const { return big_ ? bden_ : BigInt(den_); }
+
+/** @brief Integer test. @return true if the denominator is 1. */
+bool Rational::isInteger() const { return big_ ? bden_ == BigInt(1) : den_ == 1; }
+
+/** @brief Zero test. @return true for 0 (never stored as BigInt). */
+bool Rational::isZero() const { return !big_ && num_ == 0; }
+
+/**
+ * @brief Sum. Fast path: with g = gcd(b, d), a/b + c/d = (a (d/g) + c (b/g))
+ *        / (b/g * d), and only factors of g can remain to cancel (Henrici).
+ * @return a + b.
+ */
+Rational operator+(const Rational &a, const Rational &b) {
+  if (!a.big_ && !b.big_) {
+    const UInt g = numtheory::gcd(static_cast<UInt>(a.den_),
+                                  static_cast<UInt>(b.den_));
+    const Int ad = a.den_ / static_cast<Int>(g);
+    const Int bd = b.den_ / static_cast<Int>(g);
+    Int n1 = 0, n2 = 0, n = 0, d = 0;
+    if (checked::mul(a.num_, bd, n1) && checked::mul(b.num_, ad, n2) &&
+        checked::add(n1, n2, n) && checked::mul(ad, b.den_, d)) {
+      if (g == 1) { // coprime denominators: already reduced
+        if (fits64(n) && fits64(d))
+          return Rational::small(static_cast<std::int64_t>(n),
+                                 static_cast<std::int64_t>(d));
+        return Rational::reduce(n, d);
+      }
+      const Int g2 =
+          static_cast<Int>(numtheory::gcd(checked::magnitude(n), g));
+      return Rational::reduce(n / g2, d / g2);
+    }
+  }
+  const BigInt an = a.numerator(), ad = a.denominator();
+  const BigInt bn = b.numerator(), bd = b.denominator();
+  return Rational::reduceBig(an * bd + bn * ad, ad * bd);
+}
+
+/**
+ * @brief Negation.
+ * @return -a.
+ */
+Rational operator-(const Rational &a) {
+  if (!a.big_ && a.num_ != kMin64)
+    return Rational::small(-a.num_, a.den_);
+  return Rational::reduceBig(-a.numerator(), a.denominator());
+}
+
+/**
+ * @brief Difference.
+ * @return a - b.
+ */
+Rational operator-(const Rational &a, const Rational &b) { return a + (-b); }
+
+/**
+ * @brief Product. Fast path cross-cancels first, so the result is already
+ *        reduced: (a/b)(c/d) = ((a/g1)(c/g2)) / ((b/g2)(d/g1)).
+ * @return a * b.
+ */
+Rational operator*(const Rational &a, const Rational &b) {
+  if (!a.big_ && !b.big_) {
+    const Int g1 = static_cast<Int>(numtheory::gcd(
+        checked::magnitude(a.num_), static_cast<UInt>(b.den_)));
+    const Int g2 = static_cast<Int>(numtheory::gcd(
+        checked::magnitude(b.num_), static_cast<UInt>(a.den_)));
+    Int n = 0, d = 0;
+    if (checked::mul(a.num_ / g1, b.num_ / g2, n) &&
+        checked::mul(a.den_ / g2, b.den_ / g1, d)) {
+      if (fits64(n) && fits64(d))
+        return Rational::small(static_cast<std::int64_t>(n),
+                               static_cast<std::int64_t>(d));
+      return Rational::reduce(n, d);
+    }
+  }
+  return Rational::reduceBig(a.numerator() * b.numerator(),
+                             a.denominator() * b.denominator());
+}
+
+/**
+ * @brief Quotient.
+ * @param a Dividend.
+ * @param b Divisor.
+ * @return a / b or std::nullopt when b == 0.
+ */
+std::optional<Rational> Rational::divide(const Rational &a, const Rational &b) {
+  if (b.isZero())
+    return std::nullopt;
+  Rational inv;
+  if (!b.big_ && b.num_ != kMin64)
+    inv = small(b.num_ < 0 ? -b.den_ : b.den_, b.num_ < 0 ? -b.num_ : b.num_);
+  else
+    inv = reduceBig(b.denominator(), b.numerator());
+  return a * inv;
+}
+
+/**
+ * @brief Integer power by repeated squaring.
+ * @param e Exponent.
+ * @return this^e or std::nullopt for 0^negative.
+ */
+std::optional<Rational> Rational::pow(long long e) const {
+  Rational base = *this;
+  if (e < 0) {
+    auto inv = divide(fromInteger(1), *this);
+    if (!inv)
+      return std::nullopt;
+    base = *inv;
+  }
+  unsigned long long k =
+      e < 0 ? 0ull - static_cast<unsigned long long>(e) : static_cast<unsigned long long>(e);
+  Rational result = fromInteger(1);
+  while (k) {
+    if (k & 1)
+      result = result * base;
+    k >>= 1;
+    if (k)
+      base = base * base;
+  }
+  return result;
+}
+
+/**
+ * @brief Equality (values are canonical, so storage and parts must match).
+ */
+bool operator==(const Rational &a, const Rational &b) {
+  if (a.big_ != b.big_)
+    return false;
+  if (!a.big_)
+    return a.num_ == b.num_ && a.den_ == b.den_;
+  return a.bnum_ == b.bnum_ && a.bden_ == b.bden_;
+}
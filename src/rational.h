@@ -0,0 +1,98 @@
+#pragma once
+#include "bigint.h"
+#include "checked_int.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+/**
+ * @file rational.h
+ * @brief Declaration of Rational (exact reduced fraction).
+ *
+ * Values are always kept reduced with a positive denominator. While both
+ * parts fit in 64 bits they live in plain int64 fields and arithmetic runs
+ * on checked::Int (128-bit where available) with binary-GCD reduction;
+ * cross-cancelling before multiplying and Henrici's gcd split for sums keep
+ * the intermediates small. A result that no longer fits is promoted to
+ * BigInt numerator/denominator, and demoted back as soon as it fits again,
+ * so long exact chains stay on the fast path whenever they can.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+class Rational {
+public:
+  /** @brief Zero. */
+  Rational() = default;
+  /** @brief Integer value. @param v Value. */
+  static Rational fromInteger(checked::Int v);
+  /**
+   * @brief Reduced fraction num / den.
+   * @return The fraction, or std::nullopt when @p den is zero.
+   */
+  static std::optional<Rational> make(const BigInt &num, const BigInt &den);
+  /**
+   * @brief Parse "n", "n/d" or a decimal such as "-1.25" or "3e-4" exactly.
+   *
+   * n and d may each be decimals ("1.5/0.25"), but there is at most one
+   * '/': "1/2/3" is rejected rather than read as a nested fraction.
+   *
+   * @return Value, or std::nullopt if @p text is not a number.
+   */
+  static std::optional<Rational> fromString(const std::string &text);
+
+  /** @brief "n" for integers, otherwise "n/d". */
+  std::string toString() const;
+  /** @brief Nearest long double (about 21 significant digits computed). */
+  long double toLongDouble() const;
+  /** @brief Numerator (carries the sign). */
+  BigInt numerator() const;
+  /** @brief Denominator (always positive). */
+  BigInt denominator() const;
+  /** @brief Whether the denominator is 1. */
+  bool isInteger() const;
+  /** @brief Whether the value is zero. */
+  bool isZero() const;
+  /** @brief Whether the value has been promoted to BigInt storage. */
+  bool isBig() const { return big_; }
+
+  /** @brief Sum. */
+  friend Rational operator+(const Rational &a, const Rational &b);
+  /** @brief Difference. */
+  friend Rational operator-(const Rational &a, const Rational &b);
+  /** @brief Product. */
+  friend Rational operator*(const Rational &a, const Rational &b);
+  /** @brief Negation. */
+  friend Rational operator-(const Rational &a);
+  /**
+   * @brief Quotient.
+   * @return a / b, or std::nullopt when b is zero.
+   */
+  static std::optional<Rational> divide(const Rational &a, const Rational &b);
+  /**
+   * @brief Integer power (negative exponents invert).
+   * @return this^e, or std::nullopt for 0^e with e < 0.
+   */
+  std::optional<Rational> pow(long long e) const;
+
+  friend bool operator==(const Rational &a, const Rational &b);
+  friend bool operator!=(const Rational &a, const Rational &b) {
+    return !(a == b);
+  }
+
+private:
+  /// Fast-path value; the caller guarantees den > 0 and gcd(num, den) == 1.
+  static Rational small(std::int64_t num, std::int64_t den);
+  /// Reduce num / den (den != 0) and pick the cheapest storage.
+  static Rational reduce(checked::Int num, checked::Int den);
+  /// Reduce BigInt num / den (den != 0) and demote when it fits.
+  static Rational reduceBig(BigInt num, BigInt den);
+  /// Parse an integer or decimal such as "-1.25" or "3e-4" (no '/').
+  static std::optional<Rational> fromDecimal(const std::string &text);
+
+  std::int64_t num_ = 0; ///< Numerator (fast path).
+  std::int64_t den_ = 1; ///< Denominator > 0 (fast path).
+  bool big_ = false;     ///< Whether bnum_/bden_ hold the value.
+  BigInt bnum_;          ///< Numerator (promoted).
+  BigInt bden_;          ///< Denominator > 0 (promoted).
+};
@@ -0,0 +1,320 @@
+/**
+ * @file replay_main.cpp
+ * @brief Headless keystroke latency replay harness for UICalculator.
+ *
+ * Runs the real calculator window on the Qt "offscreen" platform, replays a
+ * recorded (or generated) script of key presses and button clicks, and
+ * measures for every step the time from dispatch until the display
+ * (symbolShower) was last updated. Percentiles are reported per step category
+ * so regressions in the interactive path show up before release.
+ *
+ * Script format: whitespace-separated tokens, '#' starts a comment.
+ * - Keys: 0-9 (multi-digit tokens type each digit), '.', '+', '-', '*', '/',
+ *   '=', Enter, Esc, Back, Del.
+ * - Buttons: @0..@9, @dot, @add, @sub, @mul, @div, @eql, @clr, @ce, @back,
+ *   @convert, @random.
+ *
+ * Usage:
+ *   calculator_replay [--script FILE] [--generate N] [--seed S]
+ *                     [--repeat R] [--budget-us P99]
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#include "UICalculator.h"
+#include <QApplication>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTimer>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// One replayable user action.
+struct Step {
+  bool isKey = true;    ///< Key event (true) or button click (false).
+  int key = 0;          ///< Qt::Key for key steps.
+  QString text;         ///< Key text for key steps.
+  QString button;       ///< Object name for button steps.
+  std::string category; ///< Reporting bucket.
+};
+
+Step keyStep(int key, const QString &text, const char *category) {
+  Step s;
+  s.key = key;
+  s.text = text;
+  s.category = category;
+  return s;
+}
+
+Step buttonStep(const QString &name, const char *category) {
+  Step s;
+  s.isKey = false;
+  s.button = name;
+  s.category = category;
+  return s;
+}
+
+/**
+ * @brief Translate one script token into steps.
+ * @return false if the token is unknown.
+ */
+bool parseToken(const std::string &tok, std::vector<Step> &out) {
+  static const std::map<std::string, Step> fixed = {
+      {".", keyStep(Qt::Key_Period, ".", "edit")},
+      {"+", keyStep(Qt::Key_Plus, "+", "operator")},
+      {"-", keyStep(Qt::Key_Minus, "-", "operator")},
+      {"*", keyStep(Qt::Key_Asterisk, "*", "operator")},
+      {"/", keyStep(Qt::Key_Slash, "/", "operator")},
+      {"=", keyStep(Qt::Key_Equal, "=", "equals")},
+      {"Enter", keyStep(Qt::Key_Return, "\r", "equals")},
+      {"Esc", keyStep(Qt::Key_Escape, QString(), "edit")},
+      {"Back", keyStep(Qt::Key_Backspace, QString(), "edit")},
+      {"Del", keyStep(Qt::Key_Delete, QString(), "edit")},
+      {"@dot", buttonStep("btnDot", "edit")},
+      {"@add", buttonStep("btnAdd", "operator")},
+      {"@sub", buttonStep("btnSub", "operator")},
+      {"@mul", buttonStep("btnMul", "operator")},
+      {"@div", buttonStep("btnDiv", "operator")},
+      {"@eql", buttonStep("btnEql", "equals")},
+      {"@clr", buttonStep("btnClr", "edit")},
+      {"@ce", buttonStep("btnCE", "edit")},
+      {"@back", buttonStep("btnBck", "edit")},
+      {"@convert", buttonStep("btnConvert", "convert")},
+      {"@random", buttonStep("btnRan", "random")}};
+
+  auto it = fixed.find(tok);
+  if (it != fixed.end()) {
+    out.push_back(it->second);
+    return true;
+  }
+  if (tok.size() == 2 && tok[0] == '@' && tok[1] >= '0' && tok[1] <= '9') {
+    out.push_back(buttonStep(QString("btn%1").arg(QChar(tok[1])), "digit"));
+    return true;
+  }
+  if (!tok.empty() && std::all_of(tok.begin(), tok.end(),
+                                  [](char c) { return c >= '0' && c <= '9'; })) {
+    for (char c : tok)
+      out.push_back(keyStep(Qt::Key_0 + (c - '0'), QString(QChar(c)), "digit"));
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Parse a whole script.
+ * @return false (and prints the token) on the first unknown token.
+ */
+bool parseScript(std::istream &in, std::vector<Step> &out) {
+  std::string line;
+  while (std::getline(in, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream words(line);
+    std::string tok;
+    while (words >> tok) {
+      if (!parseToken(tok, out)) {
+        std::fprintf(stderr, "unknown token '%s'\n", tok.c_str());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Generate a synthetic session of roughly @p count tokens mixing
+ *        typed numbers, chained operators, equals, edits, Convert and Random.
+ */
+std::string generateScript(std::size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> pct(0, 99);
+  std::uniform_int_distribution<int> digits(1, 6);
+  std::uniform_int_distribution<int> digit(0, 9);
+  const char *keyOps[] = {"+", "-", "*", "/"};
+  const char *btnOps[] = {"@add", "@sub", "@mul", "@div"};
+
+  std::string s;
+  for (std::size_t i = 0; i < count; ++i) {
+    const int p = pct(gen);
+    if (p < 45) { // typed number
+      const int n = digits(gen);
+      for (int d = 0; d < n; ++d)
+        s += static_cast<char>('0' + (d == 0 ? 1 + digit(gen) % 9 : digit(gen)));
+    } else if (p < 55) { // clicked digit
+      s += "@" + std::to_string(digit(gen));
+    } else if (p < 75) { // chained operator
+      s += (p & 1) ? keyOps[p % 4] : btnOps[p % 4];
+    } else if (p < 85) {
+      s += (p & 1) ? "Enter" : "@eql";
+    } else if (p < 90) {
+      s += (p & 1) ? "Back" : "@back";
+    } else if (p < 93) {
+      s += "@convert";
+    } else if (p < 96) {
+      s += "@random";
+    } else if (p < 98) {
+      s += ".";
+    } else {
+      s += (p & 1) ? "Esc" : "@ce";
+    }
+    s += (i % 16 == 15) ? '\n' : ' ';
+  }
+  return s;
+}
+
+/// Nearest-rank percentile of a sorted sample (microseconds).
+double percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty())
+    return 0.0;
+  const std::size_t idx = static_cast<std::size_t>(
+      std::min<double>(sorted.size() - 1, p / 100.0 * sorted.size()));
+  return sorted[idx];
+}
+
+/// Drop qDebug chatter from the UI so it does not skew timings.
+void quietHandler(QtMsgType type, const QMessageLogContext &,
+                  const QString &msg) {
+  if (type != QtDebugMsg && type != QtInfoMsg)
+    std::fprintf(stderr, "%s\n", qPrintable(msg));
+}
+
+} // namespace
+
+/**
+ * @brief Harness entry point.
+ * @param argc Argument count.
+ * @param argv Arguments (see file documentation).
+ * @return 0 on success, 1 on bad input, 2 if the p99 budget was exceeded.
+ */
+int main(int argc, char *argv[]) {
+  if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  qInstallMessageHandler(quietHandler);
+  QApplication app(argc, argv);
+
+  std::string scriptPath;
+  std::size_t generate = 0;
+  unsigned seed = 1;
+  int repeat = 1;
+  double budgetUs = 0.0;
+  const QStringList args = app.arguments();
+  for (int i = 1; i < args.size(); ++i) {
+    const QString a = args[i];
+    const bool hasValue = i + 1 < args.size();
+    if (a == "--script" && hasValue)
+      scriptPath = args[++i].toStdString();
+    else if (a == "--generate" && hasValue)
+      generate = args[++i].toULongLong();
+    else if (a == "--seed" && hasValue)
+      seed = args[++i].toUInt();
+    else if (a == "--repeat" && hasValue)
+      repeat = std::max(1, args[++i].toInt());
+    else if (a == "--budget-us" && hasValue)
+      budgetUs = args[++i].toDouble();
+    else {
+      std::fprintf(stderr, "unknown argument '%s'\n", qPrintable(a));
+      return 1;
+    }
+  }
+
+  std::vector<Step> steps;
+  if (!scriptPath.empty()) {
+    std::ifstream in(scriptPath);
+    if (!in) {
+      std::fprintf(stderr, "cannot open '%s'\n", scriptPath.c_str());
+      return 1;
+    }
+    if (!parseScript(in, steps))
+      return 1;
+  }
+  if (generate > 0 || scriptPath.empty()) {
+    std::istringstream in(generateScript(generate ? generate : 10000, seed));
+    parseScript(in, steps);
+  }
+
+  UICalculator calc;
+  calc.show();
+  QLineEdit *display = calc.findChild<QLineEdit *>("symbolShower");
+  if (!display) {
+    std::fprintf(stderr, "display widget not found\n");
+    return 1;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point lastUpdate;
+  bool updated = false;
+  QObject::connect(display, &QLineEdit::textChanged, [&] {
+    lastUpdate = Clock::now();
+    updated = true;
+  });
+
+  std::map<std::string, std::vector<double>> latencies;
+  std::vector<double> all;
+  all.reserve(steps.size() * static_cast<std::size_t>(repeat));
+
+  for (int r = 0; r < repeat; ++r) {
+    for (const Step &step : steps) {
+      QPushButton *button = nullptr;
+      if (!step.isKey) {
+        button = calc.findChild<QPushButton *>(step.button);
+        if (!button) {
+          std::fprintf(stderr, "button '%s' not found\n",
+                       qPrintable(step.button));
+          return 1;
+        }
+      }
+      // Convert opens a modal dialog; dismiss it from inside its event loop.
+      if (step.category == "convert")
+        QTimer::singleShot(0, [] {
+          if (QWidget *modal = QApplication::activeModalWidget())
+            modal->close();
+        });
+
+      updated = false;
+      const Clock::time_point t0 = Clock::now();
+      if (step.isKey) {
+        QKeyEvent ev(QEvent::KeyPress, step.key, Qt::NoModifier, step.text);
+        QApplication::sendEvent(&calc, &ev);
+      } else {
+        button->click();
+      }
+      const Clock::time_point t1 = updated ? lastUpdate : Clock::now();
+      const double us =
+          std::chrono::duration<double, std::micro>(t1 - t0).count();
+      latencies[step.category].push_back(us);
+      all.push_back(us);
+
+      // Let repaints and button animations run outside the measured window.
+      QCoreApplication::processEvents();
+    }
+  }
+
+  auto report = [](const char *name, std::vector<double> &v) {
+    std::sort(v.begin(), v.end());
+    std::printf("%-10s %9zu %9.1f %9.1f %9.1f %9.1f %9.1f\n", name, v.size(),
+                percentile(v, 50), percentile(v, 90), percentile(v, 99),
+                percentile(v, 99.9), v.empty() ? 0.0 : v.back());
+  };
+  std::printf("%-10s %9s %9s %9s %9s %9s %9s   (microseconds)\n", "category",
+              "count", "p50", "p90", "p99", "p99.9", "max");
+  for (auto &entry : latencies)
+    report(entry.first.c_str(), entry.second);
+  report("all", all);
+
+  if (budgetUs > 0.0 && percentile(all, 99) > budgetUs) {
+    std::fprintf(stderr, "p99 latency %.1f us exceeds budget %.1f us\n",
+                 percentile(all, 99), budgetUs);
+    return 2;
+  }
+  return 0;
+}
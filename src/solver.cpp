@@ -0,0 +1,542 @@
+/**
+ * @file solver.cpp
+ * @brief Implementation of the Aberth–Ehrlich polynomial solver and the
+ *        Newton/Brent scalar root finder.
+ *
+ * The Aberth sweep is O(n^2): for every root it sums 1/(z_i - z_j) over all
+ * others. The approximations are kept as separate real and imaginary arrays
+ * so that inner loop is a plain streaming reduction, and the unconverged
+ * roots of a sweep are shared out to threads in fixed-size blocks.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "solver.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace solver {
+namespace {
+
+constexpr double kEps = std::numeric_limits<double>::epsilon();
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+/// Roots per work block of a parallel sweep.
+constexpr std::size_t kBlock = 64;
+/// Below this many pair terms per sweep the threads cost more than they save.
+constexpr std::size_t kParallelWork = std::size_t(1) << 16;
+
+/// Newton correction at a point plus the scaled sizes used for stopping and
+/// error bounds.
+struct Eval {
+  Complex newton;       ///< p(z) / p'(z) (infinite when p'(z) == 0).
+  double residual = 0;  ///< |p(z)|, divided by |z|^n when |z| > 1.
+  double bound = 0;     ///< sum |c_k| |z|^(n-k), same scaling.
+  double slope = 0;     ///< |p'(z)|, same scaling.
+};
+
+/// Coefficients as split arrays, highest power first ([0]) and reversed ([1]).
+struct Poly {
+  std::size_t n = 0;
+  std::vector<double> re[2], im[2], mag[2];
+
+  explicit Poly(const std::vector<Complex> &c) : n(c.size() - 1) {
+    for (int d = 0; d < 2; ++d) {
+      re[d].resize(n + 1);
+      im[d].resize(n + 1);
+      mag[d].resize(n + 1);
+      for (std::size_t k = 0; k <= n; ++k) {
+        const Complex a = c[d == 0 ? k : n - k];
+        re[d][k] = a.real();
+        im[d][k] = a.imag();
+        mag[d][k] = std::abs(a);
+      }
+    }
+  }
+};
+
+/// Points evaluated together; their Horner chains are independent, so the
+/// multiply-add latency of one hides behind the others.
+constexpr std::size_t kLanes = 4;
+
+/**
+ * @brief Evaluate p and p' at @p count (<= kLanes) points by Horner's rule;
+ *        for |z| > 1 the reversed polynomial in w = 1/z is used instead.
+ */
+void evaluate(const Poly &poly, const Complex *z, std::size_t count,
+              Eval *out) {
+  const std::size_t n = poly.n;
+  bool reversed[kLanes];
+  double xr[kLanes], xi[kLanes], ax[kLanes];
+  const double *cr[kLanes], *ci[kLanes], *cm[kLanes];
+  double pr[kLanes], pi[kLanes], dr[kLanes], di[kLanes], b[kLanes];
+  for (std::size_t u = 0; u < kLanes; ++u) {
+    const Complex p = z[u < count ? u : 0]; // spare lanes repeat lane 0
+    reversed[u] = std::abs(p) > 1.0;
+    const Complex x = reversed[u] ? 1.0 / p : p;
+    const int d = reversed[u] ? 1 : 0;
+    xr[u] = x.real();
+    xi[u] = x.imag();
+    ax[u] = std::abs(x);
+    cr[u] = poly.re[d].data();
+    ci[u] = poly.im[d].data();
+    cm[u] = poly.mag[d].data();
+    pr[u] = cr[u][0];
+    pi[u] = ci[u][0];
+    b[u] = cm[u][0];
+    dr[u] = di[u] = 0.0;
+  }
+  // Horner in real arithmetic (std::complex products carry NaN fix-ups that
+  // would dominate this loop).
+  for (std::size_t k = 1; k <= n; ++k)
+    for (std::size_t u = 0; u < kLanes; ++u) {
+      const double tr = dr[u] * xr[u] - di[u] * xi[u] + pr[u];
+      di[u] = dr[u] * xi[u] + di[u] * xr[u] + pi[u];
+      dr[u] = tr;
+      const double ur = pr[u] * xr[u] - pi[u] * xi[u] + cr[u][k];
+      pi[u] = pr[u] * xi[u] + pi[u] * xr[u] + ci[u][k];
+      pr[u] = ur;
+      b[u] = b[u] * ax[u] + cm[u][k];
+    }
+  for (std::size_t u = 0; u < count; ++u) {
+    const Complex p(pr[u], pi[u]), dp(dr[u], di[u]), x(xr[u], xi[u]);
+    Eval &e = out[u];
+    e.residual = std::abs(p);
+    e.bound = b[u];
+    if (!reversed[u]) {
+      e.slope = std::abs(dp);
+      e.newton = dp == 0.0 ? Complex(HUGE_VAL, 0.0) : p / dp;
+      continue;
+    }
+    // z^-n p(z) = q(w) = sum c[k] w^k, and p/p' = q / (w (n q - w q')),
+    // divided in two steps so the denominator cannot underflow.
+    const Complex d = static_cast<double>(n) * p - x * dp;
+    e.slope = ax[u] * std::abs(d);
+    e.newton = d == 0.0 ? Complex(HUGE_VAL, 0.0) : p / d / x;
+  }
+}
+
+/**
+ * @brief Starting points on the circles of the Newton polygon of
+ *        log|a_k| (upper convex hull), one circle per hull edge.
+ */
+std::vector<Complex> initialGuesses(const std::vector<Complex> &c) {
+  const std::size_t n = c.size() - 1;
+  // a_k (coefficient of x^k) is c[n - k].
+  std::vector<std::size_t> hull;
+  std::vector<double> logs(n + 1);
+  for (std::size_t k = 0; k <= n; ++k) {
+    const double m = std::abs(c[n - k]);
+    logs[k] = m > 0.0 ? std::log(m) : -HUGE_VAL;
+    if (m == 0.0)
+      continue;
+    while (hull.size() >= 2) {
+      const std::size_t i = hull[hull.size() - 2], j = hull.back();
+      // Drop j when it lies on or below the segment i -> k.
+      const double cross = (static_cast<double>(j - i)) * (logs[k] - logs[i]) -
+                           (static_cast<double>(k - i)) * (logs[j] - logs[i]);
+      if (cross < 0.0)
+        break;
+      hull.pop_back();
+    }
+    hull.push_back(k);
+  }
+  std::vector<Complex> z;
+  z.reserve(n);
+  const double sigma = 0.7;
+  for (std::size_t e = 0; e + 1 < hull.size(); ++e) {
+    const std::size_t k1 = hull[e], k2 = hull[e + 1];
+    const double m = static_cast<double>(k2 - k1);
+    const double r = std::exp((logs[k1] - logs[k2]) / m);
+    for (std::size_t j = 0; j < k2 - k1; ++j) {
+      const double angle = kTwoPi * (static_cast<double>(j) / m +
+                                     static_cast<double>(e) /
+                                         static_cast<double>(n)) +
+                           sigma;
+      z.push_back(std::polar(r, angle));
+    }
+  }
+  return z;
+}
+
+/**
+ * @brief sum over j != i of 1 / (z_i - z_j) with split coordinates.
+ * Four independent accumulators keep the divisions pipelined. If some
+ * |z_i - z_j|^2 left the normal range (extreme roots), the sum is redone
+ * with each difference scaled by its larger component before squaring.
+ */
+Complex aberthSum(const double *xr, const double *xi, std::size_t n,
+                  std::size_t i) {
+  const double zr = xr[i], zi = xi[i];
+  double sr[4] = {0, 0, 0, 0}, si[4] = {0, 0, 0, 0};
+  double lo[4] = {HUGE_VAL, HUGE_VAL, HUGE_VAL, HUGE_VAL};
+  double hi[4] = {0, 0, 0, 0};
+  auto range = [&](std::size_t begin, std::size_t end) {
+    std::size_t j = begin;
+    for (; j + 4 <= end; j += 4)
+      for (int u = 0; u < 4; ++u) {
+        const double dr = zr - xr[j + u], di = zi - xi[j + u];
+        const double m = dr * dr + di * di;
+        const double inv = 1.0 / m;
+        lo[u] = m < lo[u] ? m : lo[u];
+        hi[u] = m > hi[u] ? m : hi[u];
+        sr[u] += dr * inv;
+        si[u] -= di * inv;
+      }
+    for (; j < end; ++j) {
+      const double dr = zr - xr[j], di = zi - xi[j];
+      const double m = dr * dr + di * di;
+      const double inv = 1.0 / m;
+      lo[0] = m < lo[0] ? m : lo[0];
+      hi[0] = m > hi[0] ? m : hi[0];
+      sr[0] += dr * inv;
+      si[0] -= di * inv;
+    }
+  };
+  range(0, i);
+  range(i + 1, n);
+  if (std::min(std::min(lo[0], lo[1]), std::min(lo[2], lo[3])) >=
+          std::numeric_limits<double>::min() &&
+      std::max(std::max(hi[0], hi[1]), std::max(hi[2], hi[3])) <=
+          std::numeric_limits<double>::max())
+    return {(sr[0] + sr[1]) + (sr[2] + sr[3]),
+            (si[0] + si[1]) + (si[2] + si[3])};
+  double tr = 0.0, ti = 0.0;
+  for (std::size_t j = 0; j < n; ++j) {
+    if (j == i)
+      continue;
+    const double dr = zr - xr[j], di = zi - xi[j];
+    const double scale = std::max(std::fabs(dr), std::fabs(di));
+    const double qr = dr / scale, qi = di / scale;
+    const double inv = 1.0 / (scale * (qr * qr + qi * qi));
+    tr += qr * inv;
+    ti -= qi * inv;
+  }
+  return {tr, ti};
+}
+
+/// Run fn(begin, end) over [0, count) in kBlock pieces on up to @p threads.
+template <typename Fn>
+void parallelFor(std::size_t count, unsigned threads, Fn &&fn) {
+  const std::size_t blocks = (count + kBlock - 1) / kBlock;
+  threads = static_cast<unsigned>(
+      std::max<std::size_t>(1, std::min<std::size_t>(threads, blocks)));
+  std::atomic<std::size_t> next{0};
+  auto worker = [&] {
+    for (std::size_t b; (b = next.fetch_add(1)) < blocks;)
+      fn(b * kBlock, std::min(count, (b + 1) * kBlock));
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(worker);
+  worker();
+  for (auto &th : pool)
+    th.join();
+}
+
+} // namespace
+
+/**
+ * @brief Aberth–Ehrlich iteration from Newton-polygon starting circles.
+ * @return Roots with inclusion radii, or std::nullopt for invalid input.
+ */
+std::optional<PolynomialResult>
+polynomialRoots(const std::vector<Complex> &coeffs,
+                const PolynomialOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  for (const Complex &a : coeffs)
+    if (!std::isfinite(a.real()) || !std::isfinite(a.imag()))
+      return std::nullopt;
+  std::size_t first = 0, last = coeffs.size();
+  while (first < last && coeffs[first] == 0.0)
+    ++first;
+  if (last - first < 2)
+    return std::nullopt;
+  // Trailing zeros are exact roots at 0.
+  PolynomialResult r;
+  while (coeffs[last - 1] == 0.0) {
+    --last;
+    r.roots.push_back(0.0);
+    r.errors.push_back(0.0);
+  }
+  const std::vector<Complex> c(coeffs.begin() + first, coeffs.begin() + last);
+  const std::size_t n = c.size() - 1;
+  if (n == 0) {
+    r.converged = true;
+    return r;
+  }
+
+  const Poly poly(c);
+  const std::vector<Complex> guess = initialGuesses(c);
+  std::vector<double> xr(n), xi(n), nr(n), ni(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    xr[i] = nr[i] = guess[i].real();
+    xi[i] = ni[i] = guess[i].imag();
+  }
+  // Rounding bound of complex Horner relative to sum |c_k| |z|^(n-k).
+  const double gamma = (4.0 * static_cast<double>(n) + 1.0) * kEps;
+  const unsigned threads = options.threads
+                               ? options.threads
+                               : std::max(1u, std::thread::hardware_concurrency());
+  std::vector<char> done(n, 0);
+  std::vector<std::size_t> active(n);
+  for (std::size_t i = 0; i < n; ++i)
+    active[i] = i;
+
+  for (; r.iterations < options.maxIterations && !active.empty();
+       ++r.iterations) {
+    const unsigned workers =
+        active.size() * n >= kParallelWork ? threads : 1u;
+    parallelFor(active.size(), workers, [&](std::size_t b, std::size_t e) {
+      Complex z[kLanes];
+      Eval ev[kLanes];
+      for (std::size_t k = b; k < e; k += kLanes) {
+        const std::size_t count = std::min(kLanes, e - k);
+        for (std::size_t u = 0; u < count; ++u)
+          z[u] = Complex(xr[active[k + u]], xi[active[k + u]]);
+        evaluate(poly, z, count, ev);
+        for (std::size_t u = 0; u < count; ++u) {
+          const std::size_t i = active[k + u];
+          if (ev[u].residual == 0.0) {
+            done[i] = 1;
+            continue;
+          }
+          // The step that reaches the rounding level is still taken: it is
+          // where the cubic convergence pays off.
+          if (ev[u].residual <= gamma * ev[u].bound)
+            done[i] = 1;
+          // 1 / (p'/p - S) written as N / (1 - N S) with N = p/p': near
+          // tiny roots p'/p alone overflows while N and N S stay in range.
+          const Complex sum = aberthSum(xr.data(), xi.data(), n, i);
+          const Complex newton = ev[u].newton;
+          const Complex step =
+              std::isfinite(newton.real()) && std::isfinite(newton.imag())
+                  ? newton / (1.0 - newton * sum)
+                  : -1.0 / sum;
+          if (!std::isfinite(step.real()) || !std::isfinite(step.imag()))
+            continue;
+          nr[i] = xr[i] - step.real();
+          ni[i] = xi[i] - step.imag();
+        }
+      }
+    });
+    for (const std::size_t i : active) {
+      xr[i] = nr[i];
+      xi[i] = ni[i];
+    }
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [&](std::size_t i) { return done[i] != 0; }),
+                 active.end());
+  }
+  r.converged = active.empty();
+
+  const std::size_t zeros = r.roots.size();
+  r.roots.resize(zeros + n);
+  r.errors.resize(zeros + n);
+  const unsigned workers = n * n >= kParallelWork ? threads : 1u;
+  parallelFor(n, workers, [&](std::size_t b, std::size_t e) {
+    Complex z[kLanes];
+    Eval ev[kLanes];
+    for (std::size_t i = b; i < e; i += kLanes) {
+      const std::size_t count = std::min(kLanes, e - i);
+      for (std::size_t u = 0; u < count; ++u)
+        z[u] = r.roots[zeros + i + u] = Complex(xr[i + u], xi[i + u]);
+      evaluate(poly, z, count, ev);
+      for (std::size_t u = 0; u < count; ++u)
+        r.errors[zeros + i + u] =
+            ev[u].slope > 0.0
+                ? static_cast<double>(n) *
+                      (ev[u].residual + gamma * ev[u].bound) / ev[u].slope
+                : HUGE_VAL;
+    }
+  });
+  r.seconds = std::chrono::duration<double>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+  return r;
+}
+
+namespace {
+
+constexpr long double kEpsL = std::numeric_limits<long double>::epsilon();
+constexpr int kMaxEvaluations = 500;
+
+/// Counting wrapper around Expression::evaluate.
+struct Function {
+  const Expression &expr;
+  int evaluations = 0;
+  long double operator()(long double x) {
+    ++evaluations;
+    return expr.evaluate(x);
+  }
+};
+
+bool finite(long double v) { return std::isfinite(v); }
+bool opposite(long double a, long double b) {
+  return (a < 0.0L && b > 0.0L) || (a > 0.0L && b < 0.0L);
+}
+
+/**
+ * @brief Brent's method on a bracket with f(a), f(b) of opposite sign (or
+ *        one of them zero).
+ */
+ScalarResult brent(Function &f, long double a, long double fa, long double b,
+                   long double fb) {
+  ScalarResult r;
+  r.bracketed = true;
+  if (fa == 0.0L || fb == 0.0L) {
+    r.root = fa == 0.0L ? a : b;
+    r.converged = true;
+    r.evaluations = f.evaluations;
+    return r;
+  }
+  long double c = a, fc = fa, d = b - a, e = d;
+  // Absolute resolution on the bracket's scale: without it a root at 0
+  // would get a zero tolerance (and zero minimum steps).
+  const long double xtol = kEpsL * std::max(std::fabs(a), std::fabs(b));
+  while (f.evaluations < kMaxEvaluations) {
+    if (!opposite(fb, fc)) { // keep the root between b and c
+      c = a;
+      fc = fa;
+      d = e = b - a;
+    }
+    if (std::fabs(fc) < std::fabs(fb)) {
+      a = b;
+      b = c;
+      c = a;
+      fa = fb;
+      fb = fc;
+      fc = fa;
+    }
+    const long double tol = 2.0L * kEpsL * std::fabs(b) + 0.5L * xtol;
+    const long double m = 0.5L * (c - b);
+    if (std::fabs(m) <= tol || fb == 0.0L) {
+      r.converged = true;
+      break;
+    }
+    if (std::fabs(e) >= tol && std::fabs(fa) > std::fabs(fb)) {
+      // Secant or inverse quadratic interpolation.
+      long double p, q;
+      const long double s = fb / fa;
+      if (a == c) {
+        p = 2.0L * m * s;
+        q = 1.0L - s;
+      } else {
+        const long double qa = fa / fc, rb = fb / fc;
+        p = s * (2.0L * m * qa * (qa - rb) - (b - a) * (rb - 1.0L));
+        q = (qa - 1.0L) * (rb - 1.0L) * (s - 1.0L);
+      }
+      if (p > 0.0L)
+        q = -q;
+      else
+        p = -p;
+      if (2.0L * p < std::min(3.0L * m * q - std::fabs(tol * q),
+                              std::fabs(e * q))) {
+        e = d;
+        d = p / q;
+      } else {
+        d = m;
+        e = m;
+      }
+    } else {
+      d = m;
+      e = m;
+    }
+    a = b;
+    fa = fb;
+    b += std::fabs(d) > tol ? d : (m > 0.0L ? tol : -tol);
+    fb = f(b);
+    if (!finite(fb))
+      break;
+  }
+  r.root = b;
+  r.value = fb;
+  r.error = std::fabs(c - b);
+  r.evaluations = f.evaluations;
+  return r;
+}
+
+} // namespace
+
+/**
+ * @brief Brent's method on [a, b].
+ * @return Root, or std::nullopt without a sign change.
+ */
+std::optional<ScalarResult> findRoot(const Expression &f, long double a,
+                                     long double b) {
+  if (f.variableCount() > 1 || !finite(a) || !finite(b))
+    return std::nullopt;
+  Function fn{f};
+  const long double fa = fn(a), fb = fn(b);
+  if (!finite(fa) || !finite(fb) ||
+      !(fa == 0.0L || fb == 0.0L || opposite(fa, fb)))
+    return std::nullopt;
+  return brent(fn, a, fa, b, fb);
+}
+
+/**
+ * @brief Damped Newton from @p guess; switches to Brent on a sign change.
+ * @return Root estimate, or std::nullopt for invalid input.
+ */
+std::optional<ScalarResult> findRoot(const Expression &f, long double guess) {
+  if (f.variableCount() > 1 || !finite(guess))
+    return std::nullopt;
+  Function fn{f};
+  long double x = guess, fx = fn(x);
+  if (!finite(fx))
+    return std::nullopt;
+  ScalarResult r;
+  r.root = x;
+  r.value = fx;
+  while (fx != 0.0L && fn.evaluations < kMaxEvaluations) {
+    // Central-difference slope; the probes double as a bracket search.
+    const long double h = std::cbrt(kEpsL) * std::max(std::fabs(x), 1.0L);
+    const long double fl = fn(x - h), fr = fn(x + h);
+    if (finite(fl) && opposite(fl, fx))
+      return brent(fn, x - h, fl, x, fx);
+    if (finite(fr) && opposite(fx, fr))
+      return brent(fn, x, fx, x + h, fr);
+    const long double slope = (fr - fl) / (2.0L * h);
+    if (!finite(slope) || slope == 0.0L)
+      break;
+    const long double newton = -fx / slope;
+    const long double scale = std::max(std::fabs(x), 1.0L);
+    // Halve the step until |f| decreases (or a sign change shows up).
+    long double step = newton;
+    bool moved = false;
+    for (int k = 0; k < 60 && fn.evaluations < kMaxEvaluations; ++k) {
+      const long double xn = x + step, fxn = fn(xn);
+      if (finite(fxn) && opposite(fx, fxn))
+        return brent(fn, x, fx, xn, fxn);
+      if (finite(fxn) && std::fabs(fxn) < std::fabs(fx)) {
+        x = xn;
+        fx = fxn;
+        moved = true;
+        break;
+      }
+      step *= 0.5L;
+    }
+    r.root = x;
+    r.value = fx;
+    r.error = std::fabs(newton);
+    // Stuck at the rounding level of f (e.g. a double root) or done moving.
+    if (!moved || std::fabs(step) <= 4.0L * kEpsL * scale) {
+      r.converged = r.error <= std::sqrt(kEpsL) * scale;
+      break;
+    }
+  }
+  if (fx == 0.0L) {
+    r.root = x;
+    r.value = 0.0L;
+    r.error = 0.0L;
+    r.converged = true;
+  }
+  r.evaluations = fn.evaluations;
+  return r;
+}
+
+} // namespace solver
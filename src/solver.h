@@ -0,0 +1,91 @@
+#pragma once
+#include "expression.h"
+#include <complex>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+/**
+ * @file solver.h
+ * @brief Polynomial roots (Aberth–Ehrlich) and scalar equations f(x) = 0.
+ *
+ * polynomialRoots() refines all roots at once with the Aberth–Ehrlich
+ * iteration, starting from circles given by the Newton polygon of the
+ * coefficient magnitudes. Each sweep updates every unconverged root from the
+ * previous sweep's approximations (Jacobi style), so the sweep is split across
+ * threads and the result does not depend on the thread count. p(z) is
+ * evaluated through the reversed polynomial when |z| > 1 so degrees in the
+ * thousands neither overflow nor lose accuracy. A root stops moving once
+ * |p(z)| is at the rounding level of its evaluation; its reported error is
+ * the radius of the Newton inclusion disk n (|p| + rounding) / |p'|, which
+ * contains a true root.
+ *
+ * findRoot() works in the engine's long double on a compiled Expression:
+ * Brent's method when a sign-changing bracket is known, otherwise a damped
+ * Newton iteration (central-difference slope) that hands over to Brent as
+ * soon as it steps across a sign change.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace solver {
+
+using Complex = std::complex<double>;
+
+/** @brief Knobs for polynomialRoots(). */
+struct PolynomialOptions {
+  unsigned threads = 0;     ///< Worker count; 0 = all cores.
+  int maxIterations = 500;  ///< Aberth sweeps before giving up.
+};
+
+/** @brief Roots plus per-root error bounds. */
+struct PolynomialResult {
+  std::vector<Complex> roots;  ///< Degree-many roots (with multiplicity).
+  std::vector<double> errors;  ///< Inclusion radius of each root.
+  int iterations = 0;          ///< Aberth sweeps performed.
+  bool converged = false;      ///< Every root reached the rounding level.
+  double seconds = 0.0;        ///< Wall-clock duration.
+};
+
+/**
+ * @brief All complex roots of a polynomial.
+ * @param coeffs Coefficients from the highest power down:
+ *        coeffs[0] x^n + coeffs[1] x^(n-1) + ... + coeffs[n].
+ *        Leading zeros are ignored.
+ * @param options Threads and iteration cap.
+ * @return Roots, or std::nullopt if a coefficient is not finite or the
+ *         polynomial is constant.
+ */
+std::optional<PolynomialResult>
+polynomialRoots(const std::vector<Complex> &coeffs,
+                const PolynomialOptions &options = {});
+
+/** @brief Root of f(x) = 0 with diagnostics. */
+struct ScalarResult {
+  long double root = 0.0L;   ///< Root estimate.
+  long double value = 0.0L;  ///< f(root).
+  long double error = 0.0L;  ///< Final bracket width or Newton step.
+  int evaluations = 0;       ///< Function evaluations.
+  bool bracketed = false;    ///< A sign change brackets the root.
+  bool converged = false;    ///< The tolerance was met.
+};
+
+/**
+ * @brief Root of @p f inside [a, b] (Brent's method).
+ * @param f Expression in one variable (or constant).
+ * @return Root, or std::nullopt if f(a) and f(b) have the same sign, the
+ *         limits are not finite or @p f is not finite at them.
+ */
+std::optional<ScalarResult> findRoot(const Expression &f, long double a,
+                                     long double b);
+
+/**
+ * @brief Root of @p f near @p guess (safeguarded Newton, then Brent once a
+ *        sign change is found).
+ * @param f Expression in one variable (or constant).
+ * @return Root (check converged), or std::nullopt if @p guess is not finite
+ *         or @p f is not finite there.
+ */
+std::optional<ScalarResult> findRoot(const Expression &f, long double guess);
+
+} // namespace solver
@@ -0,0 +1,696 @@
+/**
+ * @file symbolic.cpp
+ * @brief Implementation of the hash-consed expression DAG: interning,
+ *        simplifying constructors, differentiation, evaluation and printing.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "symbolic.h"
+#include "decimal.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace symbolic {
+namespace {
+
+constexpr NodeId kEmpty = std::numeric_limits<NodeId>::max();
+/// The value Expression's parser gives the name e.
+constexpr long double kE = 2.718281828459045235360287471352662498L;
+
+std::size_t mix(std::size_t h, std::size_t v) {
+  return h ^ (v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+}
+
+bool isInteger(long double v) {
+  return std::isfinite(v) && std::trunc(v) == v;
+}
+
+/// Engine arithmetic with NaN in place of an undefined result.
+long double engineOp(Engine::Op op, long double a, long double b) {
+  const auto r = Engine::apply(op, a, b);
+  return r ? *r : std::numeric_limits<long double>::quiet_NaN();
+}
+
+/// Shortest text that parses back to exactly @p v, in any locale.
+std::string constantText(long double v) {
+  char buffer[decimal::kMaxChars];
+  return std::string(buffer, decimal::format(buffer, v));
+}
+
+/// Printing precedence: what a node's text may appear inside unwrapped.
+enum Precedence { kSum = 1, kProduct = 2, kPower = 3, kAtom = 4 };
+
+struct Text {
+  std::string text;
+  int precedence = kAtom;
+};
+
+std::string wrap(const Text &t, int minimum) {
+  return t.precedence < minimum ? "(" + t.text + ")" : t.text;
+}
+
+} // namespace
+
+Graph::Graph(std::vector<std::string> variables)
+    : variables_(std::move(variables)), table_(64, kEmpty) {
+  zero_ = constant(0.0L);
+  one_ = constant(1.0L);
+  minusOne_ = constant(-1.0L);
+}
+
+/**
+ * @brief Look the node up in the open-addressing table and append it only
+ *        when it is new. @p operands must not point into operands_.
+ */
+NodeId Graph::intern(Kind kind, Expression::Func func, long double value,
+                     std::uint32_t index, const NodeId *operands,
+                     std::size_t count) {
+  std::size_t h = mix(static_cast<std::size_t>(kind),
+                      static_cast<std::size_t>(func));
+  h = mix(h, std::hash<long double>{}(value));
+  h = mix(h, index);
+  for (std::size_t i = 0; i < count; ++i)
+    h = mix(h, operands[i]);
+
+  const std::size_t mask = table_.size() - 1;
+  std::size_t slot = h & mask;
+  for (; table_[slot] != kEmpty; slot = (slot + 1) & mask) {
+    const NodeId id = table_[slot];
+    if (nodes_[id].hash == h &&
+        sameNode(nodes_[id], kind, func, value, index, operands, count))
+      return id;
+  }
+
+  Node node{kind};
+  node.func = func;
+  node.first = kind == Kind::Var ? index
+                                 : static_cast<std::uint32_t>(operands_.size());
+  node.count = static_cast<std::uint32_t>(count);
+  node.value = value;
+  node.hash = h;
+  operands_.insert(operands_.end(), operands, operands + count);
+  nodes_.push_back(node);
+  const NodeId id = static_cast<NodeId>(nodes_.size() - 1);
+  if (2 * nodes_.size() > table_.size())
+    growTable(); // re-inserts every node, the new one included
+  else
+    table_[slot] = id;
+  return id;
+}
+
+bool Graph::sameNode(const Node &node, Kind kind, Expression::Func func,
+                     long double value, std::uint32_t index,
+                     const NodeId *operands, std::size_t count) const {
+  if (node.kind != kind || node.count != count)
+    return false;
+  switch (kind) {
+  case Kind::Const:
+    return node.value == value;
+  case Kind::Var:
+    return node.first == index;
+  case Kind::Call:
+    if (node.func != func)
+      return false;
+    break;
+  default:
+    break;
+  }
+  return std::equal(operands, operands + count,
+                    operands_.begin() + node.first);
+}
+
+void Graph::growTable() {
+  table_.assign(table_.size() * 2, kEmpty);
+  const std::size_t mask = table_.size() - 1;
+  for (NodeId id = 0; id < nodes_.size(); ++id) {
+    std::size_t slot = nodes_[id].hash & mask;
+    while (table_[slot] != kEmpty)
+      slot = (slot + 1) & mask;
+    table_[slot] = id;
+  }
+}
+
+NodeId Graph::constant(long double value) {
+  if (value == 0.0L)
+    value = 0.0L; // -0 and +0 share a node
+  return intern(Kind::Const, Expression::Func::Sqrt, value, 0, nullptr, 0);
+}
+
+NodeId Graph::variable(std::size_t index) {
+  return intern(Kind::Var, Expression::Func::Sqrt, 0.0L,
+                static_cast<std::uint32_t>(index), nullptr, 0);
+}
+
+std::optional<long double> Graph::constantValue(NodeId id) const {
+  if (nodes_[id].kind != Kind::Const)
+    return std::nullopt;
+  return nodes_[id].value;
+}
+
+/**
+ * @brief Canonical sum: nested sums are flattened, each term is split into
+ *        coefficient * rest, coefficients of equal rests are added, and the
+ *        remaining terms are ordered by id with the constant last.
+ */
+NodeId Graph::sum(const std::vector<NodeId> &terms) {
+  long double constantPart = 0.0L;
+  std::vector<std::pair<NodeId, long double>> parts; // rest, coefficient
+  auto addTerm = [&](NodeId t) {
+    const Node node = nodes_[t];
+    if (node.kind == Kind::Const) {
+      constantPart += node.value;
+      return;
+    }
+    if (node.kind == Kind::Mul && kind(operands(t)[0]) == Kind::Const) {
+      const long double coefficient = nodes_[operands(t)[0]].value;
+      NodeId rest = operands(t)[1];
+      if (node.count > 2) {
+        const std::vector<NodeId> others(operands(t) + 1,
+                                         operands(t) + node.count);
+        rest = intern(Kind::Mul, Expression::Func::Sqrt, 0.0L, 0,
+                      others.data(), others.size());
+      }
+      parts.emplace_back(rest, coefficient);
+      return;
+    }
+    parts.emplace_back(t, 1.0L);
+  };
+  for (NodeId t : terms) {
+    if (kind(t) == Kind::Add) {
+      const std::vector<NodeId> nested(operands(t),
+                                       operands(t) + nodes_[t].count);
+      for (NodeId u : nested)
+        addTerm(u);
+    } else {
+      addTerm(t);
+    }
+  }
+
+  std::sort(parts.begin(), parts.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+  std::vector<NodeId> out;
+  for (std::size_t i = 0; i < parts.size();) {
+    long double coefficient = 0.0L;
+    std::size_t j = i;
+    for (; j < parts.size() && parts[j].first == parts[i].first; ++j)
+      coefficient += parts[j].second;
+    if (coefficient == 1.0L)
+      out.push_back(parts[i].first);
+    else if (coefficient != 0.0L)
+      out.push_back(product({constant(coefficient), parts[i].first}));
+    i = j;
+  }
+  std::sort(out.begin(), out.end());
+  if (constantPart != 0.0L || std::isnan(constantPart))
+    out.push_back(constant(constantPart));
+  if (out.empty())
+    return zero_;
+  if (out.size() == 1)
+    return out[0];
+  return intern(Kind::Add, Expression::Func::Sqrt, 0.0L, 0, out.data(),
+                out.size());
+}
+
+/**
+ * @brief Canonical product: nested products are flattened, constants
+ *        multiplied, exponents of equal bases added, and the remaining
+ *        factors ordered by id after the constant coefficient.
+ */
+NodeId Graph::product(const std::vector<NodeId> &factors) {
+  long double coefficient = 1.0L;
+  std::vector<std::pair<NodeId, NodeId>> parts; // base, exponent
+  auto addFactor = [&](NodeId f) {
+    const Node &node = nodes_[f];
+    if (node.kind == Kind::Const)
+      coefficient *= node.value;
+    else if (node.kind == Kind::Pow)
+      parts.emplace_back(operands(f)[0], operands(f)[1]);
+    else
+      parts.emplace_back(f, one_);
+  };
+  for (NodeId f : factors) {
+    if (kind(f) == Kind::Mul) {
+      for (std::uint32_t i = 0; i < nodes_[f].count; ++i)
+        addFactor(operands(f)[i]);
+    } else {
+      addFactor(f);
+    }
+  }
+  if (coefficient == 0.0L)
+    return zero_;
+
+  std::sort(parts.begin(), parts.end());
+  std::vector<NodeId> out, redistributed;
+  for (std::size_t i = 0; i < parts.size();) {
+    std::vector<NodeId> exponents;
+    std::size_t j = i;
+    for (; j < parts.size() && parts[j].first == parts[i].first; ++j)
+      exponents.push_back(parts[j].second);
+    const NodeId p = pow(parts[i].first, exponents.size() == 1
+                                             ? exponents[0]
+                                             : sum(exponents));
+    if (const auto v = constantValue(p))
+      coefficient *= *v;
+    else if (kind(p) == Kind::Mul) // (a b)^n multiplied out by pow()
+      redistributed.push_back(p);
+    else
+      out.push_back(p);
+    i = j;
+  }
+  if (coefficient == 0.0L)
+    return zero_;
+  if (!redistributed.empty()) { // its factors may share bases with out
+    out.insert(out.end(), redistributed.begin(), redistributed.end());
+    out.push_back(constant(coefficient));
+    return product(out);
+  }
+  std::sort(out.begin(), out.end());
+  if (coefficient != 1.0L && out.size() == 1 && kind(out[0]) == Kind::Add) {
+    // c (a + b) -> c a + c b, so that sums cancel term by term.
+    const std::vector<NodeId> terms(operands(out[0]),
+                                    operands(out[0]) + nodes_[out[0]].count);
+    std::vector<NodeId> scaled;
+    for (NodeId t : terms)
+      scaled.push_back(product({constant(coefficient), t}));
+    return sum(scaled);
+  }
+  if (coefficient != 1.0L)
+    out.insert(out.begin(), constant(coefficient));
+  if (out.empty())
+    return one_;
+  if (out.size() == 1)
+    return out[0];
+  return intern(Kind::Mul, Expression::Func::Sqrt, 0.0L, 0, out.data(),
+                out.size());
+}
+
+NodeId Graph::add(NodeId a, NodeId b) { return sum({a, b}); }
+
+NodeId Graph::sub(NodeId a, NodeId b) {
+  return sum({a, product({minusOne_, b})});
+}
+
+NodeId Graph::mul(NodeId a, NodeId b) { return product({a, b}); }
+
+NodeId Graph::div(NodeId a, NodeId b) {
+  return product({a, pow(b, minusOne_)});
+}
+
+NodeId Graph::neg(NodeId a) { return product({minusOne_, a}); }
+
+/**
+ * @brief Canonical power: trivial exponents and bases fold, constant powers
+ *        are evaluated, and integer powers of powers and of products are
+ *        multiplied out ((x^2)^3 -> x^6, (2 x)^2 -> 4 x^2).
+ */
+NodeId Graph::pow(NodeId base, NodeId exponent) {
+  const auto e = constantValue(exponent);
+  const auto b = constantValue(base);
+  if (e && *e == 0.0L)
+    return one_;
+  if (e && *e == 1.0L)
+    return base;
+  if (b && *b == 1.0L)
+    return one_;
+  if (b && *b == kE && !e) // e^x as written with the parser's constant e
+    return call(Expression::Func::Exp, exponent);
+  if (b && e) {
+    const long double r = engineOp(Engine::Op::Pow, *b, *e);
+    if (std::isfinite(r))
+      return constant(r);
+  }
+  if (e && isInteger(*e)) {
+    if (kind(base) == Kind::Pow) {
+      const NodeId inner = operands(base)[0];
+      const auto m = constantValue(operands(base)[1]);
+      if (m && isInteger(*m))
+        return pow(inner, constant(*m * *e));
+    } else if (kind(base) == Kind::Mul) {
+      const std::vector<NodeId> factors(operands(base),
+                                        operands(base) + nodes_[base].count);
+      std::vector<NodeId> powered;
+      for (NodeId f : factors)
+        powered.push_back(pow(f, exponent));
+      return product(powered);
+    }
+  }
+  const NodeId ops[2] = {base, exponent};
+  return intern(Kind::Pow, Expression::Func::Sqrt, 0.0L, 0, ops, 2);
+}
+
+NodeId Graph::call(Expression::Func func, NodeId argument) {
+  if (const auto v = constantValue(argument)) {
+    const long double r = Expression::apply(func, *v);
+    if (std::isfinite(r))
+      return constant(r);
+  }
+  if (kind(argument) == Kind::Call) {
+    const Expression::Func inner = nodes_[argument].func;
+    if (func == Expression::Func::Log && inner == Expression::Func::Exp)
+      return operands(argument)[0];
+    if (func == inner && (func == Expression::Func::Abs ||
+                          func == Expression::Func::Floor ||
+                          func == Expression::Func::Ceil))
+      return argument;
+  }
+  return intern(Kind::Call, func, 0.0L, 0, &argument, 1);
+}
+
+std::vector<NodeId> Graph::reachable(const std::vector<NodeId> &roots) const {
+  std::vector<char> seen(nodes_.size(), 0);
+  std::vector<NodeId> order, stack(roots);
+  while (!stack.empty()) {
+    const NodeId id = stack.back();
+    stack.pop_back();
+    if (seen[id])
+      continue;
+    seen[id] = 1;
+    order.push_back(id);
+    if (nodes_[id].kind != Kind::Var)
+      stack.insert(stack.end(), operands(id), operands(id) + nodes_[id].count);
+  }
+  std::sort(order.begin(), order.end());
+  return order;
+}
+
+/**
+ * @brief Forward sweep in id order: each node's derivative is built from its
+ *        operands' derivatives, already known, so every shared node is
+ *        differentiated once.
+ */
+NodeId Graph::derivative(NodeId f, std::size_t variable) {
+  const std::vector<NodeId> order = reachable({f});
+  std::vector<NodeId> d(nodes_.size(), zero_);
+  for (NodeId id : order) {
+    const Node node = nodes_[id];
+    std::vector<NodeId> ops;
+    if (node.kind != Kind::Var) // copied: operands_ grows below
+      ops.assign(operands(id), operands(id) + node.count);
+    switch (node.kind) {
+    case Kind::Const:
+      break;
+    case Kind::Var:
+      d[id] = node.first == variable ? one_ : zero_;
+      break;
+    case Kind::Add: {
+      std::vector<NodeId> terms;
+      for (NodeId op : ops)
+        if (d[op] != zero_)
+          terms.push_back(d[op]);
+      d[id] = sum(terms);
+      break;
+    }
+    case Kind::Mul: { // product rule
+      std::vector<NodeId> terms;
+      for (std::size_t i = 0; i < ops.size(); ++i) {
+        if (d[ops[i]] == zero_)
+          continue;
+        std::vector<NodeId> factors(ops);
+        factors[i] = d[ops[i]];
+        terms.push_back(product(factors));
+      }
+      d[id] = sum(terms);
+      break;
+    }
+    case Kind::Pow: {
+      const NodeId b = ops[0], e = ops[1], db = d[b], de = d[e];
+      if (de == zero_) { // e b^(e-1) b'
+        if (db != zero_)
+          d[id] = product({e, pow(b, sum({e, minusOne_})), db});
+      } else { // b^e (e' ln b + e b' / b)
+        d[id] = product(
+            {id, sum({product({de, call(Expression::Func::Log, b)}),
+                      product({e, db, pow(b, minusOne_)})})});
+      }
+      break;
+    }
+    case Kind::Call: {
+      const NodeId a = ops[0], da = d[a];
+      if (da == zero_)
+        break;
+      NodeId outer = zero_; // g'(a)
+      switch (node.func) {
+      case Expression::Func::Sqrt:
+        outer = product({constant(0.5L), pow(id, minusOne_)});
+        break;
+      case Expression::Func::Abs:
+        outer = product({a, pow(id, minusOne_)});
+        break;
+      case Expression::Func::Exp:
+        outer = id;
+        break;
+      case Expression::Func::Log:
+        outer = pow(a, minusOne_);
+        break;
+      case Expression::Func::Log10:
+        outer = product({constant(1.0L / std::log(10.0L)), pow(a, minusOne_)});
+        break;
+      case Expression::Func::Sin:
+        outer = call(Expression::Func::Cos, a);
+        break;
+      case Expression::Func::Cos:
+        outer = neg(call(Expression::Func::Sin, a));
+        break;
+      case Expression::Func::Tan:
+        outer = pow(call(Expression::Func::Cos, a), constant(-2.0L));
+        break;
+      case Expression::Func::Asin:
+      case Expression::Func::Acos:
+        outer = pow(sub(one_, pow(a, constant(2.0L))), constant(-0.5L));
+        if (node.func == Expression::Func::Acos)
+          outer = neg(outer);
+        break;
+      case Expression::Func::Atan:
+        outer = pow(add(one_, pow(a, constant(2.0L))), minusOne_);
+        break;
+      case Expression::Func::Floor:
+      case Expression::Func::Ceil:
+        break; // zero almost everywhere
+      }
+      d[id] = mul(outer, da);
+      break;
+    }
+    }
+  }
+  return d[f];
+}
+
+long double Graph::evaluate(NodeId root, const long double *vars) const {
+  return evaluate(std::vector<NodeId>{root}, vars)[0];
+}
+
+std::vector<long double> Graph::evaluate(const std::vector<NodeId> &roots,
+                                         const long double *vars) const {
+  std::vector<long double> value(nodes_.size());
+  for (NodeId id : reachable(roots)) {
+    const Node &node = nodes_[id];
+    const NodeId *ops = operands(id);
+    switch (node.kind) {
+    case Kind::Const:
+      value[id] = node.value;
+      break;
+    case Kind::Var:
+      value[id] = vars[node.first];
+      break;
+    case Kind::Add:
+    case Kind::Mul: {
+      const Engine::Op op =
+          node.kind == Kind::Add ? Engine::Op::Add : Engine::Op::Mul;
+      long double acc = value[ops[0]];
+      for (std::uint32_t i = 1; i < node.count; ++i)
+        acc = engineOp(op, acc, value[ops[i]]);
+      value[id] = acc;
+      break;
+    }
+    case Kind::Pow:
+      value[id] = engineOp(Engine::Op::Pow, value[ops[0]], value[ops[1]]);
+      break;
+    case Kind::Call:
+      value[id] = Expression::apply(node.func, value[ops[0]]);
+      break;
+    }
+  }
+  std::vector<long double> out;
+  out.reserve(roots.size());
+  for (NodeId root : roots)
+    out.push_back(value[root]);
+  return out;
+}
+
+/**
+ * @brief Bottom-up printing. Negative coefficients become " - " inside sums
+ *        and negative constant exponents become a denominator.
+ */
+std::optional<std::string> Graph::toString(NodeId root,
+                                           std::size_t maxLength) const {
+  std::vector<Text> memo(nodes_.size());
+
+  // coefficient * factors, with b^-k factors moved below a '/'.
+  auto productText = [&](long double coefficient, const NodeId *factors,
+                         std::size_t count) {
+    std::vector<std::string> above, below;
+    if (std::fabs(coefficient) != 1.0L)
+      above.push_back(constantText(std::fabs(coefficient)));
+    for (std::size_t i = 0; i < count; ++i) {
+      const NodeId f = factors[i];
+      const auto e =
+          kind(f) == Kind::Pow ? constantValue(operands(f)[1]) : std::nullopt;
+      if (e && *e < 0.0L) {
+        const std::string base = wrap(memo[operands(f)[0]], kAtom);
+        below.push_back(*e == -1.0L ? base
+                                    : base + "^" + constantText(-*e));
+      } else {
+        above.push_back(wrap(memo[f], kProduct + 1));
+      }
+    }
+    auto join = [](const std::vector<std::string> &parts) {
+      std::string s;
+      for (const std::string &p : parts)
+        s += (s.empty() ? "" : "*") + p;
+      return s;
+    };
+    Text t{coefficient < 0.0L ? "-" : "", kProduct};
+    t.text += above.empty() ? "1" : join(above);
+    if (below.size() == 1)
+      t.text += "/" + below[0];
+    else if (!below.empty())
+      t.text += "/(" + join(below) + ")";
+    return t;
+  };
+
+  for (NodeId id : reachable({root})) {
+    const Node &node = nodes_[id];
+    const NodeId *ops = operands(id);
+    Text &t = memo[id];
+    switch (node.kind) {
+    case Kind::Const:
+      t = {constantText(node.value), node.value < 0.0L ? kProduct : kAtom};
+      break;
+    case Kind::Var:
+      t = {variables_[node.first], kAtom};
+      break;
+    case Kind::Add:
+      t.precedence = kSum;
+      for (std::uint32_t i = 0; i < node.count; ++i) {
+        const NodeId term = ops[i];
+        long double c = 1.0L;
+        Text part = memo[term];
+        if (const auto v = constantValue(term)) {
+          c = *v;
+          part.text = constantText(std::fabs(*v));
+        } else if (kind(term) == Kind::Mul) {
+          if (const auto v = constantValue(operands(term)[0]); v && *v < 0) {
+            c = *v;
+            part = productText(-c, operands(term) + 1, nodes_[term].count - 1);
+          }
+        }
+        if (i == 0)
+          t.text = (c < 0.0L ? "-" : "") + part.text;
+        else
+          t.text += (c < 0.0L ? " - " : " + ") + part.text;
+      }
+      break;
+    case Kind::Mul: {
+      const auto c = constantValue(ops[0]);
+      t = c ? productText(*c, ops + 1, node.count - 1)
+            : productText(1.0L, ops, node.count);
+      break;
+    }
+    case Kind::Pow: {
+      const auto e = constantValue(ops[1]);
+      if (e && *e < 0.0L)
+        t = productText(1.0L, &id, 1);
+      else
+        t = {wrap(memo[ops[0]], kAtom) + "^" + wrap(memo[ops[1]], kPower),
+             kPower};
+      break;
+    }
+    case Kind::Call:
+      t = {std::string(Expression::name(node.func)) + "(" + memo[ops[0]].text +
+               ")",
+           kAtom};
+      break;
+    }
+    if (t.text.size() > maxLength)
+      return std::nullopt;
+  }
+  return memo[root].text;
+}
+
+std::size_t Graph::dagSize(NodeId root) const {
+  return reachable({root}).size();
+}
+
+double Graph::treeSize(NodeId root) const {
+  std::vector<double> size(nodes_.size(), 0.0);
+  for (NodeId id : reachable({root})) {
+    size[id] = 1.0;
+    for (std::uint32_t i = 0; i < nodes_[id].count; ++i)
+      size[id] += size[operands(id)[i]];
+  }
+  return size[root];
+}
+
+std::optional<NodeId> Graph::parse(const std::string &text,
+                                   std::string *error) {
+  const auto expr = Expression::compile(text, variables_, error);
+  if (!expr)
+    return std::nullopt;
+  std::vector<NodeId> stack;
+  for (const Expression::Instr &in : expr->program()) {
+    switch (in.kind) {
+    case Expression::Kind::Const:
+      stack.push_back(constant(in.value));
+      break;
+    case Expression::Kind::Var:
+      stack.push_back(variable(in.index));
+      break;
+    case Expression::Kind::Binary: {
+      const NodeId b = stack.back();
+      stack.pop_back();
+      const NodeId a = stack.back();
+      switch (in.op) {
+      case Engine::Op::Add:
+        stack.back() = add(a, b);
+        break;
+      case Engine::Op::Sub:
+        stack.back() = sub(a, b);
+        break;
+      case Engine::Op::Mul:
+        stack.back() = mul(a, b);
+        break;
+      case Engine::Op::Div:
+        stack.back() = div(a, b);
+        break;
+      default:
+        if (error)
+          *error = "unsupported operator";
+        return std::nullopt;
+      }
+      break;
+    }
+    case Expression::Kind::Pow: {
+      const NodeId b = stack.back();
+      stack.pop_back();
+      stack.back() = pow(stack.back(), b);
+      break;
+    }
+    case Expression::Kind::Neg:
+      stack.back() = neg(stack.back());
+      break;
+    case Expression::Kind::Call:
+      stack.back() = call(in.func, stack.back());
+      break;
+    }
+  }
+  if (stack.empty())
+    return std::nullopt;
+  return stack.back();
+}
+
+} // namespace symbolic
@@ -0,0 +1,156 @@
+#pragma once
+#include "expression.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @file symbolic.h
+ * @brief Symbolic simplification and differentiation on a hash-consed DAG.
+ *
+ * Every node of a Graph is interned: building a node that already exists
+ * returns the existing id, so a common subexpression is stored once however
+ * many times it appears, and equal expressions have equal ids. Nodes are
+ * created children first, which makes ids a topological order; derivative(),
+ * evaluation and printing are single ascending sweeps over the nodes
+ * reachable from a root, each node visited once. Differentiating a DAG
+ * therefore costs time and memory proportional to its size rather than to
+ * the size of the expanded tree.
+ *
+ * The constructors simplify as they build, so every node is in a canonical
+ * form:
+ * - sums and products are flattened, their operands sorted, constants
+ *   folded and like terms / like bases collected (x + 2x -> 3x,
+ *   x * x^2 -> x^3);
+ * - a - b, -a and a / b become a + (-1) b, (-1) a and a b^-1;
+ * - a constant times a sum is distributed (2 (x + 1) -> 2x + 2);
+ * - x^0, x^1, 1^x, e^x -> exp(x), (x^m)^n and (a b)^n (integers m, n) and
+ *   calls on constants fold.
+ *
+ * Numeric evaluation runs the arithmetic through Engine::apply and the
+ * functions through Expression::apply, so values follow the keypad's rules
+ * (NaN for a division by zero or an undefined real power).
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace symbolic {
+
+/// Index of a node in its Graph.
+using NodeId = std::uint32_t;
+
+/**
+ * @brief Interned expression DAG over a fixed list of variables.
+ *
+ * Nodes are never removed; intermediate results stay interned and are
+ * reused by later operations on the same graph.
+ */
+class Graph {
+public:
+  /// Node kinds after canonicalization.
+  enum class Kind : std::uint8_t { Const, Var, Add, Mul, Pow, Call };
+
+  /** @brief Graph over @p variables (names accepted by parse()). */
+  explicit Graph(std::vector<std::string> variables = {"x"});
+
+  /**
+   * @brief Build the DAG of an expression (grammar of Expression::compile).
+   * @param error Optional output for a human-readable parse error.
+   * @return Root node, or std::nullopt on a syntax error.
+   */
+  std::optional<NodeId> parse(const std::string &text,
+                              std::string *error = nullptr);
+
+  /** @name Simplifying constructors */
+  ///@{
+  NodeId constant(long double value);
+  NodeId variable(std::size_t index);
+  NodeId add(NodeId a, NodeId b);
+  NodeId sub(NodeId a, NodeId b);
+  NodeId mul(NodeId a, NodeId b);
+  NodeId div(NodeId a, NodeId b);
+  NodeId neg(NodeId a);
+  NodeId pow(NodeId base, NodeId exponent);
+  NodeId call(Expression::Func func, NodeId argument);
+  ///@}
+
+  /**
+   * @brief Simplified derivative of @p f with respect to a variable.
+   * @param variable Index into the graph's variable list.
+   */
+  NodeId derivative(NodeId f, std::size_t variable);
+
+  /**
+   * @brief Evaluate one root.
+   * @param vars One value per variable.
+   * @return The value; NaN where an operation is undefined.
+   */
+  long double evaluate(NodeId root, const long double *vars) const;
+
+  /**
+   * @brief Evaluate several roots at once; subexpressions they share are
+   *        computed once.
+   */
+  std::vector<long double> evaluate(const std::vector<NodeId> &roots,
+                                    const long double *vars) const;
+
+  /**
+   * @brief Infix text (accepted by parse() and Expression::compile).
+   * @param maxLength Longest text produced; shared nodes are written out
+   *        in full, so a small DAG can expand to a very long text.
+   * @return Text, or std::nullopt if it would exceed @p maxLength.
+   */
+  std::optional<std::string> toString(NodeId root,
+                                      std::size_t maxLength = 4096) const;
+
+  /** @brief Nodes reachable from @p root. */
+  std::size_t dagSize(NodeId root) const;
+  /** @brief Nodes of the equivalent tree (shared nodes counted per use). */
+  double treeSize(NodeId root) const;
+  /** @brief Nodes interned so far. */
+  std::size_t nodeCount() const { return nodes_.size(); }
+
+  /** @brief Kind of a node. */
+  Kind kind(NodeId id) const { return nodes_[id].kind; }
+  /** @brief Value of a constant node, else std::nullopt. */
+  std::optional<long double> constantValue(NodeId id) const;
+  /** @brief Variable names, in column order. */
+  const std::vector<std::string> &variables() const { return variables_; }
+
+private:
+  struct Node {
+    Kind kind;
+    Expression::Func func = Expression::Func::Sqrt; ///< For Kind::Call.
+    std::uint32_t first = 0;  ///< Operand offset; variable index for Var.
+    std::uint32_t count = 0;  ///< Operand count.
+    long double value = 0.0L; ///< For Kind::Const.
+    std::size_t hash = 0;
+  };
+
+  /// Canonical node (operands already simplified and ordered) -> id.
+  NodeId intern(Kind kind, Expression::Func func, long double value,
+                std::uint32_t index, const NodeId *operands,
+                std::size_t count);
+  bool sameNode(const Node &node, Kind kind, Expression::Func func,
+                long double value, std::uint32_t index,
+                const NodeId *operands, std::size_t count) const;
+  void growTable();
+
+  NodeId sum(const std::vector<NodeId> &terms);
+  NodeId product(const std::vector<NodeId> &factors);
+  const NodeId *operands(NodeId id) const {
+    return operands_.data() + nodes_[id].first;
+  }
+  /// Ids reachable from @p roots, ascending (children before parents).
+  std::vector<NodeId> reachable(const std::vector<NodeId> &roots) const;
+
+  std::vector<std::string> variables_;
+  std::vector<Node> nodes_;
+  std::vector<NodeId> operands_; ///< Operand lists of all nodes.
+  std::vector<NodeId> table_;    ///< Open-addressing hash of node ids.
+  NodeId zero_ = 0, one_ = 0, minusOne_ = 0;
+};
+
+} // namespace symbolic
@@ -0,0 +1,493 @@
+/**
+ * @file units.cpp
+ * @brief Compile-time unit tables, perfect-hash lookup and conversions.
+ *
+ * kTable is found by the compiler: it tries hash seeds until every unit name
+ * lands in its own slot of a 4096-entry array (about 4% load, so a few dozen
+ * seeds are enough), and a static_assert guards the result. Prefixes are not
+ * in the table; a miss retries the lookup with a known prefix stripped.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+
+#include "units.h"
+#include <iterator>
+#include <limits>
+
+namespace units {
+namespace {
+
+/// Dimension from base exponents (length, mass, time, current, temperature,
+/// amount, luminous intensity, information).
+constexpr Dimension dim(int l, int m = 0, int t = 0, int i = 0, int th = 0,
+                        int n = 0, int j = 0, int info = 0) {
+  Dimension d;
+  const int e[kBaseCount] = {l, m, t, i, th, n, j, info};
+  for (std::size_t k = 0; k < kBaseCount; ++k)
+    d.exponents[k] = static_cast<std::int8_t>(e[k]);
+  return d;
+}
+
+/// A temperature scale as an exact ratio to the kelvin:
+/// K = (v + zero / 100) * num / den.
+struct TemperatureScale {
+  std::string_view name;
+  int num;
+  int den;
+  int zero; ///< Absolute zero offset in hundredths of a degree.
+};
+
+constexpr TemperatureScale kTemperatureScales[] = {
+    {"K", 1, 1, 0},          {"kelvin", 1, 1, 0},
+    {"degC", 1, 1, 27315},   {"°C", 1, 1, 27315},
+    {"celsius", 1, 1, 27315}, {"degF", 5, 9, 45967},
+    {"°F", 5, 9, 45967},     {"fahrenheit", 5, 9, 45967},
+    {"R", 5, 9, 0},
+};
+
+/// Which prefixes a unit accepts.
+enum Prefixes : std::uint8_t { kNone = 0, kSi = 1, kBinary = 2 };
+
+/// One named unit.
+struct Unit {
+  std::string_view name;
+  double scale;
+  double offset;
+  Dimension dim;
+  std::uint8_t prefixes;
+};
+
+constexpr double kPi = 3.141592653589793238462643383279502884;
+
+constexpr Dimension kLength = dim(1), kMass = dim(0, 1), kTime = dim(0, 0, 1),
+                    kCurrent = dim(0, 0, 0, 1), kTemp = dim(0, 0, 0, 0, 1),
+                    kAmount = dim(0, 0, 0, 0, 0, 1),
+                    kLuminous = dim(0, 0, 0, 0, 0, 0, 1),
+                    kInfo = dim(0, 0, 0, 0, 0, 0, 0, 1), kNoDim = dim(0),
+                    kArea = dim(2), kVolume = dim(3), kSpeed = dim(1, 0, -1),
+                    kFreq = dim(0, 0, -1), kForce = dim(1, 1, -2),
+                    kEnergy = dim(2, 1, -2), kPower = dim(2, 1, -3),
+                    kPressure = dim(-1, 1, -2), kCharge = dim(0, 0, 1, 1),
+                    kVoltage = dim(2, 1, -3, -1),
+                    kResistance = dim(2, 1, -3, -2);
+
+// clang-format off
+constexpr Unit kUnits[] = {
+    // Length
+    {"m", 1.0, 0.0, kLength, kSi},
+    {"meter", 1.0, 0.0, kLength, kNone},
+    {"metre", 1.0, 0.0, kLength, kNone},
+    {"in", 0.0254, 0.0, kLength, kNone},
+    {"inch", 0.0254, 0.0, kLength, kNone},
+    {"ft", 0.3048, 0.0, kLength, kNone},
+    {"foot", 0.3048, 0.0, kLength, kNone},
+    {"feet", 0.3048, 0.0, kLength, kNone},
+    {"yd", 0.9144, 0.0, kLength, kNone},
+    {"mi", 1609.344, 0.0, kLength, kNone},
+    {"mile", 1609.344, 0.0, kLength, kNone},
+    {"nmi", 1852.0, 0.0, kLength, kNone},
+    {"au", 1.495978707e11, 0.0, kLength, kNone},
+    {"ly", 9.4607304725808e15, 0.0, kLength, kNone},
+    {"pc", 3.0856775814913673e16, 0.0, kLength, kSi},
+    {"angstrom", 1e-10, 0.0, kLength, kNone},
+    {"Å", 1e-10, 0.0, kLength, kNone},
+    // Mass
+    {"g", 1e-3, 0.0, kMass, kSi},
+    {"gram", 1e-3, 0.0, kMass, kNone},
+    {"kilogram", 1.0, 0.0, kMass, kNone},
+    {"t", 1000.0, 0.0, kMass, kSi},
+    {"tonne", 1000.0, 0.0, kMass, kNone},
+    {"lb", 0.45359237, 0.0, kMass, kNone},
+    {"pound", 0.45359237, 0.0, kMass, kNone},
+    {"oz", 0.028349523125, 0.0, kMass, kNone},
+    {"ounce", 0.028349523125, 0.0, kMass, kNone},
+    {"st", 6.35029318, 0.0, kMass, kNone},
+    {"Da", 1.66053906660e-27, 0.0, kMass, kSi},
+    // Time
+    {"s", 1.0, 0.0, kTime, kSi},
+    {"sec", 1.0, 0.0, kTime, kNone},
+    {"second", 1.0, 0.0, kTime, kNone},
+    {"min", 60.0, 0.0, kTime, kNone},
+    {"minute", 60.0, 0.0, kTime, kNone},
+    {"h", 3600.0, 0.0, kTime, kNone},
+    {"hr", 3600.0, 0.0, kTime, kNone},
+    {"hour", 3600.0, 0.0, kTime, kNone},
+    {"d", 86400.0, 0.0, kTime, kNone},
+    {"day", 86400.0, 0.0, kTime, kNone},
+    {"wk", 604800.0, 0.0, kTime, kNone},
+    {"week", 604800.0, 0.0, kTime, kNone},
+    {"yr", 31557600.0, 0.0, kTime, kSi}, // Julian year
+    {"year", 31557600.0, 0.0, kTime, kNone},
+    // Other SI base units
+    {"A", 1.0, 0.0, kCurrent, kSi},
+    {"ampere", 1.0, 0.0, kCurrent, kNone},
+    {"K", 1.0, 0.0, kTemp, kSi},
+    {"kelvin", 1.0, 0.0, kTemp, kNone},
+    {"degC", 1.0, 273.15, kTemp, kNone},
+    {"°C", 1.0, 273.15, kTemp, kNone},
+    {"celsius", 1.0, 273.15, kTemp, kNone},
+    {"degF", 5.0 / 9.0, 273.15 - 32.0 * 5.0 / 9.0, kTemp, kNone},
+    {"°F", 5.0 / 9.0, 273.15 - 32.0 * 5.0 / 9.0, kTemp, kNone},
+    {"fahrenheit", 5.0 / 9.0, 273.15 - 32.0 * 5.0 / 9.0, kTemp, kNone},
+    {"R", 5.0 / 9.0, 0.0, kTemp, kNone}, // Rankine
+    {"mol", 1.0, 0.0, kAmount, kSi},
+    {"cd", 1.0, 0.0, kLuminous, kSi},
+    // Area and volume
+    {"ha", 1e4, 0.0, kArea, kNone},
+    {"acre", 4046.8564224, 0.0, kArea, kNone},
+    {"L", 1e-3, 0.0, kVolume, kSi},
+    {"l", 1e-3, 0.0, kVolume, kSi},
+    {"liter", 1e-3, 0.0, kVolume, kNone},
+    {"litre", 1e-3, 0.0, kVolume, kNone},
+    {"gal", 3.785411784e-3, 0.0, kVolume, kNone},
+    {"gallon", 3.785411784e-3, 0.0, kVolume, kNone},
+    {"qt", 9.46352946e-4, 0.0, kVolume, kNone},
+    {"pt", 4.73176473e-4, 0.0, kVolume, kNone},
+    {"cup", 2.365882365e-4, 0.0, kVolume, kNone},
+    {"floz", 2.95735295625e-5, 0.0, kVolume, kNone},
+    {"tbsp", 1.478676478125e-5, 0.0, kVolume, kNone},
+    {"tsp", 4.92892159375e-6, 0.0, kVolume, kNone},
+    // Speed
+    {"mph", 0.44704, 0.0, kSpeed, kNone},
+    {"kn", 1852.0 / 3600.0, 0.0, kSpeed, kNone},
+    {"knot", 1852.0 / 3600.0, 0.0, kSpeed, kNone},
+    {"kph", 1.0 / 3.6, 0.0, kSpeed, kNone},
+    // Frequency, force, energy, power, pressure
+    {"Hz", 1.0, 0.0, kFreq, kSi},
+    {"rpm", 1.0 / 60.0, 0.0, kFreq, kNone},
+    {"N", 1.0, 0.0, kForce, kSi},
+    {"newton", 1.0, 0.0, kForce, kNone},
+    {"dyn", 1e-5, 0.0, kForce, kNone},
+    {"lbf", 4.4482216152605, 0.0, kForce, kNone},
+    {"J", 1.0, 0.0, kEnergy, kSi},
+    {"joule", 1.0, 0.0, kEnergy, kNone},
+    {"cal", 4.184, 0.0, kEnergy, kSi},
+    {"Cal", 4184.0, 0.0, kEnergy, kNone}, // food calorie
+    {"eV", 1.602176634e-19, 0.0, kEnergy, kSi},
+    {"Wh", 3600.0, 0.0, kEnergy, kSi},
+    {"BTU", 1055.05585262, 0.0, kEnergy, kNone},
+    {"erg", 1e-7, 0.0, kEnergy, kNone},
+    {"W", 1.0, 0.0, kPower, kSi},
+    {"watt", 1.0, 0.0, kPower, kNone},
+    {"hp", 745.69987158227022, 0.0, kPower, kNone},
+    {"Pa", 1.0, 0.0, kPressure, kSi},
+    {"pascal", 1.0, 0.0, kPressure, kNone},
+    {"bar", 1e5, 0.0, kPressure, kSi},
+    {"atm", 101325.0, 0.0, kPressure, kNone},
+    {"psi", 6894.757293168361, 0.0, kPressure, kNone},
+    {"mmHg", 133.322387415, 0.0, kPressure, kNone},
+    {"Torr", 101325.0 / 760.0, 0.0, kPressure, kNone},
+    // Electromagnetism
+    {"C", 1.0, 0.0, kCharge, kSi},
+    {"coulomb", 1.0, 0.0, kCharge, kNone},
+    {"Ah", 3600.0, 0.0, kCharge, kSi},
+    {"V", 1.0, 0.0, kVoltage, kSi},
+    {"volt", 1.0, 0.0, kVoltage, kNone},
+    {"ohm", 1.0, 0.0, kResistance, kSi},
+    {"Ω", 1.0, 0.0, kResistance, kSi},
+    // Angles (dimensionless in SI)
+    {"rad", 1.0, 0.0, kNoDim, kSi},
+    {"deg", kPi / 180.0, 0.0, kNoDim, kNone},
+    {"°", kPi / 180.0, 0.0, kNoDim, kNone},
+    {"grad", kPi / 200.0, 0.0, kNoDim, kNone},
+    {"arcmin", kPi / 10800.0, 0.0, kNoDim, kNone},
+    {"arcsec", kPi / 648000.0, 0.0, kNoDim, kNone},
+    {"rev", 2.0 * kPi, 0.0, kNoDim, kNone},
+    {"%", 0.01, 0.0, kNoDim, kNone},
+    // Information
+    {"bit", 1.0, 0.0, kInfo, kSi | kBinary},
+    {"b", 1.0, 0.0, kInfo, kSi | kBinary},
+    {"B", 8.0, 0.0, kInfo, kSi | kBinary},
+    {"byte", 8.0, 0.0, kInfo, kNone},
+};
+// clang-format on
+
+constexpr std::size_t kUnitCount = std::size(kUnits);
+static_assert(kUnitCount < 255, "slot indices are stored in a byte");
+
+/// One prefix and its factor.
+struct Prefix {
+  std::string_view text;
+  double factor;
+  std::uint8_t kind; ///< kSi or kBinary.
+};
+
+// Two-letter prefixes first so "da" wins over "d".
+constexpr Prefix kPrefixes[] = {
+    {"da", 1e1, kSi},           {"Ki", 1024.0, kBinary},
+    {"Mi", 1048576.0, kBinary}, {"Gi", 1073741824.0, kBinary},
+    {"Ti", 1099511627776.0, kBinary},
+    {"Pi", 1125899906842624.0, kBinary},
+    {"µ", 1e-6, kSi},           {"μ", 1e-6, kSi}, // micro sign, Greek mu
+    {"Y", 1e24, kSi},           {"Z", 1e21, kSi},
+    {"E", 1e18, kSi},           {"P", 1e15, kSi},
+    {"T", 1e12, kSi},           {"G", 1e9, kSi},
+    {"M", 1e6, kSi},            {"k", 1e3, kSi},
+    {"h", 1e2, kSi},            {"d", 1e-1, kSi},
+    {"c", 1e-2, kSi},           {"m", 1e-3, kSi},
+    {"u", 1e-6, kSi},           {"n", 1e-9, kSi},
+    {"p", 1e-12, kSi},          {"f", 1e-15, kSi},
+    {"a", 1e-18, kSi},          {"z", 1e-21, kSi},
+    {"y", 1e-24, kSi},
+};
+
+/// Seeded FNV-1a with a final avalanche.
+constexpr std::uint32_t hash(std::string_view s, std::uint32_t seed) {
+  std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+  for (const char c : s) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 16777619u;
+  }
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 12;
+  return h;
+}
+
+constexpr std::size_t kSlots = 4096; // power of two
+
+/// Perfect hash: kUnits[slots[hash(name, seed) & (kSlots-1)] - 1].
+struct Table {
+  std::uint32_t seed = 0;
+  std::array<std::uint8_t, kSlots> slots{};
+};
+
+/// Find the first seed without collisions (evaluated by the compiler).
+constexpr Table buildTable() {
+  for (std::uint32_t seed = 1; seed < 4096; ++seed) {
+    Table t;
+    t.seed = seed;
+    bool ok = true;
+    for (std::size_t i = 0; i < kUnitCount && ok; ++i) {
+      auto &slot = t.slots[hash(kUnits[i].name, seed) & (kSlots - 1)];
+      ok = slot == 0;
+      slot = static_cast<std::uint8_t>(i + 1);
+    }
+    if (ok)
+      return t;
+  }
+  return Table{};
+}
+
+constexpr Table kTable = buildTable();
+static_assert(kTable.seed != 0, "no collision-free seed; grow kSlots");
+
+/// Exact-name lookup.
+const Unit *find(std::string_view name) noexcept {
+  const std::uint8_t index = kTable.slots[hash(name, kTable.seed) & (kSlots - 1)];
+  if (index == 0 || kUnits[index - 1].name != name)
+    return nullptr;
+  return &kUnits[index - 1];
+}
+
+/// Lookup with an optional prefix; @p factor receives the prefix factor.
+const Unit *findPrefixed(std::string_view name, double &factor) noexcept {
+  factor = 1.0;
+  if (const Unit *u = find(name))
+    return u;
+  for (const Prefix &p : kPrefixes) {
+    if (name.size() <= p.text.size() || name.substr(0, p.text.size()) != p.text)
+      continue;
+    const Unit *u = find(name.substr(p.text.size()));
+    if (u && (u->prefixes & p.kind)) {
+      factor = p.factor;
+      return u;
+    }
+  }
+  return nullptr;
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/// Whether @p c ends a unit name inside a compound.
+bool isSeparator(char c) {
+  return c == '*' || c == '.' || c == '/' || c == '^' || c == ' ' ||
+         c == '-' || isDigit(c);
+}
+
+/// The temperature scale named exactly @p text (surrounding spaces allowed).
+const TemperatureScale *findTemperature(std::string_view text) noexcept {
+  while (!text.empty() && text.front() == ' ')
+    text.remove_prefix(1);
+  while (!text.empty() && text.back() == ' ')
+    text.remove_suffix(1);
+  for (const TemperatureScale &t : kTemperatureScales)
+    if (t.name == text)
+      return &t;
+  return nullptr;
+}
+
+/// @p base raised to a small integer power.
+double power(double base, int e) {
+  double r = 1.0;
+  for (int i = 0; i < (e < 0 ? -e : e); ++i)
+    r *= base;
+  return e < 0 ? 1.0 / r : r;
+}
+
+} // namespace
+
+/**
+ * @brief Parse factors "name[^][-]digits" joined by '*', '.', ' ' or '/'.
+ * @param text Unit string.
+ * @return Parsed unit or std::nullopt.
+ */
+std::optional<Quantity> parse(std::string_view text) noexcept {
+  Quantity q;
+  std::size_t i = 0;
+  int factors = 0;
+  bool divide = false;
+  bool offsetUnit = false;
+  auto skipSpaces = [&] {
+    while (i < text.size() && text[i] == ' ')
+      ++i;
+  };
+  skipSpaces();
+  // "1/s" style reciprocal.
+  if (i < text.size() && text[i] == '1') {
+    std::size_t j = i + 1;
+    while (j < text.size() && text[j] == ' ')
+      ++j;
+    if (j == text.size() || text[j] != '/')
+      return std::nullopt;
+    i = j + 1;
+    divide = true;
+  }
+  while (true) {
+    skipSpaces();
+    const std::size_t begin = i;
+    while (i < text.size() && !isSeparator(text[i]))
+      ++i;
+    if (i == begin)
+      return std::nullopt;
+    double prefix = 1.0;
+    const Unit *u = findPrefixed(text.substr(begin, i - begin), prefix);
+    if (!u)
+      return std::nullopt;
+
+    // Optional exponent: "^-2", "^2", "2", "-1".
+    int exponent = 1;
+    if (i < text.size() && (text[i] == '^' || text[i] == '-' || isDigit(text[i]))) {
+      if (text[i] == '^')
+        ++i;
+      const bool negative = i < text.size() && text[i] == '-';
+      if (negative)
+        ++i;
+      if (i == text.size() || !isDigit(text[i]))
+        return std::nullopt;
+      exponent = 0;
+      for (; i < text.size() && isDigit(text[i]); ++i) {
+        exponent = exponent * 10 + (text[i] - '0');
+        if (exponent > 64)
+          return std::nullopt;
+      }
+      if (negative)
+        exponent = -exponent;
+    }
+    if (divide)
+      exponent = -exponent;
+
+    if (u->offset != 0.0)
+      offsetUnit = true;
+    q.scale *= power(u->scale * prefix, exponent);
+    for (std::size_t k = 0; k < kBaseCount; ++k) {
+      const int e = q.dim.exponents[k] + u->dim.exponents[k] * exponent;
+      if (e < std::numeric_limits<std::int8_t>::min() ||
+          e > std::numeric_limits<std::int8_t>::max())
+        return std::nullopt;
+      q.dim.exponents[k] = static_cast<std::int8_t>(e);
+    }
+    ++factors;
+    if (factors == 1 && exponent == 1)
+      q.offset = u->offset;
+
+    const std::size_t end = i;
+    skipSpaces();
+    if (i == text.size())
+      break;
+    if (text[i] == '/')
+      divide = true;
+    else if (text[i] != '*' && text[i] != '.') {
+      if (i == end)
+        return std::nullopt;
+      continue; // "kg m": factors joined by spaces
+    }
+    ++i;
+  }
+  // Absolute temperatures only make sense on their own.
+  if (offsetUnit && (factors != 1 || q.offset == 0.0))
+    return std::nullopt;
+  return q;
+}
+
+/**
+ * @brief Conversion between two units of the same dimension.
+ * @return Affine map or std::nullopt.
+ */
+std::optional<Conversion> conversion(std::string_view from,
+                                     std::string_view to) noexcept {
+  const TemperatureScale *s = findTemperature(from);
+  const TemperatureScale *t = findTemperature(to);
+  if (s && t) {
+    // (x + zs/100) ns/ds = (y + zt/100) nt/dt, all in integers so the only
+    // rounding is in apply().
+    Conversion c;
+    c.scale = 100.0 * s->num * t->den;
+    c.offset = static_cast<double>(s->zero) * s->num * t->den -
+               static_cast<double>(t->zero) * s->den * t->num;
+    c.divisor = 100.0 * s->den * t->num;
+    return c;
+  }
+  const auto a = parse(from);
+  const auto b = parse(to);
+  if (!a || !b || a->dim != b->dim)
+    return std::nullopt;
+  // SI = x * a.scale + a.offset = y * b.scale + b.offset
+  Conversion c;
+  c.scale = a->scale / b->scale;
+  c.offset = (a->offset - b->offset) / b->scale;
+  return c;
+}
+
+/**
+ * @brief Convert one value.
+ * @return Converted value or std::nullopt.
+ */
+std::optional<double> convert(double value, std::string_view from,
+                              std::string_view to) noexcept {
+  const auto c = conversion(from, to);
+  if (!c)
+    return std::nullopt;
+  return c->apply(value);
+}
+
+/**
+ * @brief Convert an array with a single resolved conversion.
+ * @return false if the units are invalid or incompatible.
+ */
+bool convert(const double *in, double *out, std::size_t n,
+             std::string_view from, std::string_view to) noexcept {
+  const auto c = conversion(from, to);
+  if (!c)
+    return false;
+  const double scale = c->scale, offset = c->offset, divisor = c->divisor;
+  if (divisor == 1.0) {
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = in[i] * scale + offset;
+  } else {
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = (in[i] * scale + offset) / divisor;
+  }
+  return true;
+}
+
+/** @brief Number of unit names. */
+std::size_t unitCount() noexcept { return kUnitCount; }
+
+/** @brief Unit name by index. */
+std::string_view unitName(std::size_t i) noexcept {
+  return i < kUnitCount ? kUnits[i].name : std::string_view();
+}
+
+} // namespace units
@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/**
+ * @file units.h
+ * @brief Physical unit parsing and conversion.
+ *
+ * Unit definitions (scale to SI, offset for temperatures, dimension
+ * exponents) live in a constexpr table in units.cpp together with a perfect
+ * hash of their names that the compiler builds, so a lookup is one hash, one
+ * probe and one comparison, with no table built at startup.
+ *
+ * Unit strings may carry SI prefixes ("km", "µs", "MWh"), binary prefixes on
+ * data units ("KiB", "Gibit") and be compound: factors joined by '*', '.',
+ * spaces or '/', each with an optional exponent ("m/s^2", "kg*m2/s2",
+ * "kg m", "1/s"). Every factor after the first '/' is in the denominator
+ * ("J/kg*K"). Dimension exponents must stay within int8 range. Parsing works
+ * on the std::string_view in place and never allocates.
+ *
+ * Temperatures with an offset (degC, degF) convert as absolute values and
+ * are only accepted on their own (not in compounds or with exponents).
+ * Between two temperature scales the map is built from exact ratios and
+ * zero points in hundredths of a degree, so 100 degC is exactly 212 degF.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace units {
+
+/// Base dimensions: length, mass, time, current, temperature, amount,
+/// luminous intensity, information.
+constexpr std::size_t kBaseCount = 8;
+
+/** @brief Exponents of the base dimensions. */
+struct Dimension {
+  std::array<std::int8_t, kBaseCount> exponents{}; ///< One per base.
+
+  friend constexpr bool operator==(const Dimension &a, const Dimension &b) {
+    for (std::size_t i = 0; i < kBaseCount; ++i)
+      if (a.exponents[i] != b.exponents[i])
+        return false;
+    return true;
+  }
+  friend constexpr bool operator!=(const Dimension &a, const Dimension &b) {
+    return !(a == b);
+  }
+};
+
+/** @brief A parsed unit: SI value = value * scale + offset. */
+struct Quantity {
+  double scale = 1.0;  ///< Factor to the coherent SI unit.
+  double offset = 0.0; ///< Added after scaling (temperatures only).
+  Dimension dim;       ///< Dimension exponents.
+};
+
+/**
+ * @brief Affine map between two compatible units:
+ *        to = (from * scale + offset) / divisor.
+ */
+struct Conversion {
+  double scale = 1.0;   ///< Multiplicative part.
+  double offset = 0.0;  ///< Additive part (temperatures only).
+  double divisor = 1.0; ///< Common denominator (temperatures only).
+
+  /** @brief Convert one value. */
+  double apply(double v) const { return (v * scale + offset) / divisor; }
+};
+
+/**
+ * @brief Parse a unit string.
+ * @param text Unit such as "km/h", "kWh", "degF" or "kg*m/s^2".
+ * @return The unit, or std::nullopt if a name is unknown or the syntax is
+ *         invalid.
+ */
+std::optional<Quantity> parse(std::string_view text) noexcept;
+
+/**
+ * @brief Conversion from one unit to another.
+ * @return The affine map, or std::nullopt if a unit is invalid or the
+ *         dimensions differ.
+ */
+std::optional<Conversion> conversion(std::string_view from,
+                                     std::string_view to) noexcept;
+
+/**
+ * @brief Convert a single value.
+ * @return Converted value, or std::nullopt as for conversion().
+ */
+std::optional<double> convert(double value, std::string_view from,
+                              std::string_view to) noexcept;
+
+/**
+ * @brief Convert @p n values; the units are resolved once and the loop
+ *        vectorizes. In-place use (out == in) is allowed.
+ * @return false (leaving @p out untouched) as for conversion().
+ */
+bool convert(const double *in, double *out, std::size_t n,
+             std::string_view from, std::string_view to) noexcept;
+
+/** @brief Number of unit names known (without prefixes). */
+std::size_t unitCount() noexcept;
+/** @brief Name of unit @p i (0 <= i < unitCount()). */
+std::string_view unitName(std::size_t i) noexcept;
+
+} // namespace units
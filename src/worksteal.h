@@ -0,0 +1,133 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @file worksteal.h
+ * @brief Minimal work-stealing task runner for recursive divide-and-conquer.
+ *
+ * Each worker owns a deque: it pushes the tasks it spawns at the back and pops
+ * from the back (depth-first, cache-warm), while idle workers steal from the
+ * front of a victim's deque, where the oldest and usually largest pieces of
+ * work sit. A shared count of unfinished tasks tells workers when the whole
+ * tree is done. The calling thread acts as worker 0, so one thread means no
+ * thread is started at all.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+namespace worksteal {
+
+/// Per-worker deque (one cache line apart from its neighbours).
+template <typename Task> struct alignas(64) Queue {
+  std::mutex mutex;
+  std::deque<Task> tasks;
+};
+
+/**
+ * @brief Handle passed to the task function for spawning child tasks.
+ * @tparam Task Task type.
+ */
+template <typename Task> class Spawner {
+public:
+  Spawner(Queue<Task> &queue, std::atomic<std::size_t> &pending)
+      : queue_(queue), pending_(pending) {}
+
+  /** @brief Queue @p task on the calling worker's deque. */
+  void operator()(Task task) const {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(queue_.mutex);
+    queue_.tasks.push_back(std::move(task));
+  }
+
+private:
+  Queue<Task> &queue_;
+  std::atomic<std::size_t> &pending_;
+};
+
+/**
+ * @brief Resolve a requested thread count.
+ * @param threads Requested count; 0 = all cores.
+ * @return At least 1.
+ */
+inline unsigned workerCount(unsigned threads) {
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  return std::max(1u, threads);
+}
+
+/**
+ * @brief Run @p initial and every task they spawn to completion.
+ *
+ * @param initial Root tasks (dealt round-robin across workers).
+ * @param threads Worker count; 0 = all cores.
+ * @param fn Called as fn(Task &&task, const Spawner<Task> &spawn,
+ *           unsigned worker); @p worker (0 .. threads-1) indexes per-worker
+ *           accumulators so results need no locking.
+ * @return Number of workers used (workerCount(threads)), so the caller can
+ *         size per-worker accumulators up front.
+ */
+template <typename Task, typename Fn>
+unsigned run(std::vector<Task> initial, unsigned threads, Fn &&fn) {
+  const unsigned workers = workerCount(threads);
+  std::vector<std::unique_ptr<Queue<Task>>> queues;
+  queues.reserve(workers);
+  for (unsigned w = 0; w < workers; ++w)
+    queues.push_back(std::make_unique<Queue<Task>>());
+  std::atomic<std::size_t> pending(initial.size());
+  for (std::size_t i = 0; i < initial.size(); ++i)
+    queues[i % workers]->tasks.push_back(std::move(initial[i]));
+
+  auto take = [&](unsigned self, Task &out) {
+    {
+      Queue<Task> &own = *queues[self];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        out = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    for (unsigned k = 1; k < workers; ++k) {
+      Queue<Task> &victim = *queues[(self + k) % workers];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        out = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto work = [&](unsigned self) {
+    const Spawner<Task> spawn(*queues[self], pending);
+    Task task;
+    while (pending.load(std::memory_order_acquire) != 0) {
+      if (!take(self, task)) {
+        std::this_thread::yield();
+        continue;
+      }
+      fn(std::move(task), spawn, self);
+      pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(workers - 1);
+  for (unsigned w = 1; w < workers; ++w)
+    pool.emplace_back(work, w);
+  work(0);
+  for (auto &t : pool)
+    t.join();
+  return workers;
+}
+
+} // namespace worksteal
@@ -0,0 +1,77 @@
+/**
+ * @file finance_test.cpp
+ * @brief Long-horizon amortization schedules: payments repay exactly the
+ *        principal, the balance ends at zero, and a row computed on its own
+ *        matches the same row of a full run.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#include "finance.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what, const finance::Loan &loan) {
+  if (ok)
+    return;
+  ++failures;
+  std::printf("FAIL %s (principal %g, rate %g, %llu periods)\n", what,
+              loan.principal, loan.rate,
+              static_cast<unsigned long long>(loan.periods));
+}
+
+void checkLoan(const finance::Loan &loan) {
+  const std::size_t n = static_cast<std::size_t>(loan.periods);
+  std::vector<double> pay(n), interest(n), principal(n), balance(n);
+  const finance::Rows rows{pay.data(), interest.data(), principal.data(),
+                           balance.data()};
+  check(finance::schedule(loan, 0, n, rows), "schedule", loan);
+
+  // Principal repaid adds up to the loan, and the balance reaches zero
+  // without ever going negative or above the principal.
+  long double repaid = 0.0L, worst = 0.0L;
+  for (std::size_t i = 0; i < n; ++i) {
+    repaid += principal[i];
+    const long double due = loan.principal - repaid;
+    worst = std::max(worst, std::fabs(due - balance[i]));
+    check(balance[i] > -1e-6 && balance[i] <= loan.principal, "balance range",
+          loan);
+  }
+  const double tolerance = 1e-9 * loan.principal;
+  check(std::fabs(static_cast<double>(repaid) - loan.principal) < tolerance,
+        "principal sums to the loan", loan);
+  check(balance[n - 1] == 0.0, "zero final balance", loan);
+  check(worst < tolerance, "balances follow the payments", loan);
+  check(std::fabs(pay[n - 1] - pay[0]) < 1e-9 * pay[0], "level last payment",
+        loan);
+
+  // Random access gives the rows of the full run.
+  for (const std::size_t first : {std::size_t{1}, n / 3, n - 7}) {
+    double p[5], in[5], pr[5], b[5];
+    const std::size_t count = std::min<std::size_t>(5, n - first);
+    check(finance::schedule(loan, first, count, {p, in, pr, b}), "row access",
+          loan);
+    for (std::size_t j = 0; j < count; ++j)
+      check(std::fabs(b[j] - balance[first + j]) < tolerance &&
+                std::fabs(in[j] - interest[first + j]) < tolerance,
+            "row matches the full run", loan);
+  }
+}
+
+} // namespace
+
+int main() {
+  checkLoan({1e5, 0.01, 5000});
+  checkLoan({1e6, 0.001, 100000});
+  checkLoan({200000.0, 0.05 / 12, 6000});
+  checkLoan({250000.0, 0.0, 360});
+  checkLoan({1e7, 1e-9, 1000000});
+  if (failures == 0)
+    std::puts("finance_test: all checks passed");
+  return failures == 0 ? 0 : 1;
+}
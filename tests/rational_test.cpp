@@ -0,0 +1,55 @@
+/**
+ * @file rational_test.cpp
+ * @brief Rational::fromString: integers, fractions and decimals are read
+ *        exactly, and malformed text (including nested fractions) is
+ *        rejected.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#include "rational.h"
+#include <cstdio>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+/// @p text parses to @p expected ("n" or "n/d"), or fails when it is empty.
+void check(const std::string &text, const std::string &expected) {
+  const auto r = Rational::fromString(text);
+  const std::string got = r ? r->toString() : std::string();
+  if (got == expected)
+    return;
+  ++failures;
+  std::printf("FAIL \"%s\": got \"%s\", expected \"%s\"\n", text.c_str(),
+              r ? got.c_str() : "(none)",
+              expected.empty() ? "(none)" : expected.c_str());
+}
+
+} // namespace
+
+int main() {
+  check("7", "7");
+  check("-22/7", "-22/7");
+  check("6/4", "3/2");
+  check(" 0.125 ", "1/8");
+  check("1.5e-3", "3/2000");
+  check("1.5/0.25", "6");
+  check("123456789012345678901234567890/10",
+        "12345678901234567890123456789");
+
+  // At most one '/'.
+  check("1/2/3", "");
+  check("1//2", "");
+  check("8/4/2", "");
+  check("/2", "");
+  check("2/", "");
+  check("1/0", "");
+  check("1.2.3", "");
+  check("", "");
+
+  if (failures == 0)
+    std::puts("rational_test: all checks passed");
+  return failures == 0 ? 0 : 1;
+}
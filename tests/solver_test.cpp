@@ -0,0 +1,77 @@
+/**
+ * @file solver_test.cpp
+ * @brief Polynomial roots at the ends of the double range and on the unit
+ *        circle: the Aberth iteration converges and finds the true roots.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#include "solver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+using solver::Complex;
+
+int failures = 0;
+
+void check(bool ok, const char *what) {
+  if (ok)
+    return;
+  ++failures;
+  std::printf("FAIL %s\n", what);
+}
+
+/// Each expected root is matched by a found root within @p tolerance
+/// relative to its magnitude, and the search converged.
+void checkRoots(const std::vector<Complex> &coeffs,
+                const std::vector<Complex> &expected, double tolerance,
+                const char *what) {
+  const auto r = solver::polynomialRoots(coeffs);
+  if (!r) {
+    check(false, what);
+    return;
+  }
+  check(r->converged, what);
+  check(r->roots.size() == expected.size(), what);
+  for (const Complex &root : expected) {
+    double best = HUGE_VAL;
+    for (const Complex &z : r->roots)
+      best = std::min(best, std::abs(z - root) / std::abs(root));
+    check(best < tolerance, what);
+  }
+}
+
+} // namespace
+
+int main() {
+  const double h = std::sqrt(3.0) / 2.0;
+  // 1e300 x^2 + x + 1e-300: roots 1e-300 (-1/2 +- i sqrt(3)/2), where
+  // |z_i - z_j|^2 underflows and p'/p overflows.
+  checkRoots({1e300, 1.0, 1e-300},
+             {Complex(-0.5e-300, h * 1e-300), Complex(-0.5e-300, -h * 1e-300)},
+             1e-14, "tiny roots");
+  // The mirror image: roots of magnitude 1e300.
+  checkRoots({1e-300, 1.0, 1e300},
+             {Complex(-0.5e300, h * 1e300), Complex(-0.5e300, -h * 1e300)},
+             1e-14, "huge roots");
+  // x^2 + 1e-300: +-1e-150 i.
+  checkRoots({1.0, 0.0, 1e-300}, {Complex(0.0, 1e-150), Complex(0.0, -1e-150)},
+             1e-14, "scaled imaginary pair");
+
+  // x^64 - 1: the 64th roots of unity.
+  std::vector<Complex> unity(65, 0.0);
+  unity[0] = 1.0;
+  unity[64] = -1.0;
+  std::vector<Complex> roots;
+  for (int k = 0; k < 64; ++k)
+    roots.push_back(std::polar(1.0, 6.283185307179586 * k / 64.0));
+  checkRoots(unity, roots, 1e-13, "roots of unity");
+
+  if (failures == 0)
+    std::puts("solver_test: all checks passed");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file units_test.cpp
+ * @brief Unit parsing and conversion: compound syntax (including factors
+ *        joined by spaces), exponent range checks and exact temperature
+ *        conversions.
+ *
+ * @author Giovanni Daniel Mendez Sanchez (B54354)
+ * @date 2026-10-18
+ */
+#include "units.h"
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what) {
+  if (ok)
+    return;
+  ++failures;
+  std::printf("FAIL %s\n", what);
+}
+
+/// @p value in @p from converts to exactly @p expected in @p to.
+void checkExact(double value, const char *from, const char *to,
+                double expected) {
+  const auto r = units::convert(value, from, to);
+  if (r && *r == expected)
+    return;
+  ++failures;
+  std::printf("FAIL %g %s -> %s: got %.17g, expected %.17g\n", value, from,
+              to, r ? *r : 0.0, expected);
+}
+
+} // namespace
+
+int main() {
+  // Factors joined by '*', '.' and spaces are the same unit.
+  const auto star = units::parse("kg*m/s^2");
+  const auto space = units::parse("kg m/s^2");
+  check(star && space && star->dim == space->dim &&
+            star->scale == space->scale,
+        "space-joined factors");
+  check(units::parse(" kg  m ").has_value(), "surrounding spaces");
+  check(units::conversion("kg m s-2", "N").has_value(), "kg m s-2 is N");
+  check(!units::parse("kg m 2").has_value(), "stray exponent");
+  check(!units::parse("kg m x").has_value(), "unknown spaced factor");
+
+  // Exponents that overflow the int8 dimension are rejected, not wrapped.
+  check(units::parse("m64*m63").has_value(), "m^127 fits");
+  check(!units::parse("m64*m64").has_value(), "m^128 overflows");
+  check(!units::parse("L^64").has_value(), "(m^3)^64 overflows");
+  check(!units::parse("1/m64*m64*m").has_value(), "m^-129 overflows");
+
+  // Temperature scales convert exactly.
+  checkExact(0.0, "degC", "degF", 32.0);
+  checkExact(100.0, "degC", "degF", 212.0);
+  checkExact(37.0, "degC", "degF", 98.6);
+  checkExact(-40.0, "degF", "degC", -40.0);
+  checkExact(212.0, "degF", "degC", 100.0);
+  checkExact(32.0, "degF", "K", 273.15);
+  checkExact(0.0, "degC", "K", 273.15);
+  checkExact(300.0, "K", "degC", 26.85);
+  checkExact(491.67, "R", "degF", 32.0);
+  checkExact(1.0, "km", "m", 1000.0);
+
+  double values[] = {0.0, 100.0, -40.0};
+  check(units::convert(values, values, 3, "degC", "degF") &&
+            values[0] == 32.0 && values[1] == 212.0 && values[2] == -40.0,
+        "bulk temperature conversion");
+
+  if (failures == 0)
+    std::puts("units_test: all checks passed");
+  return failures == 0 ? 0 : 1;
+}